@@ -43,6 +43,9 @@
 #include "ns3/log.h"
 #include "ns3/internet-apps-module.h"
 #include "ns3/dash-helper.h"
+#include "ns3/dash-request-handler.h"
+#include "ns3/sand-radio-monitor.h"
+#include "ns3/ran-aware-abr.h"
 #include <iostream>
 #include <ctime>
 #include <stdlib.h>
@@ -424,6 +427,12 @@ traceuefunc (std::string path, RxPacketTraceParams params)
 }
 
 
+void
+NotifyDlTransportBlock (Ptr<SandRadioMonitor> monitor, RxPacketTraceParams params)
+{
+  monitor->DlTransportBlock (params.m_cellId, params.m_rnti, params.m_sinr, params.m_numSym);
+}
+
 void
 traceenbfunc (std::string path, RxPacketTraceParams params)
 {
@@ -714,6 +723,12 @@ main (int argc, char *argv[])
   double minSpeedVal = 0;   //default zero
   double maxSpeedVal = 0;   //default zero
   int AbrPortVal = 8333;    //default 8333
+  bool resumeSegments = true; //ask only for the rest of a segment cut by a handover
+  std::string edgeCache = "";   //eviction policy of a caching proxy on the pgw, e.g. ns3::HttpLruCache
+  uint64_t edgeCacheSize = 100000000; //bytes
+  uint16_t originNum = 0;       //origin servers behind the remote host, 0 for the remote host alone
+  std::string originRouter = "ns3::HttpRoundRobinRouter";
+  bool ranAwareAbr = false;   //lower the quality ahead of handovers and blockage
   // Command line arguments
   CommandLine cmd;
   cmd.AddValue("outputDir", "Output Directory for trace storing", outputDir);
@@ -722,6 +737,12 @@ main (int argc, char *argv[])
   cmd.AddValue("MaxSpeed", "Maximum Speed of the UE", maxSpeedVal);
   cmd.AddValue("AbrPort", "Port to connect ABR proxy Server", AbrPortVal);
   cmd.AddValue("gNbNum", "Number of gNode-Bs", gNbNum);
+  cmd.AddValue("ResumeSegments", "Resume segments with a Range request after a connection reset", resumeSegments);
+  cmd.AddValue("EdgeCache", "TypeId of the cache of an HttpCacheProxy on the pgw, empty for none", edgeCache);
+  cmd.AddValue("EdgeCacheSize", "Capacity of the edge cache in bytes", edgeCacheSize);
+  cmd.AddValue("Origins", "Number of origin servers the remote host balances over, 0 serves from the remote host", originNum);
+  cmd.AddValue("OriginRouter", "TypeId of the HttpOriginRouter of the remote host", originRouter);
+  cmd.AddValue("RanAwareAbr", "Lower the quality ahead of handovers and blockage using the UE's radio state", ranAwareAbr);
   cmd.Parse (argc, argv);
   
 
@@ -1058,11 +1079,50 @@ main (int argc, char *argv[])
 
   //	ApplicationContainer clientAppsEmbb, serverAppsEmbb;
 
-  DashServerHelper dashSrHelper (dlPort);
-  serverApps.Add (dashSrHelper.Install (remoteHost));
+  if (originNum == 0)
+    {
+      DashServerHelper dashSrHelper (dlPort);
+      serverApps.Add (dashSrHelper.Install (remoteHost));
+    }
+  else
+    {
+      //the remote host routes every request to one of the origins, each on its own 1ms link
+      NodeContainer originNodes;
+      originNodes.Create (originNum);
+      internet.Install (originNodes);
+      PointToPointHelper originLink;
+      originLink.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("10Gb/s")));
+      originLink.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (1)));
+      Ipv4AddressHelper originIpv4;
+      originIpv4.SetBase ("2.0.0.0", "255.255.255.252");
+      for (uint32_t i = 0; i < originNum; i++)
+        {
+          originIpv4.Assign (originLink.Install (remoteHost, originNodes.Get (i)));
+          originIpv4.NewNetwork ();
+        }
+      HttpOriginClusterHelper clusterHelper (dlPort, dlPort);
+      clusterHelper.SetOriginAttribute ("HttpRequestHandlerTypeId", TypeIdValue (DashRequestHandler::GetTypeId ()));
+      clusterHelper.SetRouter (originRouter);
+      serverApps.Add (clusterHelper.Install (remoteHost, originNodes));
+    }
+
+  //with an edge cache the UEs fetch from the proxy on the pgw, which fetches misses across the backhaul
+  Address serverAddress = internetIpIfaces.GetAddress (1); //Remotehost is the second node, pgw is first
+  uint16_t serverPort = dlPort;
+  if (!edgeCache.empty ())
+    {
+      uint16_t proxyPort = 8080;
+      HttpCacheProxyHelper proxyHelper (proxyPort, internetIpIfaces.GetAddress (1), dlPort);
+      proxyHelper.SetAttribute ("CacheTypeId", TypeIdValue (TypeId::LookupByName (edgeCache)));
+      proxyHelper.SetAttribute ("CacheCapacity", UintegerValue (edgeCacheSize));
+      proxyHelper.SetAttribute ("StatsFile", StringValue (outputDir + "/EdgeCacheStats"));
+      serverApps.Add (proxyHelper.Install (pgw));
+      serverAddress = internetIpIfaces.GetAddress (0);
+      serverPort = proxyPort;
+    }
 
   int counter = 0;
-  DashClientHelper dlClient (internetIpIfaces.GetAddress (1), dlPort); //Remotehost is the second node, pgw is first
+  DashClientHelper dlClient (serverAddress, serverPort);
   //dlClient.SetAttribute ("Size", UintegerValue (0xFFFFFF));
   //dlClient.SetAttribute ("NumberOfDownload", UintegerValue (1));
   dlClient.SetAttribute ("OnStartCB",
@@ -1079,6 +1139,20 @@ main (int argc, char *argv[])
   dlClient.SetAttribute("AbrPort", UintegerValue(AbrPortVal));
 
   dlClient.SetAttribute ("Timeout", TimeValue(Seconds(-1)));
+  dlClient.SetAttribute ("ResumeSegments", BooleanValue (resumeSegments));
+
+  // SAND: the players see the radio state of their UE through the monitor
+  Ptr<SandRadioMonitor> radioMonitor = CreateObject<SandRadioMonitor> ();
+  if (ranAwareAbr)
+    {
+      for (uint32_t j = 0; j < ueNodes.GetN (); j++)
+        {
+          radioMonitor->AddUe (mcUeDevs.Get (j)->GetObject<McUeNetDevice> ()->GetImsi (),
+                               ueIpIface.GetAddress (j));
+        }
+      dlClient.SetAttribute ("AbrTypeId", TypeIdValue (RanAwareAbr::GetTypeId ()));
+      dlClient.SetAttribute ("RadioMonitor", PointerValue (radioMonitor));
+    }
 
 
   if (!outputDir.empty ())
@@ -1147,6 +1221,19 @@ main (int argc, char *argv[])
   Config::Connect ("/NodeList/"+std::to_string (ueNodes.Get (8)->GetId ())+"/DeviceList/*/MmWaveComponentCarrierMapUe/*/MmWaveUePhy/DlSpectrumPhy/RxPacketTraceUe",
                    MakeCallback (&traceuefunc));
 
+  if (ranAwareAbr)
+    {
+      // the mmWave rrc, the cell ids of the transport blocks are mmWave ones
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/ConnectionEstablished",
+                                     MakeCallback (&SandRadioMonitor::ConnectionEstablished, radioMonitor));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverStart",
+                                     MakeCallback (&SandRadioMonitor::HandoverStart, radioMonitor));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverEndOk",
+                                     MakeCallback (&SandRadioMonitor::HandoverEndOk, radioMonitor));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveComponentCarrierMapUe/*/MmWaveUePhy/DlSpectrumPhy/RxPacketTraceUe",
+                                     MakeBoundCallback (&NotifyDlTransportBlock, radioMonitor));
+    }
+
   Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveEnbPhy/DlSpectrumPhy/RxPacketTraceEnb",
                    MakeCallback (&traceenbfunc));
   Ptr<MmWaveUePhy> mmwaveUePhy = mcUeDevs.Get(8)->GetObject<McUeNetDevice> ()->GetMmWavePhy ();
@@ -42,6 +42,8 @@
 #include "ns3/log.h"
 #include "ns3/internet-apps-module.h"
 #include "ns3/spdash-helper.h"
+#include "ns3/sand-radio-monitor.h"
+#include "ns3/ran-aware-abr.h"
 #include <iostream>
 #include <ctime>
 #include <stdlib.h>
@@ -391,6 +393,12 @@ traceuefunc (std::string path, RxPacketTraceParams params)
             << "," << params.m_tbler << "," << 10 * std::log10 (params.m_sinrMin) << std::endl;
 }
 
+void
+NotifyDlTransportBlock (Ptr<SandRadioMonitor> monitor, RxPacketTraceParams params)
+{
+  monitor->DlTransportBlock (params.m_cellId, params.m_rnti, params.m_sinr, params.m_numSym);
+}
+
 void
 traceenbfunc (std::string path, RxPacketTraceParams params)
 {
@@ -647,7 +655,11 @@ main (int argc, char *argv[])
   double udpAppStartTime = 0.4; //seconds
 
   // Command line arguments
+  bool abrCoordinator = false;
+  bool ranAwareAbr = false;
   CommandLine cmd;
+  cmd.AddValue ("AbrCoordinator", "Allocate the bitrate of all players jointly at the server", abrCoordinator);
+  cmd.AddValue ("RanAwareAbr", "Lower the quality ahead of handovers and blockage using the UEs' radio state", ranAwareAbr);
   cmd.Parse (argc, argv);
 
   UintegerValue uintegerValue;
@@ -1069,7 +1081,22 @@ main (int argc, char *argv[])
 
   //	ApplicationContainer clientAppsEmbb, serverAppsEmbb;
   
+  // SAND: the server side abr sees the radio state of the UEs through the monitor
+  Ptr<SandRadioMonitor> radioMonitor = CreateObject<SandRadioMonitor> ();
+  if (ranAwareAbr)
+    {
+      for (uint32_t j = 0; j < ueNodes.GetN (); j++)
+        {
+          radioMonitor->AddUe (mcUeDevs.Get (j)->GetObject<McUeNetDevice> ()->GetImsi (),
+                               ueIpIface.GetAddress (j));
+        }
+      Config::SetDefault ("ns3::SpDashRequestHandler::AbrTypeId",
+                          TypeIdValue (RanAwareAbr::GetTypeId ()));
+      Config::SetDefault ("ns3::SpDashRequestHandler::RadioMonitor", PointerValue (radioMonitor));
+    }
+
   SpDashServerHelper dashSrHelper (dlPort);
+  dashSrHelper.EnableCoordinator (abrCoordinator);
   serverApps.Add (dashSrHelper.Install (remoteHost));
 
   int counter = 0;
@@ -1160,6 +1187,20 @@ main (int argc, char *argv[])
           "/DeviceList/*/MmWaveComponentCarrierMapUe/*/MmWaveUePhy/DlSpectrumPhy/RxPacketTraceUe",
       MakeCallback (&traceuefunc));
 
+  if (ranAwareAbr)
+    {
+      // the mmWave rrc, the cell ids of the transport blocks are mmWave ones
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/ConnectionEstablished",
+                                     MakeCallback (&SandRadioMonitor::ConnectionEstablished, radioMonitor));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverStart",
+                                     MakeCallback (&SandRadioMonitor::HandoverStart, radioMonitor));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/MmWaveUeRrc/HandoverEndOk",
+                                     MakeCallback (&SandRadioMonitor::HandoverEndOk, radioMonitor));
+      Config::ConnectWithoutContext (
+          "/NodeList/*/DeviceList/*/MmWaveComponentCarrierMapUe/*/MmWaveUePhy/DlSpectrumPhy/RxPacketTraceUe",
+          MakeBoundCallback (&NotifyDlTransportBlock, radioMonitor));
+    }
+
   Config::Connect (
       "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/MmWaveEnbPhy/DlSpectrumPhy/RxPacketTraceEnb",
       MakeCallback (&traceenbfunc));
@@ -0,0 +1,167 @@
+/*
+ * abr-rpc-server.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ *
+ * Reference stand-in for the external abr server used by ns3::RemoteAbr.
+ * It speaks the framing described in abr-rpc-protocol.h and picks the
+ * highest bitrate below 0.9 x the harmonic mean of the last 5 throughput
+ * samples, which it keeps in the cookie. It does not use ns3 at all and
+ * serves any number of simulations (one persistent connection each).
+ *
+ *   ./waf --run "abr-rpc-server --port=8333"
+ *   ./waf --run "dash-example-p2p --ns3::DashVideoPlayer::AbrTypeId=ns3::RemoteAbr --ns3::RemoteAbr::Port=8333"
+ */
+
+#include "ns3/abr-rpc-protocol.h"
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+#define HISTORY_LENGTH 5
+#define SAFETY_FACTOR 0.9
+
+static AbrRpcReply Decide(const AbrRpcBatch &batch, const AbrRpcEntry &entry) {
+	const std::vector<uint32_t> &ladder = batch.m_ladders[entry.m_ladder];
+	std::vector<double> history;
+	std::istringstream ss(entry.m_cookie);
+	std::string sample;
+	while (std::getline(ss, sample, ',')) {
+		if (!sample.empty())
+			history.push_back(std::atof(sample.c_str()));
+	}
+	int64_t spent = entry.m_lastChunkFinishNs - entry.m_lastChunkStartNs;
+	if (entry.m_lastChunkSize > 0 && spent > 0)
+		history.push_back(entry.m_lastChunkSize * 8.0e9 / spent);
+	if (history.size() > HISTORY_LENGTH)
+		history.erase(history.begin(), history.end() - HISTORY_LENGTH);
+
+	double sum = 0;
+	for (auto bps : history)
+		sum += 1 / bps;
+	double estimate = history.empty() ? 0 : history.size() / sum * SAFETY_FACTOR;
+
+	AbrRpcReply reply;
+	reply.m_id = entry.m_id;
+	for (uint16_t q = 0; q < ladder.size(); q++) {
+		if (ladder[q] <= estimate)
+			reply.m_quality = q;
+	}
+	std::string separator = "";
+	std::ostringstream cookie;
+	for (auto bps : history) {
+		cookie << separator << (uint64_t) bps;
+		separator = ",";
+	}
+	reply.m_cookie = cookie.str();
+	return reply;
+}
+
+/*
+ * Consumes every complete frame in the input buffer and appends the
+ * replies to the output buffer. Returns false on a protocol error.
+ */
+static bool HandleInput(std::string &in, std::string &out) {
+	while (in.size() >= 4) {
+		std::string lenBuf = in.substr(0, 4);
+		uint32_t len = AbrRpcReader(lenBuf).ReadU32();
+		if (len > ABR_RPC_MAX_FRAME)
+			return false;
+		if (in.size() < 4 + len)
+			break;
+		AbrRpcBatch batch;
+		if (!AbrRpcDecodeBatch(in.substr(4, len), batch))
+			return false;
+		in.erase(0, 4 + len);
+
+		std::vector<AbrRpcReply> replies;
+		for (auto &entry : batch.m_entries)
+			replies.push_back(Decide(batch, entry));
+		out += AbrRpcEncodeFrame(AbrRpcEncodeReplies(replies));
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	uint16_t port = 8333;
+	for (int i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--port=", 7) == 0)
+			port = std::atoi(argv[i] + 7);
+	}
+
+	int listener = socket(AF_INET, SOCK_STREAM, 0);
+	int flag = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons(port);
+	if (bind(listener, (struct sockaddr*) &addr, sizeof(addr)) < 0 || listen(listener, 16) < 0) {
+		std::cerr << "can't listen on port " << port << std::endl;
+		return 1;
+	}
+	std::cout << "abr rpc server listening on 127.0.0.1:" << port << std::endl;
+
+	std::map<int, std::pair<std::string, std::string> > conns; //fd -> in, out
+	while (true) {
+		std::vector<struct pollfd> fds(1);
+		fds[0].fd = listener;
+		fds[0].events = POLLIN;
+		for (auto &it : conns) {
+			struct pollfd pfd;
+			pfd.fd = it.first;
+			pfd.events = POLLIN | (it.second.second.empty() ? 0 : POLLOUT);
+			fds.push_back(pfd);
+		}
+		if (poll(&fds[0], fds.size(), -1) < 0)
+			continue;
+
+		if (fds[0].revents & POLLIN) {
+			int fd = accept(listener, NULL, NULL);
+			if (fd >= 0) {
+				setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+				conns[fd];
+			}
+		}
+		for (size_t i = 1; i < fds.size(); i++) {
+			int fd = fds[i].fd;
+			std::string &in = conns[fd].first;
+			std::string &out = conns[fd].second;
+			bool alive = true;
+			if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+				char buf[4096];
+				ssize_t got = recv(fd, buf, sizeof(buf), 0);
+				if (got <= 0)
+					alive = false;
+				else {
+					in.append(buf, got);
+					alive = HandleInput(in, out);
+				}
+			}
+			if (alive && !out.empty()) {
+				ssize_t sent = send(fd, out.data(), out.size(), MSG_NOSIGNAL);
+				if (sent < 0)
+					alive = false;
+				else
+					out.erase(0, sent);
+			}
+			if (!alive) {
+				close(fd);
+				conns.erase(fd);
+			}
+		}
+	}
+	return 0;
+}
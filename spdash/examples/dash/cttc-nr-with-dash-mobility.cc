@@ -23,6 +23,8 @@
 #include "ns3/config-store-module.h"
 #include "ns3/mmwave-mac-scheduler-tdma-rr.h"
 #include "ns3/dash-helper.h"
+#include "ns3/rudp-helper.h"
+#include "ns3/rudp-socket-factory.h"
 #include "ns3/netanim-module.h"
 
 using namespace ns3;
@@ -46,6 +48,10 @@ struct ProgramConfigurations{
 		double totalTxPower;
 		bool logging;
 		std::string animFile;
+		uint32_t pipelineDepth;
+		uint32_t maxConnections;
+		bool multiplex;
+		std::string transport;
 };
 
 void onStart(int *count){
@@ -160,7 +166,11 @@ int main(int argc, char *argv[]) {
 		.outputDir = "./",
 		.totalTxPower = 4,
 		.logging = false,
-		.animFile = "animation.xml"
+		.animFile = "animation.xml",
+		.pipelineDepth = 1,
+		.maxConnections = 1,
+		.multiplex = false,
+		.transport = "tcp"
 	};
 
 	double udpAppStartTime = 0.4; //seconds
@@ -208,6 +218,14 @@ int main(int argc, char *argv[]) {
 					" bandwidth parts depending on each BWP bandwidth ",
 					conf.totalTxPower);
 	cmd.AddValue("logging", "Enable logging", conf.logging);
+	cmd.AddValue("pipelineDepth", "Segment requests in flight per connection",
+			conf.pipelineDepth);
+	cmd.AddValue("maxConnections", "Parallel connections per dash client",
+			conf.maxConnections);
+	cmd.AddValue("multiplex", "Carry the connections as streams of one tcp connection",
+			conf.multiplex);
+	cmd.AddValue("transport", "Transport of the http connections, tcp or rudp (reliable udp with 0-RTT)",
+			conf.transport);
 
 	cmd.Parse(argc, argv);
 	NS_ABORT_IF(conf.frequencyBwp1 < 6e9 || conf.frequencyBwp1 > 100e9);
@@ -433,6 +451,13 @@ int main(int argc, char *argv[]) {
 	remoteHostStaticRouting->AddNetworkRouteTo(Ipv4Address("7.0.0.0"),
 			Ipv4Mask("255.0.0.0"), 1);
 	internet.Install(ueNodes);
+	if (conf.transport == "rudp") {
+		RudpHelper rudp;
+		rudp.Install(remoteHostContainer);
+		rudp.Install(ueNodes);
+	}
+	TypeId socketFactory = conf.transport == "rudp" ? RudpSocketFactory::GetTypeId()
+			: TcpSocketFactory::GetTypeId();
 	Ipv4InterfaceContainer ueIpIface;
 	ueIpIface = epcHelper->AssignUeIpv4Address(NetDeviceContainer(ueNetDev));
 
@@ -452,6 +477,8 @@ int main(int argc, char *argv[]) {
 	ApplicationContainer clientAppsEmbb, serverAppsEmbb;
 
 	DashServerHelper dashSrHelper(dlPort);
+	dashSrHelper.SetAttribute("Multiplex", BooleanValue(conf.multiplex));
+	dashSrHelper.SetAttribute("SocketFactory", TypeIdValue(socketFactory));
 	serverApps.Add(dashSrHelper.Install(remoteHost));
 
 	int counter = 0;
@@ -460,6 +487,10 @@ int main(int argc, char *argv[]) {
 	dlClient.SetAttribute("OnStartCB", CallbackValue(MakeBoundCallback(onStart, &counter)));
 	dlClient.SetAttribute("OnStopCB", CallbackValue(MakeBoundCallback(onStop, &counter)));
 	dlClient.SetAttribute("TracePath", StringValue("SomeData"));
+	dlClient.SetAttribute("PipelineDepth", UintegerValue(conf.pipelineDepth));
+	dlClient.SetAttribute("MaxConnections", UintegerValue(conf.maxConnections));
+	dlClient.SetAttribute("Multiplex", BooleanValue(conf.multiplex));
+	dlClient.SetAttribute("SocketFactory", TypeIdValue(socketFactory));
 	// configure here UDP traffic
 	for (uint32_t j = 0; j < ueNodes.GetN(); ++j) {
 
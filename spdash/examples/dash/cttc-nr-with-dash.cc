@@ -23,6 +23,8 @@
 #include "ns3/config-store-module.h"
 #include "ns3/mmwave-mac-scheduler-tdma-rr.h"
 #include "ns3/dash-helper.h"
+#include "ns3/rudp-helper.h"
+#include "ns3/rudp-socket-factory.h"
 
 using namespace ns3;
 
@@ -61,6 +63,10 @@ int main(int argc, char *argv[]) {
 	std::string outputDir = "./";
 	double totalTxPower = 4;
 	bool logging = false;
+	uint32_t pipelineDepth = 1;
+	uint32_t maxConnections = 1;
+	bool multiplex = false;
+	std::string transport = "tcp";
 
 	double simTime = 1; // seconds
 	double udpAppStartTime = 0.4; //seconds
@@ -127,6 +133,14 @@ int main(int argc, char *argv[]) {
 					" bandwidth parts depending on each BWP bandwidth ",
 			totalTxPower);
 	cmd.AddValue("logging", "Enable logging", logging);
+	cmd.AddValue("pipelineDepth", "Segment requests in flight per connection",
+			pipelineDepth);
+	cmd.AddValue("maxConnections", "Parallel connections per dash client",
+			maxConnections);
+	cmd.AddValue("multiplex", "Carry the connections as streams of one tcp connection",
+			multiplex);
+	cmd.AddValue("transport", "Transport of the http connections, tcp or rudp (reliable udp with 0-RTT)",
+			transport);
 
 	cmd.Parse(argc, argv);
 	NS_ABORT_IF(frequencyBwp1 < 6e9 || frequencyBwp1 > 100e9);
@@ -336,6 +350,13 @@ int main(int argc, char *argv[]) {
 	remoteHostStaticRouting->AddNetworkRouteTo(Ipv4Address("7.0.0.0"),
 			Ipv4Mask("255.0.0.0"), 1);
 	internet.Install(ueNodes);
+	if (transport == "rudp") {
+		RudpHelper rudp;
+		rudp.Install(remoteHostContainer);
+		rudp.Install(ueNodes);
+	}
+	TypeId socketFactory = transport == "rudp" ? RudpSocketFactory::GetTypeId()
+			: TcpSocketFactory::GetTypeId();
 	Ipv4InterfaceContainer ueIpIface;
 	ueIpIface = epcHelper->AssignUeIpv4Address(NetDeviceContainer(ueNetDev));
 
@@ -357,6 +378,8 @@ int main(int argc, char *argv[]) {
 //	UdpServerHelper dlPacketSinkHelper(dlPort);
 //	serverApps.Add(dlPacketSinkHelper.Install(ueNodes));
 	DashServerHelper dashSrHelper(dlPort);
+	dashSrHelper.SetAttribute("Multiplex", BooleanValue(multiplex));
+	dashSrHelper.SetAttribute("SocketFactory", TypeIdValue(socketFactory));
 	serverApps.Add(dashSrHelper.Install(remoteHost));
 
 	int counter = 0;
@@ -364,6 +387,10 @@ int main(int argc, char *argv[]) {
 	dlClient.SetAttribute("VideoFilePath", StringValue("src/spdash/examples/vid.txt"));
 	dlClient.SetAttribute("onStartCB", CallbackValue(MakeBoundCallback(onStart, &counter)));
 	dlClient.SetAttribute("onStopCB", CallbackValue(MakeBoundCallback(onStop, &counter)));
+	dlClient.SetAttribute("PipelineDepth", UintegerValue(pipelineDepth));
+	dlClient.SetAttribute("MaxConnections", UintegerValue(maxConnections));
+	dlClient.SetAttribute("Multiplex", BooleanValue(multiplex));
+	dlClient.SetAttribute("SocketFactory", TypeIdValue(socketFactory));
 	// configure here UDP traffic
 	for (uint32_t j = 0; j < ueNodes.GetN(); ++j) {
 //		UdpClientHelper dlClient(ueIpIface.GetAddress(j), dlPort);
@@ -0,0 +1,39 @@
+/*
+ * video-manifest-converter.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ *
+ * Converts a vid.txt style video description into the binary manifest
+ * read (mmaped) by VideoCatalog. The result can be used everywhere a
+ * VideoFilePath is expected.
+ *
+ *   ./waf --run "video-manifest-converter --input=src/spdash/examples/vid.txt --output=vid.bin"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/video-catalog.h"
+
+using namespace ns3;
+
+int main(int argc, char *argv[]) {
+	std::string input = "src/spdash/examples/vid.txt";
+	std::string output = "vid.bin";
+	CommandLine cmd;
+	cmd.AddValue("input", "vid.txt style file to read", input);
+	cmd.AddValue("output", "binary manifest to write", output);
+	cmd.Parse(argc, argv);
+
+	const VideoData *videoData = VideoCatalog::Get(input);
+	if (!videoData) {
+		std::cerr << "Can't read " << input << std::endl;
+		return 1;
+	}
+	if (!VideoCatalog::WriteManifest(videoData, output)) {
+		std::cerr << "Can't write " << output << std::endl;
+		return 1;
+	}
+	std::cout << input << " -> " << output << ": " << videoData->GetNumQualities()
+			<< " qualities, " << videoData->m_numSegments << " segments" << std::endl;
+	return 0;
+}
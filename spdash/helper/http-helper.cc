@@ -8,9 +8,13 @@
 #include "http-helper.h"
 
 #include "ns3/http-server.h"
+#include "ns3/http-cache-proxy.h"
 #include "ns3/http-client-collection.h"
+#include "ns3/http-load-generator.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/names.h"
+#include "ns3/ipv4.h"
 
 namespace ns3 {
 
@@ -45,6 +49,49 @@ Ptr<Application> HttpServerHelper::InstallPriv(Ptr<Node> node) const {
 	return app;
 }
 
+HttpCacheProxyHelper::HttpCacheProxyHelper(uint16_t port, Address originAddr,
+		uint16_t originPort) :
+		HttpServerHelper(port) {
+	GetFactory().SetTypeId(HttpCacheProxy::GetTypeId());
+	SetAttribute("OriginAddress", AddressValue(originAddr));
+	SetAttribute("OriginPort", UintegerValue(originPort));
+}
+
+HttpOriginClusterHelper::HttpOriginClusterHelper(uint16_t port, uint16_t originPort) :
+		m_origin(originPort), m_originPort(originPort) {
+	m_balancer.SetTypeId(HttpCacheProxy::GetTypeId());
+	m_balancer.Set("Port", UintegerValue(port));
+	m_balancer.Set("CacheCapacity", UintegerValue(0));
+	m_balancer.Set("Coalesce", BooleanValue(false)); //a plain balancer, every request reaches an origin
+}
+
+void HttpOriginClusterHelper::SetOriginAttribute(std::string name,
+		const AttributeValue &value) {
+	m_origin.SetAttribute(name, value);
+}
+
+void HttpOriginClusterHelper::SetBalancerAttribute(std::string name,
+		const AttributeValue &value) {
+	m_balancer.Set(name, value);
+}
+
+void HttpOriginClusterHelper::SetRouter(std::string type) {
+	SetBalancerAttribute("RouterTypeId", TypeIdValue(TypeId::LookupByName(type)));
+}
+
+ApplicationContainer HttpOriginClusterHelper::Install(Ptr<Node> front,
+		NodeContainer origins) const {
+	Ptr<HttpCacheProxy> balancer = m_balancer.Create<HttpCacheProxy>();
+	front->AddApplication(balancer);
+	ApplicationContainer apps(balancer);
+	for(auto it = origins.Begin(); it != origins.End(); ++it) {
+		apps.Add(m_origin.Install(*it));
+		Ipv4Address address = (*it)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+		balancer->AddOrigin(Address(address), m_originPort);
+	}
+	return apps;
+}
+
 } /* namespace ns3 */
 
 /*********************************************************
@@ -96,3 +143,40 @@ Ptr<Application> HttpClientHelper::InstallPriv(Ptr<Node> node) const {
 }
 
 } /* namespace ns3 */
+
+/*********************************************************
+ *                    Load generator                     *
+ *********************************************************/
+
+namespace ns3 {
+
+HttpLoadGeneratorHelper::HttpLoadGeneratorHelper(Address addr, uint16_t port) {
+	m_factory.SetTypeId(HttpLoadGenerator::GetTypeId());
+	SetAttribute("RemoteAddress", AddressValue(addr));
+	SetAttribute("RemotePort", UintegerValue(port));
+}
+
+void HttpLoadGeneratorHelper::SetAttribute(std::string name,
+		const AttributeValue &value) {
+	m_factory.Set(name, value);
+}
+
+ApplicationContainer HttpLoadGeneratorHelper::Install(NodeContainer nodes) const {
+	ApplicationContainer apps;
+	for(auto it = nodes.Begin(); it != nodes.End(); ++it) {
+		apps.Add(InstallPriv(*it));
+	}
+	return apps;
+}
+
+ApplicationContainer HttpLoadGeneratorHelper::Install(Ptr<Node> node) const {
+	return ApplicationContainer(InstallPriv(node));
+}
+
+Ptr<Application> HttpLoadGeneratorHelper::InstallPriv(Ptr<Node> node) const {
+	Ptr<Application> app = m_factory.Create<HttpLoadGenerator>();
+	node->AddApplication(app);
+	return app;
+}
+
+} /* namespace ns3 */
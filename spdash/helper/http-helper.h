@@ -32,6 +32,39 @@ private:
 	ObjectFactory m_factory;
 };
 
+/*
+ * Installs an HttpCacheProxy listening on port in front of the origin.
+ */
+class HttpCacheProxyHelper: public HttpServerHelper {
+public:
+	HttpCacheProxyHelper(uint16_t port, Address originAddr, uint16_t originPort);
+};
+
+/*
+ * Deploys origin servers behind a routing layer: an HttpCacheProxy on a
+ * front node that spreads the requests over the origins with its
+ * HttpOriginRouter and keeps the load of each. It caches and coalesces
+ * nothing unless its CacheCapacity and Coalesce are set.
+ */
+class HttpOriginClusterHelper {
+public:
+	HttpOriginClusterHelper(uint16_t port, uint16_t originPort);
+	void SetOriginAttribute(std::string name, const AttributeValue &value);
+	void SetBalancerAttribute(std::string name, const AttributeValue &value);
+	void SetRouter(std::string type);
+	/*
+	 * An origin server on every node of origins and the balancer on
+	 * front, which reaches each origin at the address of its interface
+	 * 1. The balancer is the first application of the container.
+	 */
+	ApplicationContainer Install(Ptr<Node> front, NodeContainer origins) const;
+
+private:
+	HttpServerHelper m_origin;
+	uint16_t m_originPort;
+	ObjectFactory m_balancer;
+};
+
 } /* namespace ns3 */
 
 namespace ns3 {
@@ -53,6 +86,22 @@ private:
 	ObjectFactory m_factory;
 };
 
+} /* namespace ns3 */
+
+namespace ns3 {
+
+class HttpLoadGeneratorHelper {
+public:
+	HttpLoadGeneratorHelper(Address addr, uint16_t port);
+	void SetAttribute(std::string name, const AttributeValue &value);
+	ApplicationContainer Install(Ptr<Node> node) const;
+	ApplicationContainer Install(NodeContainer nodes) const;
+
+private:
+	Ptr<Application> InstallPriv(Ptr<Node> node) const;
+	ObjectFactory m_factory;
+};
+
 } /* namespace ns3 */
 #endif /* SRC_SPDASH_HELPER_HTTP_HELPER_H_ */
 
@@ -0,0 +1,47 @@
+/*
+ * rudp-helper.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "rudp-helper.h"
+
+#include "ns3/rudp-socket-factory.h"
+#include "ns3/rudp-socket.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RudpHelper");
+
+RudpHelper::RudpHelper() {
+	m_socketFactory.SetTypeId(RudpSocket::GetTypeId());
+}
+
+void RudpHelper::SetSocketAttribute(std::string name, const AttributeValue &value) {
+	m_socketFactory.Set(name, value);
+}
+
+void RudpHelper::SetCongestionControl(std::string type) {
+	SetSocketAttribute("CongestionControl", TypeIdValue(TypeId::LookupByName(type)));
+}
+
+void RudpHelper::Install(Ptr<Node> node) const {
+	if(node->GetObject<RudpSocketFactory>() != 0) {
+		NS_LOG_WARN("Node " << node->GetId() << " already has a RudpSocketFactory");
+		return;
+	}
+	Ptr<RudpSocketFactory> factory = CreateObject<RudpSocketFactory>();
+	factory->SetSocketFactory(m_socketFactory);
+	node->AggregateObject(factory);
+}
+
+void RudpHelper::Install(NodeContainer nodes) const {
+	for (auto it = nodes.Begin(); it != nodes.End(); ++it) {
+		Install(*it);
+	}
+}
+
+} /* namespace ns3 */
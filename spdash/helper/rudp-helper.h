@@ -0,0 +1,36 @@
+/*
+ * rudp-helper.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_HELPER_RUDP_HELPER_H_
+#define SRC_SPDASH_HELPER_RUDP_HELPER_H_
+
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+#include <string>
+
+namespace ns3 {
+
+/*
+ * Aggregates a RudpSocketFactory to nodes which already have an internet
+ * stack. Socket attributes set here apply to every socket the factory
+ * creates, on top of the RudpSocket defaults.
+ */
+class RudpHelper {
+public:
+	RudpHelper();
+	void SetSocketAttribute(std::string name, const AttributeValue &value);
+	void SetCongestionControl(std::string type);
+	void Install(Ptr<Node> node) const;
+	void Install(NodeContainer nodes) const;
+
+private:
+	ObjectFactory m_socketFactory;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_HELPER_RUDP_HELPER_H_ */
@@ -7,6 +7,7 @@
 
 #include "spdash-helper.h"
 #include "ns3/spdash-request-handler.h"
+#include "ns3/spdash-abr-coordinator.h"
 #include "ns3/spdash-video-player.h"
 // #include "ns3/dash-file-downloader.h"
 #include "ns3/http-server.h"
@@ -16,11 +17,33 @@
 namespace ns3 {
 
 SpDashServerHelper::SpDashServerHelper(uint16_t port) :
-		HttpServerHelper(port) {
+		HttpServerHelper(port), m_coordinator(false) {
 	ObjectFactory dashHandlerFactory;
 	dashHandlerFactory.SetTypeId(SpDashRequestHandler::GetTypeId());
 	SetAttribute("HttpRequestHandlerTypeId",
 			TypeIdValue(SpDashRequestHandler::GetTypeId()));
+	m_coordinatorFactory.SetTypeId(SpDashAbrCoordinator::GetTypeId());
+}
+
+void SpDashServerHelper::SetCoordinatorAttribute(std::string name, const AttributeValue &value) {
+	m_coordinatorFactory.Set(name, value);
+}
+
+ApplicationContainer SpDashServerHelper::Install(Ptr<Node> node) const {
+	ApplicationContainer apps = HttpServerHelper::Install(node);
+	if(m_coordinator) {
+		for(uint32_t i = 0; i < apps.GetN(); i++)
+			apps.Get(i)->AggregateObject(m_coordinatorFactory.Create<SpDashAbrCoordinator>());
+	}
+	return apps;
+}
+
+ApplicationContainer SpDashServerHelper::Install(NodeContainer nodes) const {
+	ApplicationContainer apps;
+	for (auto it = nodes.Begin(); it != nodes.End(); ++it) {
+		apps.Add(Install(*it));
+	}
+	return apps;
 }
 
 } /* namespace ns3 */
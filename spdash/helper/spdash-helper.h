@@ -12,9 +12,21 @@
 
 namespace ns3 {
 
+/*
+ * With EnableCoordinator() every installed server gets its own
+ * SpDashAbrCoordinator, which allocates the bitrate of its clients jointly.
+ */
 class SpDashServerHelper: public HttpServerHelper {
 public:
 	SpDashServerHelper(uint16_t port);
+	void EnableCoordinator(bool enable = true) { m_coordinator = enable; }
+	void SetCoordinatorAttribute(std::string name, const AttributeValue &value);
+	ApplicationContainer Install(Ptr<Node> node) const;
+	ApplicationContainer Install(NodeContainer nodes) const;
+
+private:
+	bool m_coordinator;
+	ObjectFactory m_coordinatorFactory;
 };
 
 } /* namespace ns3 */
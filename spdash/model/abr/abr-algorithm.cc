@@ -0,0 +1,136 @@
+/*
+ * abr-algorithm.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "abr-algorithm.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include <sstream>
+#include <cstdlib>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("AbrAlgorithm");
+NS_OBJECT_ENSURE_REGISTERED(AbrAlgorithm);
+
+TypeId AbrAlgorithm::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::AbrAlgorithm")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddAttribute("HistoryLength",
+					"Number of past throughput samples kept in the cookie",
+					UintegerValue(5),
+					MakeUintegerAccessor(&AbrAlgorithm::m_historyLength),
+					MakeUintegerChecker<uint32_t>(1));
+	return tid;
+}
+
+AbrAlgorithm::AbrAlgorithm(): m_videoData(NULL), m_historyLength(5) {
+	NS_LOG_FUNCTION(this);
+}
+
+AbrAlgorithm::~AbrAlgorithm() {
+	NS_LOG_FUNCTION(this);
+}
+
+void AbrAlgorithm::SetVideoData(const VideoData *videoData) {
+	NS_LOG_FUNCTION(this);
+	m_videoData = videoData;
+}
+
+void AbrAlgorithm::RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision) {
+	NS_LOG_FUNCTION(this);
+	onDecision(GetNextQuality(request));
+}
+
+uint16_t AbrAlgorithm::GetNumQualities() const {
+	NS_ASSERT(m_videoData);
+	return m_videoData->GetNumQualities();
+}
+
+uint16_t AbrAlgorithm::GetNumSegments() const {
+	NS_ASSERT(m_videoData);
+	return m_videoData->m_numSegments;
+}
+
+double AbrAlgorithm::GetBitrate(uint16_t quality) const {
+	NS_ASSERT(m_videoData);
+	return m_videoData->m_averageBitrate.at(quality);
+}
+
+uint64_t AbrAlgorithm::GetSegmentSize(uint16_t quality, uint16_t segment) const {
+	NS_ASSERT(m_videoData);
+	return m_videoData->GetSegmentSize(quality, segment);
+}
+
+double AbrAlgorithm::GetSegmentDuration() const {
+	NS_ASSERT(m_videoData);
+	return m_videoData->m_segmentDuration / 1.0e6;
+}
+
+uint16_t AbrAlgorithm::GetQualityForBitrate(double bps) const {
+	uint16_t quality = 0;
+	for (uint16_t q = 0; q < GetNumQualities(); q++) {
+		if (GetBitrate(q) <= bps)
+			quality = q;
+	}
+	return quality;
+}
+
+std::vector<double> AbrAlgorithm::GetThroughputHistory(const AbrRequest &request) const {
+	std::vector<double> history;
+	std::istringstream ss(request.m_cookie);
+	std::string sample;
+	while (std::getline(ss, sample, ',')) {
+		if (sample.empty())
+			continue;
+		//the cookie comes from the client, a bad one counts as no history
+		char *end = NULL;
+		double value = strtod(sample.c_str(), &end);
+		if (end != sample.c_str() + sample.size() || !std::isfinite(value) || value < 0) {
+			NS_LOG_WARN("Ignoring malformed abr cookie " << request.m_cookie);
+			history.clear();
+			break;
+		}
+		history.push_back(value);
+	}
+
+	Time spent = request.m_lastChunkFinishTime - request.m_lastChunkStartTime;
+	if (request.m_lastChunkSize > 0 && spent.IsStrictlyPositive()) {
+		history.push_back(request.m_lastChunkSize * 8.0 / spent.GetSeconds());
+	}
+	if (history.size() > m_historyLength) {
+		history.erase(history.begin(), history.end() - m_historyLength);
+	}
+	return history;
+}
+
+std::string AbrAlgorithm::MakeCookie(const std::vector<double> &history) const {
+	std::ostringstream ss;
+	std::string separator = "";
+	for (auto it : history) {
+		ss << separator << (uint64_t) it;
+		separator = ",";
+	}
+	return ss.str();
+}
+
+double AbrAlgorithm::HarmonicMean(const std::vector<double> &samples, uint32_t last) {
+	uint32_t count = 0;
+	double sum = 0;
+	for (auto it = samples.rbegin(); it != samples.rend() && count < last; ++it) {
+		if (*it <= 0)
+			continue;
+		sum += 1 / *it;
+		count++;
+	}
+	if (count == 0)
+		return 0;
+	return count / sum;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,107 @@
+/*
+ * abr-algorithm.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_ABR_ALGORITHM_H_
+#define SRC_SPDASH_MODEL_ABR_ABR_ALGORITHM_H_
+
+#include "ns3/object.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/video-data.h"
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * \brief Radio state of the client's UE as a SandRadioMonitor sees it,
+ *        m_valid is false if there is none (e.g. a wired client).
+ */
+struct AbrRadioInfo {
+	AbrRadioInfo(): m_valid(false), m_cellId(0), m_handover(false), m_targetCellId(0),
+			m_sinceHandover(Time::Max()), m_sinrValid(false), m_sinrDb(0), m_sinrTrend(0),
+			m_symbolRate(0) {}
+	bool m_valid;
+	uint16_t m_cellId; ///< serving cell
+	bool m_handover; ///< in progress, to m_targetCellId
+	uint16_t m_targetCellId;
+	Time m_sinceHandover; ///< since the last one completed
+	bool m_sinrValid; ///< false if the UE was not scheduled lately
+	double m_sinrDb; ///< smoothed downlink sinr
+	double m_sinrTrend; ///< dB/s
+	double m_symbolRate; ///< downlink OFDM symbols scheduled to the UE per second
+};
+
+/*
+ * \brief Playback state handed to an AbrAlgorithm for every segment.
+ *        It carries the same fields the pensieve style abr server used
+ *        to receive, just without the string round trip.
+ */
+struct AbrRequest {
+	AbrRequest(): m_segmentNum(0), m_lastQuality(0), m_bufferLevel(0),
+			m_rebufferTime(0), m_lastChunkSize(0) {}
+	uint16_t m_segmentNum; ///< segment which is going to be requested
+	uint16_t m_lastQuality; ///< quality of the last downloaded segment
+	double m_bufferLevel; ///< in sec
+	double m_rebufferTime; ///< total rebuffer in sec
+	Time m_lastChunkStartTime;
+	Time m_lastChunkFinishTime;
+	uint64_t m_lastChunkSize; ///< in bytes
+	std::string m_cookie; ///< opaque state returned with last decision
+	AbrRadioInfo m_radio; ///< network assistance, not sent by the client
+};
+
+struct AbrDecision {
+	AbrDecision(): m_quality(0) {}
+	uint16_t m_quality;
+	std::string m_cookie;
+};
+
+/*
+ * \brief Base class of the in-simulation abr algorithms. An algorithm
+ *        keeps no per client state. Whatever it wants to remember (e.g.
+ *        throughput history) goes into the cookie which is echoed back
+ *        by the client with the next request. That way the same
+ *        algorithm can run on the player as well as in the SpDash
+ *        request handler, which lives only for a single request.
+ */
+class AbrAlgorithm: public Object {
+public:
+	static TypeId GetTypeId(void);
+	AbrAlgorithm();
+	virtual ~AbrAlgorithm();
+
+	virtual void SetVideoData(const VideoData *videoData);
+	virtual AbrDecision GetNextQuality(const AbrRequest &request) = 0;
+	/*
+	 * Asynchronous variant used by the players. Local algorithms answer
+	 * right away, remote ones may defer the callback to batch requests.
+	 */
+	virtual void RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision);
+
+protected:
+	uint16_t GetNumQualities() const;
+	uint16_t GetNumSegments() const;
+	double GetBitrate(uint16_t quality) const; ///< in bps
+	uint64_t GetSegmentSize(uint16_t quality, uint16_t segment) const;
+	double GetSegmentDuration() const; ///< in sec
+	uint16_t GetQualityForBitrate(double bps) const;
+
+	/*
+	 * Throughput history (bps, oldest first) kept in the cookie. The last
+	 * downloaded chunk of the request is appended once.
+	 */
+	std::vector<double> GetThroughputHistory(const AbrRequest &request) const;
+	std::string MakeCookie(const std::vector<double> &history) const;
+	static double HarmonicMean(const std::vector<double> &samples, uint32_t last);
+
+	const VideoData *m_videoData;
+	uint32_t m_historyLength;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_ABR_ALGORITHM_H_ */
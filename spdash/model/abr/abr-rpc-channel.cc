@@ -0,0 +1,203 @@
+/*
+ * abr-rpc-channel.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "abr-rpc-channel.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include <map>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("AbrRpcChannel");
+
+Ptr<AbrRpcChannel> AbrRpcChannel::Get(std::string host, uint16_t port) {
+	static std::map<std::string, Ptr<AbrRpcChannel> > channels;
+	std::string key = host + ":" + std::to_string(port);
+	auto it = channels.find(key);
+	if (it != channels.end())
+		return it->second;
+	Ptr<AbrRpcChannel> channel = Create<AbrRpcChannel>(host, port);
+	channels[key] = channel;
+	return channel;
+}
+
+AbrRpcChannel::AbrRpcChannel(std::string host, uint16_t port): m_host(host),
+		m_port(port), m_sock(-1), m_nextId(0) {
+	NS_LOG_FUNCTION(this << host << port);
+}
+
+AbrRpcChannel::~AbrRpcChannel() {
+	NS_LOG_FUNCTION(this);
+	Close();
+}
+
+void AbrRpcChannel::Submit(const std::vector<double> &bitrates,
+		const AbrRequest &request, Callback<void, AbrDecision> onDecision) {
+	NS_LOG_FUNCTION(this);
+	std::vector<uint32_t> ladder(bitrates.begin(), bitrates.end());
+	uint16_t ladderId = 0;
+	while (ladderId < m_batch.m_ladders.size() && m_batch.m_ladders[ladderId] != ladder)
+		ladderId++;
+	if (ladderId == m_batch.m_ladders.size())
+		m_batch.m_ladders.push_back(ladder);
+
+	AbrRpcEntry entry;
+	entry.m_id = m_nextId++;
+	entry.m_ladder = ladderId;
+	entry.m_segmentNum = request.m_segmentNum;
+	entry.m_lastQuality = request.m_lastQuality;
+	entry.m_bufferMs = request.m_bufferLevel * 1000;
+	entry.m_rebufferMs = request.m_rebufferTime * 1000;
+	entry.m_lastChunkStartNs = request.m_lastChunkStartTime.GetNanoSeconds();
+	entry.m_lastChunkFinishNs = request.m_lastChunkFinishTime.GetNanoSeconds();
+	entry.m_lastChunkSize = request.m_lastChunkSize;
+	entry.m_cookie = request.m_cookie;
+	m_batch.m_entries.push_back(entry);
+
+	Pending pending;
+	pending.m_id = entry.m_id;
+	pending.m_numQualities = bitrates.size();
+	pending.m_fallback.m_quality = request.m_lastQuality < bitrates.size() ? request.m_lastQuality : 0;
+	pending.m_fallback.m_cookie = request.m_cookie;
+	pending.m_onDecision = onDecision;
+	m_pending.push_back(pending);
+
+	if (!m_flushEvent.IsRunning())
+		m_flushEvent = Simulator::ScheduleNow(&AbrRpcChannel::Flush, this);
+}
+
+void AbrRpcChannel::Flush() {
+	NS_LOG_FUNCTION(this);
+	m_flushEvent.Cancel();
+	if (m_pending.empty())
+		return;
+
+	//callbacks may submit again, so detach the current batch first
+	AbrRpcBatch batch;
+	std::vector<Pending> pending;
+	std::swap(batch, m_batch);
+	std::swap(pending, m_pending);
+
+	std::string frame = AbrRpcEncodeFrame(AbrRpcEncodeBatch(batch));
+	std::string payload;
+	std::vector<AbrRpcReply> replies;
+	bool reused = m_sock >= 0;
+	bool ok = RoundTrip(frame, payload);
+	if (!ok && reused) {
+		//server might have restarted since the last batch
+		ok = RoundTrip(frame, payload);
+	}
+	if (ok && !AbrRpcDecodeReplies(payload, replies)) {
+		NS_LOG_ERROR("Invalid reply from abr server");
+		Close();
+	}
+	NS_LOG_INFO("abr batch of " << pending.size() << " requests, " << replies.size() << " replies");
+
+	std::map<uint32_t, AbrRpcReply *> byId;
+	for (auto &reply : replies)
+		byId[reply.m_id] = &reply;
+	for (auto &it : pending) {
+		AbrDecision decision = it.m_fallback;
+		auto found = byId.find(it.m_id);
+		if (found != byId.end() && found->second->m_quality >= it.m_numQualities) {
+			NS_LOG_WARN("abr server chose quality " << found->second->m_quality
+					<< " of " << it.m_numQualities << " for request " << it.m_id);
+		} else if (found != byId.end()) {
+			decision.m_quality = found->second->m_quality;
+			decision.m_cookie = found->second->m_cookie;
+		}
+		it.m_onDecision(decision);
+	}
+}
+
+bool AbrRpcChannel::Connect() {
+	NS_LOG_FUNCTION(this);
+	if (m_sock >= 0)
+		return true;
+
+	struct sockaddr_in servAddr;
+	servAddr.sin_family = AF_INET;
+	servAddr.sin_port = htons(m_port);
+	if (inet_pton(AF_INET, m_host.c_str(), &servAddr.sin_addr) <= 0) {
+		NS_LOG_ERROR("Invalid abr server address " << m_host);
+		return false;
+	}
+	m_sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (m_sock < 0) {
+		NS_LOG_ERROR("Socket creation error");
+		return false;
+	}
+	if (connect(m_sock, (struct sockaddr*) &servAddr, sizeof(servAddr)) < 0) {
+		NS_LOG_WARN("Can't connect to abr server " << m_host << ":" << m_port);
+		Close();
+		return false;
+	}
+	int flag = 1;
+	setsockopt(m_sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+	Simulator::ScheduleDestroy(&AbrRpcChannel::Close, this);
+	return true;
+}
+
+void AbrRpcChannel::Close() {
+	if (m_sock < 0)
+		return;
+	NS_LOG_FUNCTION(this);
+	close(m_sock);
+	m_sock = -1;
+}
+
+bool AbrRpcChannel::RoundTrip(const std::string &frame, std::string &reply) {
+	NS_LOG_FUNCTION(this);
+	if (!Connect())
+		return false;
+	char lenBuf[4];
+	if (!SendAll(frame.data(), frame.size()) || !RecvAll(lenBuf, sizeof(lenBuf))) {
+		Close();
+		return false;
+	}
+	uint32_t len = AbrRpcReader(std::string(lenBuf, sizeof(lenBuf))).ReadU32();
+	if (len > ABR_RPC_MAX_FRAME) {
+		NS_LOG_ERROR("Abr server frame too large: " << len);
+		Close();
+		return false;
+	}
+	reply.resize(len);
+	if (len && !RecvAll(&reply[0], len)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool AbrRpcChannel::SendAll(const char *data, size_t len) {
+	while (len > 0) {
+		ssize_t sent = send(m_sock, data, len, MSG_NOSIGNAL);
+		if (sent <= 0)
+			return false;
+		data += sent;
+		len -= sent;
+	}
+	return true;
+}
+
+bool AbrRpcChannel::RecvAll(char *data, size_t len) {
+	while (len > 0) {
+		ssize_t got = recv(m_sock, data, len, 0);
+		if (got <= 0)
+			return false;
+		data += got;
+		len -= got;
+	}
+	return true;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,66 @@
+/*
+ * abr-rpc-channel.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_ABR_RPC_CHANNEL_H_
+#define SRC_SPDASH_MODEL_ABR_ABR_RPC_CHANNEL_H_
+
+#include "abr-algorithm.h"
+#include "abr-rpc-protocol.h"
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/*
+ * \brief One persistent tcp connection (per host:port and simulation
+ *        process) to an external abr server. Requests submitted at the
+ *        same simulation time are collected and sent as a single
+ *        DecisionBatch frame by an event scheduled for "now", i.e. after
+ *        every other event already due at this timestamp. The round trip
+ *        itself is blocking, the simulation does not advance meanwhile.
+ *
+ *        If the server can't be reached, every request gets its last
+ *        quality and cookie back, the same as the old per segment client.
+ */
+class AbrRpcChannel: public SimpleRefCount<AbrRpcChannel> {
+public:
+	static Ptr<AbrRpcChannel> Get(std::string host, uint16_t port);
+
+	AbrRpcChannel(std::string host, uint16_t port);
+	virtual ~AbrRpcChannel();
+
+	void Submit(const std::vector<double> &bitrates, const AbrRequest &request,
+			Callback<void, AbrDecision> onDecision);
+	void Flush(); ///< send pending requests right now
+	void Close();
+
+private:
+	struct Pending {
+		uint32_t m_id;
+		uint16_t m_numQualities; ///< a reply outside the ladder gets m_fallback
+		AbrDecision m_fallback;
+		Callback<void, AbrDecision> m_onDecision;
+	};
+
+	bool Connect();
+	bool RoundTrip(const std::string &frame, std::string &reply);
+	bool SendAll(const char *data, size_t len);
+	bool RecvAll(char *data, size_t len);
+
+	std::string m_host;
+	uint16_t m_port;
+	int m_sock;
+	uint32_t m_nextId;
+	AbrRpcBatch m_batch;
+	std::vector<Pending> m_pending;
+	EventId m_flushEvent;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_ABR_RPC_CHANNEL_H_ */
@@ -0,0 +1,224 @@
+/*
+ * abr-rpc-protocol.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_ABR_RPC_PROTOCOL_H_
+#define SRC_SPDASH_MODEL_ABR_ABR_RPC_PROTOCOL_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Wire format spoken between RemoteAbr and an external abr server. It is
+ * plain c++ on purpose, so that a server can be built without ns3.
+ *
+ * Every message is a frame: u32 payload length followed by the payload.
+ * All integers are big endian.
+ *
+ * DecisionBatch (client -> server):
+ *   u8 version, u8 type(ABR_RPC_DECISION_BATCH)
+ *   u16 numLadders, numLadders x { u8 numQualities, numQualities x u32 bps }
+ *   u16 numRequests, numRequests x {
+ *       u32 id, u16 ladder, u16 segmentNum, u16 lastQuality,
+ *       u32 bufferMs, u32 rebufferMs, i64 lastChunkStartNs,
+ *       i64 lastChunkFinishNs, u64 lastChunkSize, u16 cookieLen, cookie }
+ *
+ * DecisionReply (server -> client):
+ *   u8 version, u8 type(ABR_RPC_DECISION_REPLY)
+ *   u16 numReplies, numReplies x { u32 id, u16 quality, u16 cookieLen, cookie }
+ *
+ * The bitrate ladders are sent once per batch and every request refers
+ * to one of them, so a batch from clients watching the same video carries
+ * the ladder only once.
+ */
+
+namespace ns3 {
+
+#define ABR_RPC_VERSION 1
+#define ABR_RPC_DECISION_BATCH 1
+#define ABR_RPC_DECISION_REPLY 2
+#define ABR_RPC_MAX_FRAME (16 * 1024 * 1024)
+
+struct AbrRpcEntry {
+	AbrRpcEntry(): m_id(0), m_ladder(0), m_segmentNum(0), m_lastQuality(0),
+			m_bufferMs(0), m_rebufferMs(0), m_lastChunkStartNs(0),
+			m_lastChunkFinishNs(0), m_lastChunkSize(0) {}
+	uint32_t m_id;
+	uint16_t m_ladder;
+	uint16_t m_segmentNum;
+	uint16_t m_lastQuality;
+	uint32_t m_bufferMs;
+	uint32_t m_rebufferMs;
+	int64_t m_lastChunkStartNs;
+	int64_t m_lastChunkFinishNs;
+	uint64_t m_lastChunkSize;
+	std::string m_cookie;
+};
+
+struct AbrRpcBatch {
+	std::vector<std::vector<uint32_t> > m_ladders; ///< bps
+	std::vector<AbrRpcEntry> m_entries;
+};
+
+struct AbrRpcReply {
+	AbrRpcReply(): m_id(0), m_quality(0) {}
+	uint32_t m_id;
+	uint16_t m_quality;
+	std::string m_cookie;
+};
+
+/*
+ * \brief Appends big endian integers to a byte string.
+ */
+class AbrRpcWriter {
+public:
+	void WriteU8(uint8_t val) { m_data.push_back((char) val); }
+	void WriteU16(uint16_t val) { WriteUint(val, 2); }
+	void WriteU32(uint32_t val) { WriteUint(val, 4); }
+	void WriteU64(uint64_t val) { WriteUint(val, 8); }
+	void WriteString(const std::string &str) {
+		uint16_t len = str.size() > 0xffff ? 0xffff : str.size();
+		WriteU16(len);
+		m_data.append(str, 0, len);
+	}
+	std::string &GetData() { return m_data; }
+private:
+	void WriteUint(uint64_t val, int bytes) {
+		for (int i = bytes - 1; i >= 0; i--)
+			m_data.push_back((char) ((val >> (8 * i)) & 0xff));
+	}
+	std::string m_data;
+};
+
+/*
+ * \brief Reads big endian integers from a byte string. Once it runs past
+ *        the end every read returns 0 and IsOk() turns false.
+ */
+class AbrRpcReader {
+public:
+	AbrRpcReader(const std::string &data): m_data(data), m_pos(0), m_ok(true) {}
+	uint8_t ReadU8() { return ReadUint(1); }
+	uint16_t ReadU16() { return ReadUint(2); }
+	uint32_t ReadU32() { return ReadUint(4); }
+	uint64_t ReadU64() { return ReadUint(8); }
+	std::string ReadString() {
+		uint16_t len = ReadU16();
+		if (!m_ok || m_pos + len > m_data.size()) {
+			m_ok = false;
+			return "";
+		}
+		std::string str = m_data.substr(m_pos, len);
+		m_pos += len;
+		return str;
+	}
+	bool IsOk() const { return m_ok; }
+private:
+	uint64_t ReadUint(int bytes) {
+		if (!m_ok || m_pos + bytes > m_data.size()) {
+			m_ok = false;
+			return 0;
+		}
+		uint64_t val = 0;
+		for (int i = 0; i < bytes; i++)
+			val = (val << 8) | (uint8_t) m_data[m_pos++];
+		return val;
+	}
+	const std::string &m_data;
+	size_t m_pos;
+	bool m_ok;
+};
+
+inline std::string AbrRpcEncodeFrame(const std::string &payload) {
+	AbrRpcWriter writer;
+	writer.WriteU32(payload.size());
+	writer.GetData().append(payload);
+	return writer.GetData();
+}
+
+inline std::string AbrRpcEncodeBatch(const AbrRpcBatch &batch) {
+	AbrRpcWriter writer;
+	writer.WriteU8(ABR_RPC_VERSION);
+	writer.WriteU8(ABR_RPC_DECISION_BATCH);
+	writer.WriteU16(batch.m_ladders.size());
+	for (auto &ladder : batch.m_ladders) {
+		writer.WriteU8(ladder.size());
+		for (auto bps : ladder)
+			writer.WriteU32(bps);
+	}
+	writer.WriteU16(batch.m_entries.size());
+	for (auto &entry : batch.m_entries) {
+		writer.WriteU32(entry.m_id);
+		writer.WriteU16(entry.m_ladder);
+		writer.WriteU16(entry.m_segmentNum);
+		writer.WriteU16(entry.m_lastQuality);
+		writer.WriteU32(entry.m_bufferMs);
+		writer.WriteU32(entry.m_rebufferMs);
+		writer.WriteU64(entry.m_lastChunkStartNs);
+		writer.WriteU64(entry.m_lastChunkFinishNs);
+		writer.WriteU64(entry.m_lastChunkSize);
+		writer.WriteString(entry.m_cookie);
+	}
+	return writer.GetData();
+}
+
+inline bool AbrRpcDecodeBatch(const std::string &payload, AbrRpcBatch &batch) {
+	AbrRpcReader reader(payload);
+	if (reader.ReadU8() != ABR_RPC_VERSION || reader.ReadU8() != ABR_RPC_DECISION_BATCH)
+		return false;
+	batch.m_ladders.resize(reader.ReadU16());
+	for (auto &ladder : batch.m_ladders) {
+		ladder.resize(reader.ReadU8());
+		for (auto &bps : ladder)
+			bps = reader.ReadU32();
+	}
+	batch.m_entries.resize(reader.ReadU16());
+	for (auto &entry : batch.m_entries) {
+		entry.m_id = reader.ReadU32();
+		entry.m_ladder = reader.ReadU16();
+		entry.m_segmentNum = reader.ReadU16();
+		entry.m_lastQuality = reader.ReadU16();
+		entry.m_bufferMs = reader.ReadU32();
+		entry.m_rebufferMs = reader.ReadU32();
+		entry.m_lastChunkStartNs = reader.ReadU64();
+		entry.m_lastChunkFinishNs = reader.ReadU64();
+		entry.m_lastChunkSize = reader.ReadU64();
+		entry.m_cookie = reader.ReadString();
+		if (entry.m_ladder >= batch.m_ladders.size())
+			return false;
+	}
+	return reader.IsOk();
+}
+
+inline std::string AbrRpcEncodeReplies(const std::vector<AbrRpcReply> &replies) {
+	AbrRpcWriter writer;
+	writer.WriteU8(ABR_RPC_VERSION);
+	writer.WriteU8(ABR_RPC_DECISION_REPLY);
+	writer.WriteU16(replies.size());
+	for (auto &reply : replies) {
+		writer.WriteU32(reply.m_id);
+		writer.WriteU16(reply.m_quality);
+		writer.WriteString(reply.m_cookie);
+	}
+	return writer.GetData();
+}
+
+inline bool AbrRpcDecodeReplies(const std::string &payload, std::vector<AbrRpcReply> &replies) {
+	AbrRpcReader reader(payload);
+	if (reader.ReadU8() != ABR_RPC_VERSION || reader.ReadU8() != ABR_RPC_DECISION_REPLY)
+		return false;
+	replies.resize(reader.ReadU16());
+	for (auto &reply : replies) {
+		reply.m_id = reader.ReadU32();
+		reply.m_quality = reader.ReadU16();
+		reply.m_cookie = reader.ReadString();
+	}
+	return reader.IsOk();
+}
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_ABR_RPC_PROTOCOL_H_ */
@@ -0,0 +1,65 @@
+/*
+ * bba-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "bba-abr.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("BbaAbr");
+NS_OBJECT_ENSURE_REGISTERED(BbaAbr);
+
+TypeId BbaAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::BbaAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<BbaAbr>()
+			.AddAttribute("Reservoir",
+					"Buffer level below which the lowest quality is requested",
+					TimeValue(Seconds(5)),
+					MakeTimeAccessor(&BbaAbr::m_reservoir),
+					MakeTimeChecker())
+			.AddAttribute("Cushion",
+					"Buffer range over which quality is increased linearly",
+					TimeValue(Seconds(10)),
+					MakeTimeAccessor(&BbaAbr::m_cushion),
+					MakeTimeChecker());
+	return tid;
+}
+
+BbaAbr::BbaAbr(): m_reservoir(Seconds(5)), m_cushion(Seconds(10)) {
+	NS_LOG_FUNCTION(this);
+}
+
+BbaAbr::~BbaAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+AbrDecision BbaAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	AbrDecision decision;
+	decision.m_cookie = request.m_cookie;
+
+	uint16_t top = GetNumQualities() - 1;
+	double reservoir = m_reservoir.GetSeconds();
+	double cushion = m_cushion.GetSeconds();
+	if (request.m_bufferLevel <= reservoir) {
+		decision.m_quality = 0;
+	} else if (request.m_bufferLevel >= reservoir + cushion) {
+		decision.m_quality = top;
+	} else {
+		double minRate = GetBitrate(0);
+		double maxRate = GetBitrate(top);
+		double rate = minRate
+				+ (maxRate - minRate) * (request.m_bufferLevel - reservoir) / cushion;
+		decision.m_quality = GetQualityForBitrate(rate);
+	}
+	NS_LOG_INFO("segment: " << request.m_segmentNum << " buffer: " << request.m_bufferLevel << " quality: " << decision.m_quality);
+	return decision;
+}
+
+} /* namespace ns3 */
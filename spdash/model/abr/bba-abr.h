@@ -0,0 +1,34 @@
+/*
+ * bba-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_BBA_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_BBA_ABR_H_
+
+#include "abr-algorithm.h"
+
+namespace ns3 {
+
+/*
+ * \brief Buffer based adaptation (BBA-0, Huang et al. SIGCOMM'14). Below
+ *        the reservoir the lowest quality is used, above reservoir plus
+ *        cushion the highest. In between, bitrate grows linearly with the
+ *        buffer level.
+ */
+class BbaAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	BbaAbr();
+	virtual ~BbaAbr();
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+private:
+	Time m_reservoir;
+	Time m_cushion;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_BBA_ABR_H_ */
@@ -0,0 +1,70 @@
+/*
+ * bola-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "bola-abr.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("BolaAbr");
+NS_OBJECT_ENSURE_REGISTERED(BolaAbr);
+
+TypeId BolaAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::BolaAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<BolaAbr>()
+			.AddAttribute("BufferTarget",
+					"Maximum buffer level BOLA plans for",
+					TimeValue(Seconds(30)),
+					MakeTimeAccessor(&BolaAbr::m_bufferTarget),
+					MakeTimeChecker())
+			.AddAttribute("Gp",
+					"Rebuffer avoidance weight (gamma * p) of BOLA",
+					DoubleValue(5),
+					MakeDoubleAccessor(&BolaAbr::m_gp),
+					MakeDoubleChecker<double>(0));
+	return tid;
+}
+
+BolaAbr::BolaAbr(): m_bufferTarget(Seconds(30)), m_gp(5) {
+	NS_LOG_FUNCTION(this);
+}
+
+BolaAbr::~BolaAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+AbrDecision BolaAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	AbrDecision decision;
+	decision.m_cookie = request.m_cookie;
+
+	uint16_t numQualities = GetNumQualities();
+	double segDuration = GetSegmentDuration();
+	double qMax = std::max(m_bufferTarget.GetSeconds() / segDuration, 2.0);
+	double q = request.m_bufferLevel / segDuration;
+	double vMax = std::log(GetBitrate(numQualities - 1) / GetBitrate(0));
+	double v = (qMax - 1) / (vMax + m_gp);
+
+	double best = 0;
+	for (uint16_t m = 0; m < numQualities; m++) {
+		double utility = std::log(GetBitrate(m) / GetBitrate(0));
+		double size = GetSegmentSize(m, request.m_segmentNum) * 8.0;
+		double score = (v * (utility + m_gp) - q) / size;
+		if (m == 0 || score >= best) {
+			best = score;
+			decision.m_quality = m;
+		}
+	}
+	NS_LOG_INFO("segment: " << request.m_segmentNum << " buffer: " << request.m_bufferLevel << " quality: " << decision.m_quality);
+	return decision;
+}
+
+} /* namespace ns3 */
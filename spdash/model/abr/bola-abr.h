@@ -0,0 +1,33 @@
+/*
+ * bola-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_BOLA_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_BOLA_ABR_H_
+
+#include "abr-algorithm.h"
+
+namespace ns3 {
+
+/*
+ * \brief BOLA-BASIC (Spiteri et al. INFOCOM'16). Lyapunov based choice
+ *        maximising (V (v_m + gp) - Q) / S_m, where v_m is the log
+ *        utility of quality m and Q the buffer level in segments.
+ */
+class BolaAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	BolaAbr();
+	virtual ~BolaAbr();
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+private:
+	Time m_bufferTarget;
+	double m_gp;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_BOLA_ABR_H_ */
@@ -0,0 +1,106 @@
+/*
+ * mpc-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "mpc-abr.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("MpcAbr");
+NS_OBJECT_ENSURE_REGISTERED(MpcAbr);
+
+TypeId MpcAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::MpcAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<MpcAbr>()
+			.AddAttribute("Horizon",
+					"Number of future segments considered",
+					UintegerValue(5),
+					MakeUintegerAccessor(&MpcAbr::m_horizon),
+					MakeUintegerChecker<uint32_t>(1, 8))
+			.AddAttribute("RebufferPenalty",
+					"QoE penalty per second of rebuffering (in Mbps)",
+					DoubleValue(4.3),
+					MakeDoubleAccessor(&MpcAbr::m_rebufferPenalty),
+					MakeDoubleChecker<double>(0))
+			.AddAttribute("SmoothPenalty",
+					"QoE penalty per Mbps of bitrate change",
+					DoubleValue(1),
+					MakeDoubleAccessor(&MpcAbr::m_smoothPenalty),
+					MakeDoubleChecker<double>(0));
+	return tid;
+}
+
+MpcAbr::MpcAbr(): m_horizon(5), m_rebufferPenalty(4.3), m_smoothPenalty(1) {
+	NS_LOG_FUNCTION(this);
+}
+
+MpcAbr::~MpcAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+double MpcAbr::GetMaxPredictionError(const std::vector<double> &history) const {
+	double maxError = 0;
+	for (uint32_t i = 1; i < history.size(); i++) {
+		std::vector<double> past(history.begin(), history.begin() + i);
+		double predicted = HarmonicMean(past, m_historyLength);
+		if (history[i] > 0)
+			maxError = std::max(maxError, std::fabs(predicted - history[i]) / history[i]);
+	}
+	return maxError;
+}
+
+double MpcAbr::Search(uint16_t segment, uint16_t depth, uint16_t lastQuality,
+		double buffer, double throughput, uint16_t *bestQuality) const {
+	if (depth == 0 || segment >= GetNumSegments())
+		return 0;
+
+	double best = -std::numeric_limits<double>::infinity();
+	for (uint16_t q = 0; q < GetNumQualities(); q++) {
+		double downloadTime = GetSegmentSize(q, segment) * 8.0 / throughput;
+		double rebuffer = std::max(downloadTime - buffer, 0.0);
+		double nextBuffer = std::max(buffer - downloadTime, 0.0) + GetSegmentDuration();
+		double qoe = GetBitrate(q) / 1.0e6
+				- m_rebufferPenalty * rebuffer
+				- m_smoothPenalty * std::fabs(GetBitrate(q) - GetBitrate(lastQuality)) / 1.0e6;
+		qoe += Search(segment + 1, depth - 1, q, nextBuffer, throughput, NULL);
+		if (qoe > best) {
+			best = qoe;
+			if (bestQuality)
+				*bestQuality = q;
+		}
+	}
+	return best;
+}
+
+AbrDecision MpcAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	std::vector<double> history = GetThroughputHistory(request);
+
+	AbrDecision decision;
+	decision.m_cookie = MakeCookie(history);
+
+	double throughput = HarmonicMean(history, m_historyLength)
+			/ (1 + GetMaxPredictionError(history));
+	if (throughput <= 0) {
+		decision.m_quality = 0;
+		return decision;
+	}
+
+	uint16_t lastQuality = std::min(request.m_lastQuality, (uint16_t)(GetNumQualities() - 1));
+	Search(request.m_segmentNum, m_horizon, lastQuality, request.m_bufferLevel,
+			throughput, &decision.m_quality);
+	NS_LOG_INFO("segment: " << request.m_segmentNum << " throughput: " << throughput << " quality: " << decision.m_quality);
+	return decision;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,40 @@
+/*
+ * mpc-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_MPC_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_MPC_ABR_H_
+
+#include "abr-algorithm.h"
+
+namespace ns3 {
+
+/*
+ * \brief RobustMPC (Yin et al. SIGCOMM'15). Throughput is predicted with
+ *        the harmonic mean of past samples discounted by the largest
+ *        recent prediction error. Every quality sequence of the look
+ *        ahead horizon is simulated and the first step of the one with
+ *        the best QoE (bitrate - rebuffer - switching penalty) is taken.
+ */
+class MpcAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	MpcAbr();
+	virtual ~MpcAbr();
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+private:
+	double GetMaxPredictionError(const std::vector<double> &history) const;
+	double Search(uint16_t segment, uint16_t depth, uint16_t lastQuality,
+			double buffer, double throughput, uint16_t *bestQuality) const;
+
+	uint32_t m_horizon;
+	double m_rebufferPenalty;
+	double m_smoothPenalty;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_MPC_ABR_H_ */
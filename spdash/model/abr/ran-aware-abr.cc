@@ -0,0 +1,134 @@
+/*
+ * ran-aware-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "ran-aware-abr.h"
+#include "throughput-abr.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/type-id.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RanAwareAbr");
+NS_OBJECT_ENSURE_REGISTERED(RanAwareAbr);
+
+TypeId RanAwareAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RanAwareAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<RanAwareAbr>()
+			.AddAttribute("BaseAbrTypeId",
+					"The abr algorithm whose decisions are adjusted",
+					TypeIdValue(ThroughputAbr::GetTypeId()),
+					MakeTypeIdAccessor(&RanAwareAbr::GetBaseAbrTypeId, &RanAwareAbr::SetBaseAbrTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("SinrThreshold",
+					"Smoothed sinr (dB) below which the quality is lowered",
+					DoubleValue(0),
+					MakeDoubleAccessor(&RanAwareAbr::m_sinrThreshold),
+					MakeDoubleChecker<double>())
+			.AddAttribute("SinrTrendThreshold",
+					"Sinr trend (dB/s) below which the quality is lowered",
+					DoubleValue(-20),
+					MakeDoubleAccessor(&RanAwareAbr::m_sinrTrendThreshold),
+					MakeDoubleChecker<double>())
+			.AddAttribute("HandoverDrop",
+					"Quality levels dropped around a handover",
+					UintegerValue(1),
+					MakeUintegerAccessor(&RanAwareAbr::m_handoverDrop),
+					MakeUintegerChecker<uint16_t>())
+			.AddAttribute("BlockageDrop",
+					"Quality levels dropped on low or falling sinr",
+					UintegerValue(2),
+					MakeUintegerAccessor(&RanAwareAbr::m_blockageDrop),
+					MakeUintegerChecker<uint16_t>())
+			.AddAttribute("HandoverGuard",
+					"How long after a handover the quality is still lowered",
+					TimeValue(Seconds(1)),
+					MakeTimeAccessor(&RanAwareAbr::m_handoverGuard),
+					MakeTimeChecker())
+			.AddAttribute("SafeBuffer",
+					"Buffer level at which the radio state is ignored",
+					TimeValue(Seconds(20)),
+					MakeTimeAccessor(&RanAwareAbr::m_safeBuffer),
+					MakeTimeChecker());
+	return tid;
+}
+
+RanAwareAbr::RanAwareAbr(): m_sinrThreshold(0), m_sinrTrendThreshold(-20), m_handoverDrop(1),
+		m_blockageDrop(2), m_handoverGuard(Seconds(1)), m_safeBuffer(Seconds(20)) {
+	NS_LOG_FUNCTION(this);
+	m_baseFactory.SetTypeId(ThroughputAbr::GetTypeId());
+}
+
+RanAwareAbr::~RanAwareAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+Ptr<AbrAlgorithm> RanAwareAbr::GetBase() {
+	if (!m_base) {
+		m_base = m_baseFactory.Create<AbrAlgorithm>();
+		m_base->SetVideoData(m_videoData);
+	}
+	return m_base;
+}
+
+void RanAwareAbr::SetVideoData(const VideoData *videoData) {
+	NS_LOG_FUNCTION(this);
+	AbrAlgorithm::SetVideoData(videoData);
+	GetBase()->SetVideoData(videoData);
+}
+
+AbrDecision RanAwareAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	return Adjust(request, GetBase()->GetNextQuality(request));
+}
+
+void RanAwareAbr::RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision) {
+	NS_LOG_FUNCTION(this);
+	//each request carries its own caller, an async base may have several outstanding
+	GetBase()->RequestQuality(request, MakeCallback(&RanAwareAbr::BaseDecided, Ptr<RanAwareAbr>(this))
+			.Bind(request, onDecision));
+}
+
+void RanAwareAbr::BaseDecided(AbrRequest request, Callback<void, AbrDecision> onDecision,
+		AbrDecision decision) {
+	NS_LOG_FUNCTION(this);
+	onDecision(Adjust(request, decision));
+}
+
+AbrDecision RanAwareAbr::Adjust(const AbrRequest &request, AbrDecision decision) const {
+	const AbrRadioInfo &radio = request.m_radio;
+	if (!radio.m_valid || request.m_bufferLevel >= m_safeBuffer.GetSeconds())
+		return decision;
+
+	uint16_t drop = 0;
+	if (radio.m_handover || radio.m_sinceHandover < m_handoverGuard)
+		drop = m_handoverDrop;
+	if (radio.m_sinrValid && (radio.m_sinrDb < m_sinrThreshold || radio.m_sinrTrend < m_sinrTrendThreshold))
+		drop = std::max(drop, m_blockageDrop);
+
+	uint16_t quality = decision.m_quality > drop ? decision.m_quality - drop : 0;
+	NS_LOG_INFO("segment: " << request.m_segmentNum << " cell: " << radio.m_cellId
+			<< " handover: " << radio.m_handover << " sinr: " << radio.m_sinrDb
+			<< " trend: " << radio.m_sinrTrend << " quality: " << decision.m_quality << " -> " << quality);
+	decision.m_quality = quality;
+	return decision;
+}
+
+void RanAwareAbr::SetBaseAbrTypeId(TypeId tid) {
+	m_baseFactory.SetTypeId(tid);
+	m_base = 0;
+}
+
+TypeId RanAwareAbr::GetBaseAbrTypeId(void) const {
+	return m_baseFactory.GetTypeId();
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,57 @@
+/*
+ * ran-aware-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_RAN_AWARE_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_RAN_AWARE_ABR_H_
+
+#include "abr-algorithm.h"
+#include "ns3/object-factory.h"
+
+namespace ns3 {
+
+/*
+ * \brief Network assisted abr. The decision of BaseAbrTypeId is lowered
+ *        ahead of what the throughput history can show, using the radio
+ *        state a SandRadioMonitor put into AbrRequest::m_radio:
+ *        - a handover in progress or completed less than HandoverGuard
+ *          ago lowers it by HandoverDrop levels,
+ *        - a smoothed sinr below SinrThreshold or falling faster than
+ *          SinrTrendThreshold (blockage) lowers it by BlockageDrop levels.
+ *        Nothing is lowered while the buffer holds SafeBuffer or more, or
+ *        when there is no radio state. The cookie of the base is kept.
+ */
+class RanAwareAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	RanAwareAbr();
+	virtual ~RanAwareAbr();
+	virtual void SetVideoData(const VideoData *videoData);
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+	virtual void RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision);
+
+	void SetBaseAbrTypeId(TypeId tid);
+	TypeId GetBaseAbrTypeId(void) const;
+
+private:
+	void BaseDecided(AbrRequest request, Callback<void, AbrDecision> onDecision,
+			AbrDecision decision);
+	AbrDecision Adjust(const AbrRequest &request, AbrDecision decision) const;
+	Ptr<AbrAlgorithm> GetBase();
+
+	ObjectFactory m_baseFactory;
+	Ptr<AbrAlgorithm> m_base;
+	double m_sinrThreshold; ///< dB
+	double m_sinrTrendThreshold; ///< dB/s
+	uint16_t m_handoverDrop;
+	uint16_t m_blockageDrop;
+	Time m_handoverGuard;
+	Time m_safeBuffer;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_RAN_AWARE_ABR_H_ */
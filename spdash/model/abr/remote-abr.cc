@@ -0,0 +1,63 @@
+/*
+ * remote-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "remote-abr.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "abr-rpc-channel.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RemoteAbr");
+NS_OBJECT_ENSURE_REGISTERED(RemoteAbr);
+
+TypeId RemoteAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RemoteAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<RemoteAbr>()
+			.AddAttribute("Host",
+					"IPv4 address of the external abr server",
+					StringValue("127.0.0.1"),
+					MakeStringAccessor(&RemoteAbr::m_host),
+					MakeStringChecker())
+			.AddAttribute("Port",
+					"Port of the external abr server, use a different one for every parallel run",
+					UintegerValue(8333),
+					MakeUintegerAccessor(&RemoteAbr::m_port),
+					MakeUintegerChecker<uint16_t>());
+	return tid;
+}
+
+RemoteAbr::RemoteAbr(): m_port(8333) {
+	NS_LOG_FUNCTION(this);
+}
+
+RemoteAbr::~RemoteAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+void RemoteAbr::RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision) {
+	NS_LOG_FUNCTION(this);
+	NS_ASSERT(m_videoData);
+	AbrRpcChannel::Get(m_host, m_port)->Submit(m_videoData->m_averageBitrate, request, onDecision);
+}
+
+AbrDecision RemoteAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	Ptr<AbrRpcChannel> channel = AbrRpcChannel::Get(m_host, m_port);
+	channel->Submit(m_videoData->m_averageBitrate, request, MakeCallback(&RemoteAbr::StoreDecision, this));
+	channel->Flush();
+	return m_syncDecision;
+}
+
+void RemoteAbr::StoreDecision(AbrDecision decision) {
+	m_syncDecision = decision;
+}
+
+} /* namespace ns3 */
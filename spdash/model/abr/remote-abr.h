@@ -0,0 +1,40 @@
+/*
+ * remote-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_REMOTE_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_REMOTE_ABR_H_
+
+#include "abr-algorithm.h"
+
+namespace ns3 {
+
+/*
+ * \brief Asks an external pensieve style abr server for the next quality.
+ *        All RemoteAbr instances pointing at the same host:port share one
+ *        persistent AbrRpcChannel, and requests issued at the same
+ *        simulation time through RequestQuality go out as a single batch.
+ *        See abr-rpc-protocol.h for the wire format and
+ *        examples/abr/abr-rpc-server.cc for a stand-in server.
+ */
+class RemoteAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	RemoteAbr();
+	virtual ~RemoteAbr();
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+	virtual void RequestQuality(const AbrRequest &request, Callback<void, AbrDecision> onDecision);
+private:
+	void StoreDecision(AbrDecision decision);
+
+	std::string m_host;
+	uint16_t m_port;
+	AbrDecision m_syncDecision;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_REMOTE_ABR_H_ */
@@ -0,0 +1,141 @@
+/*
+ * sand-radio-monitor.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "sand-radio-monitor.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("SandRadioMonitor");
+NS_OBJECT_ENSURE_REGISTERED(SandRadioMonitor);
+
+TypeId SandRadioMonitor::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::SandRadioMonitor")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddConstructor<SandRadioMonitor>()
+			.AddAttribute("SinrTimeConstant",
+					"Time constant of the smoothed sinr",
+					TimeValue(MilliSeconds(100)),
+					MakeTimeAccessor(&SandRadioMonitor::m_sinrTau),
+					MakeTimeChecker())
+			.AddAttribute("TrendTimeConstant",
+					"Time constant of the smoothed sinr trend",
+					TimeValue(MilliSeconds(500)),
+					MakeTimeAccessor(&SandRadioMonitor::m_trendTau),
+					MakeTimeChecker())
+			.AddAttribute("SymbolTimeConstant",
+					"Time constant of the scheduled symbol rate",
+					TimeValue(MilliSeconds(500)),
+					MakeTimeAccessor(&SandRadioMonitor::m_symbolTau),
+					MakeTimeChecker())
+			.AddAttribute("StaleAfter",
+					"The sinr of a UE not scheduled for this long is not reported",
+					TimeValue(Seconds(1)),
+					MakeTimeAccessor(&SandRadioMonitor::m_staleAfter),
+					MakeTimeChecker());
+	return tid;
+}
+
+SandRadioMonitor::SandRadioMonitor(): m_sinrTau(MilliSeconds(100)), m_trendTau(MilliSeconds(500)),
+		m_symbolTau(MilliSeconds(500)), m_staleAfter(Seconds(1)) {
+	NS_LOG_FUNCTION(this);
+}
+
+SandRadioMonitor::~SandRadioMonitor() {
+	NS_LOG_FUNCTION(this);
+}
+
+void SandRadioMonitor::AddUe(uint64_t imsi, Ipv4Address address) {
+	NS_LOG_FUNCTION(this << imsi << address);
+	m_imsiByAddress[address] = imsi;
+	m_ues[imsi];
+}
+
+double SandRadioMonitor::Weight(Time dt, Time tau) {
+	if(!tau.IsStrictlyPositive())
+		return 1;
+	return 1 - std::exp(-dt.GetSeconds() / tau.GetSeconds());
+}
+
+bool SandRadioMonitor::GetRadioInfo(Ipv4Address address, AbrRadioInfo &info) const {
+	auto imsi = m_imsiByAddress.find(address);
+	if(imsi == m_imsiByAddress.end())
+		return false;
+	const Ue &ue = m_ues.at(imsi->second);
+	Time now = Simulator::Now();
+	info.m_valid = true;
+	info.m_cellId = ue.m_cellId;
+	info.m_handover = ue.m_handover;
+	info.m_targetCellId = ue.m_targetCellId;
+	info.m_sinceHandover = ue.m_handoverEnd == Time::Min() ? Time::Max() : now - ue.m_handoverEnd;
+	info.m_sinrValid = ue.m_lastSample.IsStrictlyPositive() && now - ue.m_lastSample <= m_staleAfter;
+	info.m_sinrDb = ue.m_sinrDb;
+	info.m_sinrTrend = ue.m_sinrTrend;
+	//decay up to now, an idle UE's rate falls off
+	info.m_symbolRate = ue.m_symbolRate * (1 - Weight(now - ue.m_lastSymbols, m_symbolTau));
+	return true;
+}
+
+void SandRadioMonitor::Attach(uint64_t imsi, uint16_t cellId, uint16_t rnti) {
+	Ue &ue = m_ues[imsi];
+	m_imsiByRnti.erase(std::make_pair(ue.m_cellId, ue.m_rnti));
+	ue.m_cellId = cellId;
+	ue.m_rnti = rnti;
+	m_imsiByRnti[std::make_pair(cellId, rnti)] = imsi;
+}
+
+void SandRadioMonitor::ConnectionEstablished(uint64_t imsi, uint16_t cellId, uint16_t rnti) {
+	NS_LOG_FUNCTION(this << imsi << cellId << rnti);
+	Attach(imsi, cellId, rnti);
+}
+
+void SandRadioMonitor::HandoverStart(uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId) {
+	NS_LOG_FUNCTION(this << imsi << cellId << targetCellId);
+	Ue &ue = m_ues[imsi];
+	ue.m_handover = true;
+	ue.m_targetCellId = targetCellId;
+}
+
+void SandRadioMonitor::HandoverEndOk(uint64_t imsi, uint16_t cellId, uint16_t rnti) {
+	NS_LOG_FUNCTION(this << imsi << cellId << rnti);
+	Attach(imsi, cellId, rnti);
+	Ue &ue = m_ues[imsi];
+	ue.m_handover = false;
+	ue.m_handoverEnd = Simulator::Now();
+	ue.m_lastSample = Time(0); //the sinr of the old cell says nothing about the new one
+}
+
+void SandRadioMonitor::DlTransportBlock(uint16_t cellId, uint16_t rnti, double sinr, uint8_t numSym) {
+	auto imsi = m_imsiByRnti.find(std::make_pair(cellId, rnti));
+	if(imsi == m_imsiByRnti.end() || sinr <= 0)
+		return;
+	Ue &ue = m_ues[imsi->second];
+	Time now = Simulator::Now();
+	double sinrDb = 10 * std::log10(sinr);
+	if(!ue.m_lastSample.IsStrictlyPositive()) {
+		ue.m_sinrDb = sinrDb;
+		ue.m_sinrTrend = 0;
+	} else if(now > ue.m_lastSample) {
+		Time dt = now - ue.m_lastSample;
+		double smoothed = ue.m_sinrDb + Weight(dt, m_sinrTau) * (sinrDb - ue.m_sinrDb);
+		double slope = (smoothed - ue.m_sinrDb) / dt.GetSeconds();
+		ue.m_sinrTrend += Weight(dt, m_trendTau) * (slope - ue.m_sinrTrend);
+		ue.m_sinrDb = smoothed;
+	}
+	ue.m_lastSample = now;
+
+	if(m_symbolTau.IsStrictlyPositive()) {
+		ue.m_symbolRate = ue.m_symbolRate * (1 - Weight(now - ue.m_lastSymbols, m_symbolTau))
+				+ numSym / m_symbolTau.GetSeconds();
+	}
+	ue.m_lastSymbols = now;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,84 @@
+/*
+ * sand-radio-monitor.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_SAND_RADIO_MONITOR_H_
+#define SRC_SPDASH_MODEL_ABR_SAND_RADIO_MONITOR_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ipv4-address.h"
+#include "abr-algorithm.h"
+#include <map>
+
+namespace ns3 {
+
+/*
+ * \brief Network element of SAND (server and network assisted dash): it
+ *        follows the radio state of every UE and hands it to the abr
+ *        decisions of the UE's player, see AbrRadioInfo.
+ *
+ *        Nothing is polled. The scenario connects the methods below to
+ *        the trace sources of the RAN: the ue rrc ones (ConnectionEstablished,
+ *        HandoverStart, HandoverEndOk) directly, the per transport block
+ *        downlink trace of the phy through a small adapter, as its
+ *        parameter type belongs to the RAN module. Transport blocks come
+ *        with cell id and rnti only, the rrc traces map them to the imsi.
+ *
+ *        The sinr is smoothed with time constant SinrTimeConstant, its
+ *        trend (dB/s) with TrendTimeConstant and the scheduled symbols
+ *        are an exponentially decaying rate with SymbolTimeConstant, so
+ *        none of them depends on the slot length.
+ */
+class SandRadioMonitor: public Object {
+public:
+	static TypeId GetTypeId(void);
+	SandRadioMonitor();
+	virtual ~SandRadioMonitor();
+
+	void AddUe(uint64_t imsi, Ipv4Address address); ///< address the UE's player is reached at
+	bool GetRadioInfo(Ipv4Address address, AbrRadioInfo &info) const;
+
+	void ConnectionEstablished(uint64_t imsi, uint16_t cellId, uint16_t rnti);
+	void HandoverStart(uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId);
+	void HandoverEndOk(uint64_t imsi, uint16_t cellId, uint16_t rnti);
+	/*
+	 * A downlink transport block of numSym OFDM symbols received with
+	 * sinr (linear).
+	 */
+	void DlTransportBlock(uint16_t cellId, uint16_t rnti, double sinr, uint8_t numSym);
+
+private:
+	struct Ue {
+		Ue(): m_cellId(0), m_rnti(0), m_handover(false), m_targetCellId(0),
+				m_handoverEnd(Time::Min()), m_sinrDb(0), m_sinrTrend(0), m_symbolRate(0) {}
+		uint16_t m_cellId;
+		uint16_t m_rnti;
+		bool m_handover;
+		uint16_t m_targetCellId;
+		Time m_handoverEnd;
+		Time m_lastSample; ///< of the sinr, zero if none yet
+		double m_sinrDb;
+		double m_sinrTrend;
+		double m_symbolRate;
+		Time m_lastSymbols;
+	};
+
+	void Attach(uint64_t imsi, uint16_t cellId, uint16_t rnti);
+	static double Weight(Time dt, Time tau); ///< of a new sample after dt
+
+	Time m_sinrTau;
+	Time m_trendTau;
+	Time m_symbolTau;
+	Time m_staleAfter;
+	std::map<uint64_t, Ue> m_ues; //!< by imsi
+	std::map<Ipv4Address, uint64_t> m_imsiByAddress;
+	std::map<std::pair<uint16_t, uint16_t>, uint64_t> m_imsiByRnti; //!< by (cell id, rnti)
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_SAND_RADIO_MONITOR_H_ */
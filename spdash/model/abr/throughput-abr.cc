@@ -0,0 +1,50 @@
+/*
+ * throughput-abr.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "throughput-abr.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ThroughputAbr");
+NS_OBJECT_ENSURE_REGISTERED(ThroughputAbr);
+
+TypeId ThroughputAbr::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::ThroughputAbr")
+			.SetParent<AbrAlgorithm>()
+			.SetGroupName("Applications")
+			.AddConstructor<ThroughputAbr>()
+			.AddAttribute("SafetyFactor",
+					"Fraction of the estimated throughput the selected bitrate may use",
+					DoubleValue(0.9),
+					MakeDoubleAccessor(&ThroughputAbr::m_safetyFactor),
+					MakeDoubleChecker<double>(0, 1));
+	return tid;
+}
+
+ThroughputAbr::ThroughputAbr(): m_safetyFactor(0.9) {
+	NS_LOG_FUNCTION(this);
+}
+
+ThroughputAbr::~ThroughputAbr() {
+	NS_LOG_FUNCTION(this);
+}
+
+AbrDecision ThroughputAbr::GetNextQuality(const AbrRequest &request) {
+	NS_LOG_FUNCTION(this);
+	std::vector<double> history = GetThroughputHistory(request);
+	double estimate = HarmonicMean(history, m_historyLength);
+
+	AbrDecision decision;
+	decision.m_quality = GetQualityForBitrate(estimate * m_safetyFactor);
+	decision.m_cookie = MakeCookie(history);
+	NS_LOG_INFO("segment: " << request.m_segmentNum << " estimate: " << estimate << " quality: " << decision.m_quality);
+	return decision;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,31 @@
+/*
+ * throughput-abr.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_ABR_THROUGHPUT_ABR_H_
+#define SRC_SPDASH_MODEL_ABR_THROUGHPUT_ABR_H_
+
+#include "abr-algorithm.h"
+
+namespace ns3 {
+
+/*
+ * \brief Picks the highest bitrate below the harmonic mean of the last
+ *        few throughput samples scaled by a safety factor.
+ */
+class ThroughputAbr: public AbrAlgorithm {
+public:
+	static TypeId GetTypeId(void);
+	ThroughputAbr();
+	virtual ~ThroughputAbr();
+	virtual AbrDecision GetNextQuality(const AbrRequest &request);
+private:
+	double m_safetyFactor;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_ABR_THROUGHPUT_ABR_H_ */
@@ -11,16 +11,10 @@
 #include <ns3/core-module.h>
 #include <vector>
 #include <iterator>
+#include "ns3/video-data.h"
 
 namespace ns3 {
 
-struct VideoData{
-	std::uint16_t m_numSegments;
-	uint64_t m_segmentDuration;
-	std::vector<double> m_averageBitrate;
-	std::vector<std::vector<uint64_t> > m_segmentSizes;
-};
-
 enum DashPlayerState {
 	DASH_PLAYER_STATE_UNINITIALIZED,
 	DASH_PLAYER_STATE_MPD_DOWNLOADING,
@@ -54,6 +54,16 @@ TypeId DashFileDownloader::GetTypeId(void) {
 						StringValue(),
 						MakeStringAccessor(&DashFileDownloader::m_tracePath),
 						MakeStringChecker())
+				.AddAttribute("BinaryTrace",
+						"Store the trace in the binary HttpTrace format (.htrc) instead of json",
+						BooleanValue(false),
+						MakeBooleanAccessor(&DashFileDownloader::m_binaryTrace),
+						MakeBooleanChecker())
+				.AddAttribute("Timeout",
+						"Time a download may take before it is aborted. Negative disables",
+						TimeValue(Seconds(-1)),
+						MakeTimeAccessor(&DashFileDownloader::m_timeout),
+						MakeTimeChecker())
 				.AddAttribute("NodeTracePath",
 						"Node trace provides informations like current position, speed, cellData per line",
 						StringValue(),
@@ -72,7 +82,7 @@ TypeId DashFileDownloader::GetTypeId(void) {
 	return tid;
 }
 
-DashFileDownloader::DashFileDownloader(): m_running(false), m_serverPort(0), m_numDownloaded(0), m_count(1), m_clen(102400), m_traceId(0) {
+DashFileDownloader::DashFileDownloader(): m_running(false), m_serverPort(0), m_numDownloaded(0), m_count(1), m_clen(102400), m_binaryTrace(false), m_timeout(Seconds(-1)), m_traceId(0) {
 	NS_LOG_FUNCTION(this);
 
 }
@@ -124,6 +134,7 @@ void DashFileDownloader::StartDash() {
 
 	m_httpDownloader = Create<HttpClientBasic>();
 	m_httpDownloader->SetCollectionCB(MakeCallback(&DashFileDownloader::DownloadedCB, this).Bind(Ptr<Object>()), GetNode());
+	m_httpDownloader->SetTimeout(m_timeout);
 
 	if(m_nodeTraceCB.IsNull())
 		m_nodeTraceCB = MakeCallback(&DashFileDownloader::CollectNodeTrace, this);
@@ -149,12 +160,15 @@ void DashFileDownloader::DownloadNextSegment() {
 void DashFileDownloader::Downloaded() {
 	NS_LOG_FUNCTION(this);
 	if(!m_running) return;
-	HttpTrace trace = m_httpDownloader->GetTrace();
+	HttpTrace trace = m_httpDownloader->TakeTrace();
+	if(m_httpDownloader->WasAborted()) {
+		NS_LOG_INFO("Download " << m_numDownloaded << " aborted after " << trace.m_resLen << " bytes");
+	}
 
 	if(m_nodeTraceFp.is_open()) {
 		m_nodeTraceFp.close();
 	}
-	m_httpTrace.push_back(trace);
+	m_httpTrace.push_back(std::move(trace));
 	m_numDownloaded += 1;
 	if(m_numDownloaded < m_count)
 		DownloadNextSegment();
@@ -223,22 +237,11 @@ void DashFileDownloader::LogTrace() {
 	NS_LOG_FUNCTION(this);
 	if(m_tracePath.empty()) return;
 
-	std::ofstream outFile;
-	std::string fpath = m_tracePath + "-" + std::to_string(GetNode()->GetId()) + ".json";
-	outFile.open(fpath.c_str(), std::ofstream::out | std::ofstream::trunc);
-	if (!outFile.is_open()) {
+	std::string fpath = m_tracePath + "-" + std::to_string(GetNode()->GetId())
+			+ (m_binaryTrace ? ".htrc" : ".json");
+	if (!HttpTrace::StoreAll(fpath, m_httpTrace, m_binaryTrace)) {
 		std::cerr << "Can't open file " << m_tracePath << std::endl;
-		return;
-	}
-	std::string separator = "";
-	outFile << "[" << std::endl;
-	for(auto it : m_httpTrace) {
-		outFile << separator;
-		it.StoreInFile(outFile);
-		outFile << std::endl;
-		separator = ",";
 	}
-	outFile << "]" << std::endl;
 }
 
 } /* namespace ns3 */
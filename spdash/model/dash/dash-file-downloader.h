@@ -52,6 +52,8 @@ private:
 	Ptr<HttpClientBasic> m_httpDownloader;
 	std::vector<HttpTrace> m_httpTrace;
 	std::string m_tracePath;
+	bool m_binaryTrace;
+	Time m_timeout;
 	std::map<uint32_t, uint64_t> m_rxData;
 	std::map<uint32_t, uint64_t> m_txData;
 
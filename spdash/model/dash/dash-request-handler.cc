@@ -53,11 +53,10 @@ void DashRequestHandler::ReadyToSend(uint32_t freeBufLen) {
 
 	NS_ASSERT(m_sent <= m_toSent);
 
+	//the body is synthetic, fill the whole tx space with a virtual packet
 	clen_t needToSent = std::min((clen_t)(m_toSent - m_sent), (clen_t)0xffffffff);
-	uint8_t buf[1024];
-	uint32_t tobeSend = std::min(freeBufLen, (uint32_t)sizeof(buf));
-	tobeSend = std::min(tobeSend, (uint32_t)needToSent);
-	uint32_t sent = Send(buf, tobeSend);
+	uint32_t tobeSend = std::min(freeBufLen, (uint32_t)needToSent);
+	uint32_t sent = SendVirtual(tobeSend);
 	NS_ASSERT(sent == tobeSend);
 	m_sent += sent;
 }
@@ -66,13 +65,25 @@ void DashRequestHandler::SocketClosed() {
 	NS_LOG_FUNCTION(this);
 }
 
+void DashRequestHandler::Reset() {
+	HttpServerBaseRequestHandler::Reset();
+	m_toSent = 0;
+	m_sent = 0;
+}
+
 void DashRequestHandler::RequestHeaderReceived() {
 	NS_LOG_FUNCTION(this);
-	std::string responseLen = GetHeader("X-Require-Length");
-	if(!responseLen.empty())
-		m_toSent = std::stoul(responseLen);
-	SetClen(m_toSent);
-	SetStatus(200, "OK");
+	clen_t total;
+	if(!GetRequest()->GetHeaderNumber("X-Require-Length", total)) {
+		NS_LOG_WARN("Malformed X-Require-Length " << GetHeader("X-Require-Length"));
+		m_toSent = 0;
+		SetClen(0);
+		SetStatus(400, "Bad Request");
+		EndHeader();
+		return;
+	}
+	SelectRange(total); //the body is synthetic, where it starts does not matter
+	m_toSent = GetClen();
 	EndHeader();
 }
 
@@ -21,6 +21,7 @@ protected:
 	virtual void ReadyToSend(uint32_t);
 	virtual void SocketClosed();
 	virtual void RequestHeaderReceived();
+	virtual void Reset();
 private:
 	clen_t m_toSent;
 	clen_t m_sent;
@@ -6,14 +6,15 @@
  */
 
 #include "dash-video-player.h"
-#include <stdio.h>
-#include <sys/socket.h>
-#include <arpa/inet.h>
-#include <unistd.h>
-#include <string.h>
-#include "ns3/nlohmann_json.h"
-
-using json = nlohmann::json;
+#include "ns3/throughput-abr.h"
+#include "ns3/video-catalog.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/ipv4.h"
+#include "ns3/pointer.h"
+
+#define MAX_SEGMENT_ATTEMPTS 3
+#define ABANDON_CHECK_INTERVAL 0.5 //sec
+
 namespace ns3 {
 
 
@@ -54,11 +55,60 @@ TypeId DashVideoPlayer::GetTypeId(void) {
 					"File Path to store trace",
 					StringValue(),
 					MakeStringAccessor(&DashVideoPlayer::m_tracePath),
-					MakeStringChecker());
+					MakeStringChecker())
+			.AddAttribute("AbrTypeId",
+					"TypeId of the AbrAlgorithm used to select segment quality",
+					TypeIdValue(ThroughputAbr::GetTypeId()),
+					MakeTypeIdAccessor(&DashVideoPlayer::GetAbrTypeId, &DashVideoPlayer::SetAbrTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("PipelineDepth",
+					"Segment requests kept in flight on one connection",
+					UintegerValue(1),
+					MakeUintegerAccessor(&DashVideoPlayer::m_pipelineDepth),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("MaxConnections",
+					"Parallel connections used to fetch segments",
+					UintegerValue(1),
+					MakeUintegerAccessor(&DashVideoPlayer::m_maxConnections),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("Multiplex",
+					"Fetch over streams of one multiplexed connection, MaxConnections then counts streams",
+					BooleanValue(false),
+					MakeBooleanAccessor(&DashVideoPlayer::m_multiplex),
+					MakeBooleanChecker())
+			.AddAttribute("SocketFactory",
+					"TypeId of the socket factory segments are fetched over, e.g. ns3::RudpSocketFactory",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&DashVideoPlayer::m_socketFactory),
+					MakeTypeIdChecker())
+			.AddAttribute("Timeout",
+					"Time a segment request may take, a late segment is requested again at the lowest quality. Negative disables",
+					TimeValue(Seconds(-1)),
+					MakeTimeAccessor(&DashVideoPlayer::m_timeout),
+					MakeTimeChecker())
+			.AddAttribute("AbandonSegments",
+					"Abandon a segment that will not arrive before the buffer runs dry and request it at a lower quality",
+					BooleanValue(false),
+					MakeBooleanAccessor(&DashVideoPlayer::m_abandon),
+					MakeBooleanChecker())
+			.AddAttribute("ResumeSegments",
+					"When the connection breaks (e.g. reset by a handover) request only the rest of the segment with a Range request",
+					BooleanValue(true),
+					MakeBooleanAccessor(&DashVideoPlayer::m_resume),
+					MakeBooleanChecker())
+			.AddAttribute("RadioMonitor",
+					"SandRadioMonitor whose view of this node's radio state is handed to the abr, none if null",
+					PointerValue(),
+					MakePointerAccessor(&DashVideoPlayer::m_radioMonitor),
+					MakePointerChecker<SandRadioMonitor>());
 	return tid;
 }
 
-DashVideoPlayer::DashVideoPlayer(): m_running(0), m_serverPort(0) {
+DashVideoPlayer::DashVideoPlayer(): m_running(0), m_serverPort(0), m_videoData(NULL),
+		m_nextSegmentNum(0), m_abrPending(false), m_pipelineDepth(1), m_maxConnections(1), m_multiplex(false),
+		m_socketFactory(TcpSocketFactory::GetTypeId()),
+		m_timeout(Seconds(-1)), m_abandon(false), m_resume(true),
+		m_lastQuality(0), m_lastChunkSize(0) {
 
 }
 
@@ -69,8 +119,10 @@ void DashVideoPlayer::StopApplication() {
 	NS_LOG_FUNCTION(this);
 	if(!m_running) return;
 
-	if(m_httpDownloader != 0){
-		m_httpDownloader->StopConnection();
+	m_fillEvent.Cancel();
+	m_abandonEvent.Cancel();
+	if(m_clientPool != 0){
+		m_clientPool->StopAll();
 	}
 }
 
@@ -93,53 +145,13 @@ void DashVideoPlayer::StartApplication() {
 		m_onStartClient();
 	}
 
-	ReadInVideoInfo();
-	StartDash();
-}
-
-int DashVideoPlayer::ReadInVideoInfo() {
-	NS_LOG_FUNCTION(this);
-	std::ifstream myfile;
-	myfile.open(m_videoFilePath);
-	NS_ASSERT(myfile);
-	if (!myfile) {
-		return -1;
-	}
-	std::string temp;
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
-	}
-	std::istringstream buffer(temp);
-	std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-			std::istream_iterator<uint64_t>());
-	m_videoData.m_segmentDuration = line.front();
-	//read bitrates
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
-	}
-	buffer = std::istringstream(temp);
-	std::vector<double> linef((std::istream_iterator<double>(buffer)),
-			std::istream_iterator<double>());
-	m_videoData.m_averageBitrate = linef;
-	//read bitrates
-	uint16_t numsegs = 0;
-	while (std::getline(myfile, temp)) {
-		if (temp.empty()) {
-			break;
-		}
-		std::istringstream buffer(temp);
-		std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-				std::istream_iterator<uint64_t>());
-		m_videoData.m_segmentSizes.push_back(line);
-		NS_ASSERT(numsegs == 0 || numsegs == line.size());
-		numsegs = line.size();
+	m_videoData = VideoCatalog::Get(m_videoFilePath);
+	if(!m_videoData) {
+		NS_FATAL_ERROR("Can't read video file " << m_videoFilePath);
 	}
-	m_videoData.m_numSegments = numsegs;
-	NS_ASSERT_MSG(!m_videoData.m_segmentSizes.empty(),
-			"No segment sizes read from file.");
-	return 1;
+	m_abr = m_abrFactory.Create<AbrAlgorithm>();
+	m_abr->SetVideoData(m_videoData);
+	StartDash();
 }
 
 /****************************************
@@ -154,7 +166,12 @@ void DashVideoPlayer::StartDash() {
 
 	NS_ASSERT(m_playback.m_state == DASH_PLAYER_STATE_UNINITIALIZED);
 
-	m_httpDownloader = Create<HttpClientBasic>();
+	m_clientPool = CreateObject<HttpClientPool>();
+	m_clientPool->SetAttribute("MaxConnections", UintegerValue(m_maxConnections));
+	m_clientPool->SetAttribute("Multiplex", BooleanValue(m_multiplex));
+	m_clientPool->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+	m_clientPool->SetNode(GetNode());
+	m_httpDownloader = m_clientPool->Acquire(m_serverAddress, m_serverPort);
 	m_httpDownloader->SetCollectionCB(MakeCallback(&DashVideoPlayer::DownloadedCB, this).Bind(Ptr<Object>()), GetNode());
 	m_httpDownloader->InitConnection(m_serverAddress, m_serverPort, "/mpd");
 
@@ -162,8 +179,8 @@ void DashVideoPlayer::StartDash() {
 	//initialisation
 	m_lastChunkStartTime = Simulator::Now();	//time when download started
 	m_cookie = "";
-	m_lastChunkSize = std::to_string(expected);
-	m_lastQuality = "0";
+	m_lastChunkSize = expected;
+	m_lastQuality = 0;
 	m_totalRebuffer = Time(0);
 	m_currentRebuffer = Time(0);
 	m_httpDownloader->Connect();
@@ -174,22 +191,13 @@ void DashVideoPlayer::StartDash() {
 
 void DashVideoPlayer::Downloaded() {
 	NS_LOG_FUNCTION(this);
-	HttpTrace trace = m_httpDownloader->GetTrace();
-	m_httpTrace.push_back(trace);
+	m_httpTrace.push_back(m_httpDownloader->TakeTrace());
+	m_clientPool->Release(m_httpDownloader);
 	if(!m_running) return;
 
-	switch (m_playback.m_state) {
-		case DASH_PLAYER_STATE_MPD_DOWNLOADING:
-			m_playback.m_state = DASH_PLAYER_STATE_MPD_DOWNLOADED;
-			DownloadNextSegment(); //no need to go through
-			break;
-		case DASH_PLAYER_STATE_SEGMENT_DOWNLOADING:
-			m_playback.m_state = DASH_PLAYER_STATE_IDLE;
-			DashController();
-			break;
-		default:
-			NS_ASSERT(false && "Invalid State");
-	}
+	NS_ASSERT(m_playback.m_state == DASH_PLAYER_STATE_MPD_DOWNLOADING);
+	m_playback.m_state = DASH_PLAYER_STATE_MPD_DOWNLOADED;
+	FillPipeline(); //no need to go through
 }
 
 void DashVideoPlayer::DownloadedCB(Ptr<Object> obj) {
@@ -199,6 +207,91 @@ void DashVideoPlayer::DownloadedCB(Ptr<Object> obj) {
 	Simulator::ScheduleNow(&DashVideoPlayer::Downloaded, this);
 }
 
+void DashVideoPlayer::SegmentDownloadedCB(uint16_t segmentNum) {
+	NS_LOG_FUNCTION(this << segmentNum);
+	for(auto &it : m_inFlight) {
+		if(it.m_segmentNum != segmentNum)
+			continue;
+		bool incomplete = it.m_client->WasAborted() || it.m_received < it.m_size;
+		if(incomplete && it.m_attempts < MAX_SEGMENT_ATTEMPTS) {
+			if(!it.m_reissue) {
+				//not abandoned: a broken connection is resumed, a timeout starts over low
+				it.m_resume = m_resume && !it.m_client->WasTimedOut()
+						&& it.m_received > 0 && it.m_received < it.m_size;
+				if(!it.m_resume)
+					it.m_quality = 0;
+			}
+			it.m_reissue = true;
+			m_httpTrace.push_back(it.m_client->TakeTrace()); //the wasted part
+			break;
+		}
+		if(incomplete) {
+			NS_LOG_WARN("Segment " << it.m_segmentNum << " failed after " << it.m_attempts
+					<< " attempts, " << it.m_received << " of " << it.m_size << " bytes");
+			it.m_failed = true;
+		}
+		it.m_done = true;
+		it.m_finishTime = Simulator::Now();
+		it.m_trace = it.m_client->TakeTrace();
+		break;
+	}
+	Simulator::ScheduleNow(&DashVideoPlayer::SegmentDownloaded, this);
+}
+
+void DashVideoPlayer::SegmentDataReceived(uint16_t segmentNum, Ptr<const Packet> data) {
+	for(auto &it : m_inFlight) {
+		if(it.m_segmentNum == segmentNum) {
+			it.m_received += data->GetSize();
+			break;
+		}
+	}
+}
+
+void DashVideoPlayer::SegmentDownloaded() {
+	NS_LOG_FUNCTION(this);
+	for(auto &it : m_inFlight) {
+		if((it.m_done || it.m_reissue) && it.m_client != 0) {
+			m_clientPool->Release(it.m_client);
+			it.m_client = 0;
+		}
+	}
+	if(!m_running) return;
+
+	for(auto &it : m_inFlight) {
+		if(it.m_done || !it.m_reissue || it.m_client != 0)
+			continue;
+		Ptr<HttpClientBasic> client = m_clientPool->Acquire(m_serverAddress, m_serverPort, m_pipelineDepth);
+		if(client == 0)
+			break; //tried again after the next response
+		NS_LOG_INFO("Requesting segment " << it.m_segmentNum << " again at quality " << it.m_quality);
+		RequestSegment(it, client);
+	}
+
+	//play out in order whatever is complete at the head
+	while(!m_inFlight.empty() && m_inFlight.front().m_done) {
+		SegmentRequest segment = std::move(m_inFlight.front());
+		m_inFlight.pop_front();
+		m_httpTrace.push_back(std::move(segment.m_trace));
+		if(segment.m_failed) {
+			//a partial segment cannot be played, stop instead of pretending it arrived
+			NS_LOG_WARN("Ending playback, segment " << segment.m_segmentNum << " never arrived");
+			m_playback.m_state = DASH_PLAYER_STATE_FINISHED;
+			StopApplication();
+			EndApplication();
+			return;
+		}
+		m_playback.m_curSegmentNum = segment.m_segmentNum;
+		m_lastChunkStartTime = segment.m_startTime;
+		m_lastChunkFinishTime = segment.m_finishTime;
+		m_lastChunkSize = segment.m_received;
+		DashController();
+	}
+	if(m_inFlight.empty()) {
+		m_playback.m_state = DASH_PLAYER_STATE_IDLE;
+	}
+	FillPipeline();
+}
+
 #define MIN_BUFFER_LENGTH 30 //sec
 #define NS_IN_SEC 1000000
 void DashVideoPlayer::DashController() {
@@ -206,158 +299,151 @@ void DashVideoPlayer::DashController() {
 
 	AdjustVideoMetrices();
 
-	if(m_playback.m_curSegmentNum < m_videoData.m_numSegments - 1) {
-		Time delay = std::max(m_playback.m_bufferUpto - Time(std::to_string(MIN_BUFFER_LENGTH) + "s"), Time(0));
-		Simulator::Schedule(delay, &DashVideoPlayer::DownloadNextSegment, this);
-	}
-	else{
+	if(m_playback.m_curSegmentNum == m_videoData->m_numSegments - 1) {
 		Simulator::Schedule(m_playback.m_bufferUpto, &DashVideoPlayer::FinishedPlayback, this);
 	}
 }
 
-std::string DashVideoPlayer::CreateRequestString( std::string cookie, std::string nextChunkId, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize) {
-	json jsonBody;
-	jsonBody["bitrateArray"] = m_videoData.m_averageBitrate;
-
-	if(cookie=="")
-		jsonBody["cookie"] = nullptr;
-	else
-		jsonBody["cookie"] = cookie;
-//	std::cout<<"cookie="<<cookie<<", nextChunkId="<<nextChunkId<<", lastQuality="<<lastQuality<<", buffer="<<buffer<<", lastRequest="<<lastRequest<<", rebufferTime="<<rebufferTime<<", lastChunkFinishTime="<<lastChunkFinishTime<<", lastChunkStartTime="<<lastChunkStartTime<<", lastChunkSize="<<lastChunkSize<<"\n";
-	jsonBody["nextChunkId"] = stoul(nextChunkId);
-	// std::cout<<"okay\n"<<lastQuality<<"\n"<<buffer<<"\n";
-	jsonBody["lastquality"] = stoul(lastQuality);
-	// std::cout<<"okay\n";
-	jsonBody["buffer"] = stod(buffer);  //in seconds
-
-	jsonBody["lastRequest"] = stoul(lastRequest);
-	jsonBody["rebufferTime"] = stod(rebufferTime);
-	// std::cout<<"okay\n";
-	jsonBody["lastChunkFinishTime"] = stoul(lastChunkFinishTime);
-	jsonBody["lastChunkStartTime"] = stoul(lastChunkStartTime);
-	// std::cout<<"okay"<<lastChunkSize<<"\n";
-	jsonBody["lastChunkSize"] = stoul(lastChunkSize);
-	// std::cout<<"okay\n";
-	std::string jsonString = jsonBody.dump(4);
-	int contentLength = jsonString.length();
-	std::string requestString = "POST / HTTP/1.1\r\nUser-Agent: Mozilla/4.0 (compatible; MSIE5.01; Windows NT)\r\nHost: www.tutorialspoint.com\r\nContent-Type: text/xml; charset=utf-8\r\nContent-Length: " + std::to_string(contentLength) + "\r\nAccept-Language: en-us\r\nAccept-Encoding: gzip, deflate\r\nConnection: Keep-Alive\r\n\r\n"+jsonString;
-	// std::cout<<"jstring="<<requestString<<"\n";
-	return requestString;
+/*
+ * Requests the next segment while the buffer, counting the segments
+ * already in flight, is below MIN_BUFFER_LENGTH and less than
+ * PipelineDepth x MaxConnections requests are outstanding. With nothing
+ * in flight and a full buffer it waits until the buffer drains to the
+ * target, which is what the player did before it could pipeline.
+ */
+void DashVideoPlayer::FillPipeline() {
+	NS_LOG_FUNCTION(this);
+	m_fillEvent.Cancel();
+	if(!m_running || m_abrPending) return;
+	if(m_nextSegmentNum >= m_videoData->m_numSegments) return;
+	if(m_inFlight.size() >= m_pipelineDepth * m_maxConnections) return;
+
+	Time target = Seconds(MIN_BUFFER_LENGTH);
+	Time buffered = GetBufferLevel()
+			+ MicroSeconds(m_videoData->m_segmentDuration * m_inFlight.size());
+	if(buffered > target) {
+		if(m_inFlight.empty()) {
+			m_fillEvent = Simulator::Schedule(buffered - target, &DashVideoPlayer::FillPipeline, this);
+		}
+		return;
+	}
+	m_httpDownloader = m_clientPool->Acquire(m_serverAddress, m_serverPort, m_pipelineDepth);
+	if(m_httpDownloader == 0) return; //every connection is full, wait for a response
+
+	//segments are numbered 0..N-1 as before pipelining and the buffer is
+	//reported as of the last completed segment, so PipelineDepth 1 sends
+	//the abr the same requests the sequential player did
+	AbrRequest abrRequest;
+	abrRequest.m_segmentNum = m_nextSegmentNum;
+	abrRequest.m_lastQuality = m_lastQuality;
+	abrRequest.m_bufferLevel = m_playback.m_bufferUpto.GetSeconds();
+	abrRequest.m_rebufferTime = m_totalRebuffer.GetSeconds();
+	abrRequest.m_lastChunkStartTime = m_lastChunkStartTime;
+	abrRequest.m_lastChunkFinishTime = m_lastChunkFinishTime;
+	abrRequest.m_lastChunkSize = m_lastChunkSize;
+	abrRequest.m_cookie = m_cookie;
+	FillRadioInfo(abrRequest.m_radio);
+	m_abrPending = true;
+	m_abr->RequestQuality(abrRequest, MakeCallback(&DashVideoPlayer::QualitySelected, this));
+}
+
+void DashVideoPlayer::QualitySelected(AbrDecision decision) {
+	NS_LOG_FUNCTION(this);
+	m_abrPending = false;
+	if(!m_running) return;
+	m_playback.m_nextQualityNum = decision.m_quality;
+	m_lastQuality = decision.m_quality;
+	m_cookie = decision.m_cookie;
+
+	SegmentRequest segment;
+	segment.m_segmentNum = m_nextSegmentNum++;
+	segment.m_quality = m_playback.m_nextQualityNum;
+	m_inFlight.push_back(std::move(segment));
+	RequestSegment(m_inFlight.back(), m_httpDownloader);
+	m_playback.m_state = DASH_PLAYER_STATE_SEGMENT_DOWNLOADING;
+	FillPipeline();
 }
 
-//Adds header in response
-int
-DashVideoPlayer::Abr (std::string cookie, std::string segmentNum, std::string lastQuality, std::string buffer,
-                      std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime,
-                      std::string lastChunkStartTime, std::string lastChunkSize)
-{
-  const int PORT = 8333;
-  int sock = 0, valread;
-  struct sockaddr_in serv_addr;
-
-  std::string to_send = CreateRequestString (cookie, segmentNum, lastQuality, buffer, lastRequest, rebufferTime,
-                                             lastChunkFinishTime, lastChunkStartTime, lastChunkSize);
-
-  // std::cout<< "POST / HTTP/1.1\r\nUser-Agent: Mozilla/4.0 (compatible; MSIE5.01; Windows NT)\r\nHost: www.tutorialspoint.com\r\nContent-Type: text/xml; charset=utf-8\r\nContent-Length: 260\r\nAccept-Language: en-us\r\nAccept-Encoding: gzip, deflate\r\nConnection: Keep-Alive\r\n\r\n{\n\"bitrateArray\":[400000,600000,1000000,1500000,2500000,4000000],\n\"cookie\":null,\n\"nextChunkId\":1,\n\"lastquality\":1,\n\"buffer\":8,\n\"lastRequest\":0,\n\"rebufferTime\":0,\n\"lastChunkFinishTime\":1594907984144,\n\"lastChunkStartTime\":1594907984101,\n\"lastChunkSize\":1366834\n}"<<"\n";
-  const char *AbrRequest = to_send.c_str ();
-
-  printf ("\n####################AbrRequest#######################\n%s\n", AbrRequest);
-
-  char buff[1024] =
-      { 0 };
-  if ((sock = socket (AF_INET, SOCK_STREAM, 0)) < 0)
-    {
-      printf ("\n Socket creation error \n");
-      return -1;
-    }
-
-  serv_addr.sin_family = AF_INET;
-  serv_addr.sin_port = htons (PORT);
-
-  // Convert IPv4 and IPv6 addresses from text to binary form
-  if (inet_pton (AF_INET, "127.0.0.1", &serv_addr.sin_addr) <= 0)
-    {
-      printf ("\nInvalid address/ Address not supported \n");
-      return -1;
-    }
-
-  if (connect (sock, (struct sockaddr*) &serv_addr, sizeof(serv_addr)) < 0)
-    {
-      printf ("\nConnection Failed \n");
-      return -1;
-    }
-  // else
-  // 	printf("connected\n");
-  send (sock, AbrRequest, strlen (AbrRequest), 0);
-  // printf("Hello message sent\n");
-  // bool firstTime = true;
-  std::string entireContent;
-  while (1)
-    {
-      // firstTime=false;
-      valread = read (sock, buff, 1024);
-      if (valread <= 0)
-        break;
-      buff[valread] = '\0';
-      entireContent += buff;
-      // printf("%d %s####\n",valread,buff );
-    }
-  //std::cout<< "entire response<<<<" << entireContent << "<<<<<<<<<\n\n\n\n" ;
-  // for(unsigned int i=0 ; i < entireContent.length();i++) {
-  // 	std::cout<<int(entireContent[i])<<entireContent[i]<<"\n";
-  // }
-  std::string delimiter = "\r\n\r\n";
-  std::string responseBody = entireContent.substr (entireContent.find (delimiter) + 4, std::string::npos);
-  // std::cout<< "substr = "<<responseBody<<"\n";
-  json jsonResponse = json::parse (responseBody);
-  for (auto it = jsonResponse.begin (); it != jsonResponse.end (); ++it)
-    {
-      // AddHeader(it.key(),it.value());
-      std::cout << (it.key ()) << " " << (it.value ()) << "\n";
-    }
-  m_lastQuality = std::to_string (int (jsonResponse["quality"]));
-  m_cookie = jsonResponse["cookie"];
-  // std::cout<<"\n";
-  // std::cout<<"Exiting ABR-------------------------\n";
-  return int (jsonResponse["quality"]);
+void DashVideoPlayer::RequestSegment(SegmentRequest &segment, Ptr<HttpClientBasic> client) {
+	NS_LOG_FUNCTION(this << segment.m_segmentNum);
+	if(!segment.m_resume) {
+		segment.m_size = m_videoData->GetSegmentSize(segment.m_quality, segment.m_segmentNum);
+		segment.m_received = 0;
+		segment.m_startTime = Simulator::Now();
+	}
+	segment.m_done = false;
+	segment.m_reissue = false;
+	segment.m_attempts++;
+	segment.m_client = client;
+
+	std::string url = "/seg-" + std::to_string(segment.m_segmentNum)
+			+ "-" + std::to_string(segment.m_quality);
+	client->SetCollectionCB(MakeCallback(&DashVideoPlayer::SegmentDownloadedCB, this).Bind(segment.m_segmentNum), GetNode());
+	client->SetBodySink(MakeCallback(&DashVideoPlayer::SegmentDataReceived, this).Bind(segment.m_segmentNum));
+	client->SetTimeout(m_timeout);
+	client->InitConnection(url);
+	client->AddReqHeader("X-Require-Length", std::to_string(segment.m_size));
+	if(segment.m_resume) {
+		NS_LOG_INFO("Resuming segment " << segment.m_segmentNum << " from byte " << segment.m_received);
+		client->SetReqRange(segment.m_received);
+		segment.m_resume = false;
+	}
+	client->Connect();
+
+	if(m_abandon && !m_abandonEvent.IsRunning()) {
+		m_abandonEvent = Simulator::Schedule(Seconds(ABANDON_CHECK_INTERVAL), &DashVideoPlayer::CheckAbandon, this);
+	}
 }
 
-void DashVideoPlayer::DownloadNextSegment() {
+/*
+ * Looks at the segment playback waits for. If at the rate it arrives so
+ * far it would finish after the buffer ran dry, and a lower quality
+ * fetched from scratch would be done earlier, its connection is aborted
+ * and the segment requested again at the highest such quality that fits
+ * in the buffer. Other requests pipelined on that connection are sent
+ * again unchanged.
+ */
+void DashVideoPlayer::CheckAbandon() {
 	NS_LOG_FUNCTION(this);
-	if(!m_running) return;
-	m_playback.m_curSegmentNum += 1;
-	if(m_playback.m_curSegmentNum == m_videoData.m_numSegments) {
-		m_playback.m_state = DASH_PLAYER_STATE_FINISHED;
+	if(!m_running || m_inFlight.empty()) return;
+	m_abandonEvent = Simulator::Schedule(Seconds(ABANDON_CHECK_INTERVAL), &DashVideoPlayer::CheckAbandon, this);
+
+	SegmentRequest &head = m_inFlight.front();
+	Time elapsed = Simulator::Now() - head.m_startTime;
+	if(head.m_done || head.m_client == 0 || head.m_quality == 0 || head.m_received == 0
+			|| head.m_received >= head.m_size
+			|| elapsed < Seconds(ABANDON_CHECK_INTERVAL))
 		return;
+
+	double rate = head.m_received / elapsed.GetSeconds(); //bytes per sec
+	double remaining = (head.m_size - head.m_received) / rate;
+	double buffer = GetBufferLevel().GetSeconds();
+	if(remaining <= buffer)
+		return;
+	uint16_t quality = 0;
+	for(uint16_t q = head.m_quality - 1; q > 0; q--) {
+		if(m_videoData->GetSegmentSize(q, head.m_segmentNum) / rate <= buffer) {
+			quality = q;
+			break;
+		}
 	}
+	if(m_videoData->GetSegmentSize(quality, head.m_segmentNum) / rate >= remaining)
+		return;
 
-	std::string segmentNum = std::to_string(m_playback.m_curSegmentNum);
-	std::string lastChunkFinishTime = std::to_string(m_lastChunkFinishTime.GetNanoSeconds());
-	std::string lastChunkStartTime = std::to_string(m_lastChunkStartTime.GetNanoSeconds());
-	std::string buffer = std::to_string(m_playback.m_bufferUpto.GetSeconds());
-	// std::to_string(0);
-	std::string lastChunkSize = m_lastChunkSize;
-	std::string cookie = m_cookie;
-	std::string lastQuality = m_lastQuality;
-	std::string rebufferTime = std::to_string(m_totalRebuffer.GetSeconds());
-	std::string lastRequest = std::to_string(m_playback.m_curSegmentNum-1);
-	int nextQualityNum = Abr( cookie, segmentNum, lastQuality, buffer, lastRequest, rebufferTime, lastChunkFinishTime, lastChunkStartTime, lastChunkSize);//updates m_lq,m_cookie
-
-	/****************************************
-	 * We will call abrController from here *
-	 ****************************************/
-	auto nextSegmentLength = m_videoData.m_segmentSizes.at(
-			nextQualityNum).at(m_playback.m_curSegmentNum);
-
-	std::string url = "/seg-" + std::to_string(m_playback.m_curSegmentNum)
-			+ "-" + std::to_string(m_playback.m_nextQualityNum);
-	m_httpDownloader->InitConnection(m_serverAddress, m_serverPort, url);
-	m_httpDownloader->AddReqHeader("X-Require-Length", std::to_string(nextSegmentLength));
-
-	m_lastChunkStartTime = Simulator::Now();
-	m_lastChunkSize = std::to_string(nextSegmentLength);
-	m_httpDownloader->Connect();
-	m_playback.m_state = DASH_PLAYER_STATE_SEGMENT_DOWNLOADING;
+	NS_LOG_INFO("Abandoning segment " << head.m_segmentNum << " at quality " << head.m_quality
+			<< ", " << remaining << "s left with " << buffer << "s buffered");
+	Ptr<HttpClientBasic> client = head.m_client;
+	for(auto &it : m_inFlight) {
+		if(it.m_client == client)
+			it.m_reissue = true;
+	}
+	head.m_quality = quality;
+	client->Abort();
+}
+
+Time DashVideoPlayer::GetBufferLevel() const {
+	if(m_playback.m_bufferUpto.IsZero()) return Time(0);
+	return std::max(m_playback.m_bufferUpto - (Simulator::Now() - m_lastIncident), Time(0));
 }
 
 void DashVideoPlayer::FinishedPlayback() {
@@ -387,32 +473,43 @@ void DashVideoPlayer::AdjustVideoMetrices() {
 	m_lastIncident = Simulator::Now();
 
 	m_playback.m_playbackTime = curPlaybackTime;
-	m_playback.m_bufferUpto = curBufUpto + Time(std::to_string(m_videoData.m_segmentDuration) + "us");
+	m_playback.m_bufferUpto = curBufUpto + Time(std::to_string(m_videoData->m_segmentDuration) + "us");
 }
 
 void DashVideoPlayer::LogTrace() {
 	NS_LOG_FUNCTION(this);
 	if(m_tracePath.empty()) return;
 
-	std::ofstream outFile;
 	std::string fpath = m_tracePath + "-" + std::to_string(GetNode()->GetId()) + ".json";
-	outFile.open(fpath.c_str(), std::ofstream::out | std::ofstream::trunc);
-	if (!outFile.is_open()) {
+	if (!HttpTrace::StoreAll(fpath, m_httpTrace, false)) {
 		std::cerr << "Can't open file " << m_tracePath << std::endl;
-		return;
 	}
-	std::string separator = "";
-	outFile << "[" << std::endl;
-	for(auto it : m_httpTrace) {
-		outFile << separator;
-		it.StoreInFile(outFile);
-		outFile << std::endl;
-		separator = ",";
-	}
-	outFile << "]" << std::endl;
 }
 
 void DashVideoPlayer::LogABR() {
 }
 
+void DashVideoPlayer::FillRadioInfo(AbrRadioInfo &radio) {
+	if(m_radioMonitor == 0)
+		return;
+	Ptr<Ipv4> ipv4 = GetNode()->GetObject<Ipv4>();
+	if(ipv4 == 0)
+		return;
+	//interface 0 is the loopback
+	for(uint32_t i = 1; i < ipv4->GetNInterfaces(); i++) {
+		for(uint32_t j = 0; j < ipv4->GetNAddresses(i); j++) {
+			if(m_radioMonitor->GetRadioInfo(ipv4->GetAddress(i, j).GetLocal(), radio))
+				return;
+		}
+	}
+}
+
+void DashVideoPlayer::SetAbrTypeId(TypeId tid) {
+	m_abrFactory.SetTypeId(tid);
+}
+
+TypeId DashVideoPlayer::GetAbrTypeId(void) const {
+	return m_abrFactory.GetTypeId();
+}
+
 } /* namespace ns3 */
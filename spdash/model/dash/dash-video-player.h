@@ -12,6 +12,11 @@
 #include "ns3/application.h"
 
 #include "ns3/http-client-basic.h"
+#include "ns3/http-client-pool.h"
+#include "ns3/abr-algorithm.h"
+#include "ns3/sand-radio-monitor.h"
+#include "ns3/object-factory.h"
+#include <deque>
 
 
 namespace ns3 {
@@ -22,8 +27,6 @@ public:
 	static TypeId GetTypeId(void);
 	DashVideoPlayer();
 	virtual ~DashVideoPlayer();
-	std::string CreateRequestString( std::string cookie, std::string nextChunkId, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize);
-	int Abr( std::string cookie, std::string segmentNum, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize);
 
 
 private:
@@ -31,9 +34,36 @@ private:
 	virtual void StartApplication();
 	virtual void EndApplication();
 
-	int ReadInVideoInfo ();
 	void FinishedPlayback ();
 
+/********************************
+ *    In flight segments
+ ********************************/
+
+	/*
+	 * A segment request on the wire. Segments may complete out of order
+	 * over several connections, they are played in order. An aborted
+	 * request (timeout or abandonment) is sent again, m_reissue marks it
+	 * until then.
+	 */
+	struct SegmentRequest {
+		SegmentRequest(): m_segmentNum(0), m_quality(0), m_size(0), m_received(0),
+				m_done(false), m_reissue(false), m_resume(false), m_failed(false), m_attempts(0) {}
+		uint16_t m_segmentNum;
+		uint16_t m_quality;
+		uint64_t m_size;
+		uint64_t m_received;
+		Time m_startTime;
+		Time m_finishTime;
+		bool m_done;
+		bool m_reissue;
+		bool m_resume; //!< reissue asks only for the bytes not received yet
+		bool m_failed; //!< done without all its bytes, the session ends there
+		uint32_t m_attempts;
+		HttpTrace m_trace;
+		Ptr<HttpClientBasic> m_client;
+	};
+
 
 /********************************
  *   DASH state functions
@@ -41,14 +71,25 @@ private:
 	void StartDash(); //Should be called only once.
 	void Downloaded();
 	void DownloadedCB(Ptr<Object> obj);
+	void SegmentDownloadedCB(uint16_t segmentNum);
+	void SegmentDataReceived(uint16_t segmentNum, Ptr<const Packet> data);
+	void SegmentDownloaded();
+	void RequestSegment(SegmentRequest &segment, Ptr<HttpClientBasic> client);
+	void CheckAbandon();
 	void DashController();
-	void DownloadNextSegment();
+	void FillPipeline();
+	void QualitySelected(AbrDecision decision);
+	Time GetBufferLevel() const;
 	void AdjustVideoMetrices();
 
 	void LogTrace();
 
 	void LogABR();
 
+	void FillRadioInfo(AbrRadioInfo &radio);
+	void SetAbrTypeId(TypeId tid);
+	TypeId GetAbrTypeId(void) const;
+
 /********************************
  *    DASH state variable
  ********************************/
@@ -57,20 +98,36 @@ private:
 	Address m_serverAddress;
 	uint16_t m_serverPort;
 	std::string m_videoFilePath;
-	VideoData m_videoData;
+	const VideoData *m_videoData;
 	DashPlaybackStatus m_playback;
 	Ptr<HttpClientBasic> m_httpDownloader;
+	Ptr<HttpClientPool> m_clientPool;
+	std::deque<SegmentRequest> m_inFlight;
+	uint16_t m_nextSegmentNum;
+	bool m_abrPending;
+	EventId m_fillEvent;
+	uint32_t m_pipelineDepth;
+	uint32_t m_maxConnections;
+	bool m_multiplex;
+	TypeId m_socketFactory;
+	Time m_timeout;
+	bool m_abandon;
+	bool m_resume;
+	EventId m_abandonEvent;
 	std::vector<HttpTrace> m_httpTrace;
 	std::string m_tracePath;
 	Time m_lastIncident;
 
 	Time m_lastChunkStartTime;
 	Time m_lastChunkFinishTime;
-	std::string m_lastQuality;
-	std::string m_lastChunkSize;
+	uint16_t m_lastQuality;
+	uint64_t m_lastChunkSize;
 	std::string m_cookie;
 	Time m_totalRebuffer;
 	Time m_currentRebuffer;
+	ObjectFactory m_abrFactory;
+	Ptr<AbrAlgorithm> m_abr;
+	Ptr<SandRadioMonitor> m_radioMonitor;
 
 	Callback<void> m_onStartClient;
 	Callback<void> m_onStopClient;
@@ -0,0 +1,574 @@
+/*
+ * http-cache-proxy.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-cache-proxy.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include <sstream>
+#include <algorithm>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpCacheProxy");
+
+NS_OBJECT_ENSURE_REGISTERED(HttpCacheProxy);
+
+/*
+ * Fields that describe the connection or the part of the object the
+ * client wants, not the object itself. Server is also dropped, the
+ * proxy's header template names the proxy.
+ */
+static bool IsNotForwarded(std::string name) {
+	std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+	return name == "connection" || name == "range" || name == "content-length"
+			|| name == "server";
+}
+
+TypeId HttpCacheProxy::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpCacheProxy")
+			.SetParent<HttpServer>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpCacheProxy>()
+			.AddAttribute("OriginAddress",
+					"Address of the origin server",
+					AddressValue(),
+					MakeAddressAccessor(&HttpCacheProxy::m_originAddress),
+					MakeAddressChecker())
+			.AddAttribute("OriginPort",
+					"Port of the origin server",
+					UintegerValue(9),
+					MakeUintegerAccessor(&HttpCacheProxy::m_originPort),
+					MakeUintegerChecker<uint16_t>())
+			.AddAttribute("CacheTypeId",
+					"TypeId of the HttpSegmentCache, i.e. the eviction policy",
+					TypeIdValue(HttpLruCache::GetTypeId()),
+					MakeTypeIdAccessor(&HttpCacheProxy::m_cacheTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("CacheCapacity",
+					"Bytes of objects the cache keeps",
+					UintegerValue(100000000),
+					MakeUintegerAccessor(&HttpCacheProxy::m_cacheCapacity),
+					MakeUintegerChecker<uint64_t>())
+			.AddAttribute("OriginConnections",
+					"Connections to the origin, misses beyond that wait, 0 for no limit",
+					UintegerValue(0),
+					MakeUintegerAccessor(&HttpCacheProxy::m_originConnections),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute("OriginTimeout",
+					"An origin fetch not complete this long after it started fails, negative for never",
+					TimeValue(Seconds(-1)),
+					MakeTimeAccessor(&HttpCacheProxy::m_originTimeout),
+					MakeTimeChecker())
+			.AddAttribute("OriginSocketFactory",
+					"TypeId of the socket factory origin connections are opened with",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&HttpCacheProxy::m_originSocketFactory),
+					MakeTypeIdChecker())
+			.AddAttribute("RouterTypeId",
+					"TypeId of the HttpOriginRouter which spreads misses over the origins",
+					TypeIdValue(HttpRoundRobinRouter::GetTypeId()),
+					MakeTypeIdAccessor(&HttpCacheProxy::m_routerTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("Coalesce",
+					"Let a miss wait for a fetch of the same path in flight instead of fetching it again",
+					BooleanValue(true),
+					MakeBooleanAccessor(&HttpCacheProxy::m_coalesce),
+					MakeBooleanChecker())
+			.AddAttribute("StatsFile",
+					"Where to write the statistics of every object at stop, empty for none",
+					StringValue(""),
+					MakeStringAccessor(&HttpCacheProxy::m_statsFile),
+					MakeStringChecker());
+	return tid;
+}
+
+HttpCacheProxy::HttpCacheProxy(): m_originPort(0), m_cacheTypeId(HttpLruCache::GetTypeId()),
+		m_cacheCapacity(100000000), m_originConnections(0), m_originTimeout(Seconds(-1)),
+		m_originSocketFactory(TcpSocketFactory::GetTypeId()),
+		m_routerTypeId(HttpRoundRobinRouter::GetTypeId()), m_coalesce(true), m_nextFetchId(0),
+		m_hits(0), m_misses(0), m_coalesced(0), m_passedThrough(0), m_bytesServed(0), m_bytesFetched(0) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpCacheProxy::~HttpCacheProxy() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpCacheProxy::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	for(auto &it : m_fetches) {
+		it.second->m_waiting.clear(); //they refer back to their fetch
+	}
+	for(auto &it : m_queuedFetches) {
+		it->m_waiting.clear();
+	}
+	m_fetches.clear();
+	m_queuedFetches.clear();
+	m_fetchesByKey.clear();
+	m_clientPool = 0;
+	m_cache = 0;
+	m_router = 0;
+	HttpServer::DoDispose();
+}
+
+void HttpCacheProxy::DoInitialize(void) {
+	NS_LOG_FUNCTION(this);
+	SetReqHandlerFactoryTypeId(HttpCacheProxyRequestHandler::GetTypeId());
+	HttpServer::DoInitialize();
+	ObjectFactory cacheFactory;
+	cacheFactory.SetTypeId(m_cacheTypeId);
+	cacheFactory.Set("Capacity", UintegerValue(m_cacheCapacity));
+	m_cache = cacheFactory.Create<HttpSegmentCache>();
+
+	ObjectFactory routerFactory;
+	routerFactory.SetTypeId(m_routerTypeId);
+	m_router = routerFactory.Create<HttpOriginRouter>();
+	if(m_origins.empty())
+		m_origins.push_back(std::make_pair(m_originAddress, m_originPort));
+	for(auto &it : m_origins) {
+		m_router->AddOrigin(it.first, it.second);
+	}
+}
+
+void HttpCacheProxy::StartApplication(void) {
+	NS_LOG_FUNCTION(this);
+	m_clientPool = CreateObject<HttpClientPool>();
+	m_clientPool->SetAttribute("MaxConnections", UintegerValue(m_originConnections));
+	m_clientPool->SetAttribute("SocketFactory", TypeIdValue(m_originSocketFactory));
+	m_clientPool->SetNode(GetNode());
+	HttpServer::StartApplication();
+}
+
+void HttpCacheProxy::StopApplication(void) {
+	NS_LOG_FUNCTION(this);
+	HttpServer::StopApplication();
+	for(auto &it : m_queuedFetches) {
+		m_fetchesByKey.erase(it->m_key);
+	}
+	m_queuedFetches.clear();
+	if(m_clientPool != 0)
+		m_clientPool->StopAll();
+
+	NS_LOG_INFO("Cache " << m_cache->GetName() << ": hit ratio " << GetHitRatio()
+			<< ", origin offload " << GetOriginOffload() << ", " << m_cache->GetNumObjects()
+			<< " objects in " << m_cache->GetUsed() << " bytes, " << m_cache->GetNumEvictions()
+			<< " evictions, origin time saved " << m_latencySaved.GetSeconds() << "s, "
+			<< m_coalesced << " origin fetches saved by coalescing, "
+			<< m_passedThrough << " requests with a body passed through");
+	for(uint32_t i = 0; i < m_router->GetNumOrigins(); i++) {
+		const HttpOriginStats &stats = m_router->GetStats(i);
+		NS_LOG_INFO("Origin " << i << " (" << m_router->GetName() << "): " << stats.m_requests
+				<< " requests, " << stats.m_failed << " failed, at most " << stats.m_maxActive
+				<< " at a time, " << stats.m_bytes << " bytes, latency "
+				<< stats.m_latency.GetSeconds() << "s");
+	}
+	if(!m_statsFile.empty())
+		WriteStats();
+}
+
+void HttpCacheProxy::AddOrigin(const Address &address, uint16_t port) {
+	NS_LOG_FUNCTION(this << address << port);
+	NS_ASSERT_MSG(m_router == 0, "Origins have to be added before the proxy is initialized");
+	m_origins.push_back(std::make_pair(address, port));
+}
+
+Ptr<HttpSegmentCache> HttpCacheProxy::GetCache() const {
+	return m_cache;
+}
+
+Ptr<HttpOriginRouter> HttpCacheProxy::GetRouter() const {
+	return m_router;
+}
+
+double HttpCacheProxy::GetHitRatio() const {
+	if(!m_hits && !m_misses)
+		return 0;
+	return (double) m_hits / (m_hits + m_misses);
+}
+
+double HttpCacheProxy::GetOriginOffload() const {
+	if(!m_bytesServed)
+		return 0;
+	return std::max(0.0, 1 - (double) m_bytesFetched / m_bytesServed);
+}
+
+uint64_t HttpCacheProxy::GetOriginFetchesSaved() const {
+	return m_coalesced;
+}
+
+Time HttpCacheProxy::GetLatencySaved() const {
+	return m_latencySaved;
+}
+
+const std::map<std::string, HttpCacheObjectStats>& HttpCacheProxy::GetObjectStats() const {
+	return m_stats;
+}
+
+bool HttpCacheProxy::Lookup(const std::string &key, clen_t &size) {
+	NS_LOG_FUNCTION(this << key);
+	Time fetchTime;
+	if(!m_cache->Lookup(key, size, fetchTime))
+		return false;
+	HttpCacheObjectStats &stats = m_stats[key];
+	stats.m_hits++;
+	stats.m_latencySaved += fetchTime;
+	m_hits++;
+	m_latencySaved += fetchTime;
+	return true;
+}
+
+Ptr<HttpCacheFetch> HttpCacheProxy::Fetch(Ptr<HttpRequest> request,
+		Ptr<HttpCacheProxyRequestHandler> handler) {
+	NS_LOG_FUNCTION(this << request->GetPath());
+	m_stats[request->GetPath()].m_misses++;
+	m_misses++;
+	if(m_coalesce) {
+		auto it = m_fetchesByKey.find(request->GetPath());
+		if(it != m_fetchesByKey.end()) {
+			NS_LOG_LOGIC("Joining the fetch of " << it->first << " in flight");
+			it->second->m_waiting.push_back(handler);
+			m_stats[it->first].m_coalesced++;
+			m_coalesced++;
+			return it->second;
+		}
+	}
+
+	Ptr<HttpCacheFetch> fetch = NewFetch(request, handler);
+	if(m_coalesce)
+		m_fetchesByKey[fetch->m_key] = fetch;
+	QueueFetch(fetch);
+	return fetch;
+}
+
+/*
+ * The response depends on the body, so the request goes to the origin
+ * as it is, on behalf of client.
+ */
+Ptr<HttpCacheFetch> HttpCacheProxy::PassThrough(Ptr<HttpRequest> request, Ptr<Packet> body,
+		const Address &client, Ptr<HttpCacheProxyRequestHandler> handler) {
+	NS_LOG_FUNCTION(this << request->GetPath());
+	m_passedThrough++;
+	Ptr<HttpCacheFetch> fetch = NewFetch(request, handler);
+	fetch->m_passThrough = true;
+	fetch->m_size = 0; //from the origin's header, which brings the headers to pass back
+	fetch->m_body = body;
+	//a proxy in front of this one named the client already
+	if(request->GetHeader("X-Forwarded-For").empty() && InetSocketAddress::IsMatchingType(client)) {
+		std::ostringstream forwarded;
+		forwarded << InetSocketAddress::ConvertFrom(client).GetIpv4();
+		fetch->m_headers.push_back(std::make_pair("X-Forwarded-For", forwarded.str()));
+	}
+	QueueFetch(fetch);
+	return fetch;
+}
+
+Ptr<HttpCacheFetch> HttpCacheProxy::NewFetch(Ptr<HttpRequest> request,
+		Ptr<HttpCacheProxyRequestHandler> handler) {
+	Ptr<HttpCacheFetch> fetch = Create<HttpCacheFetch>();
+	fetch->m_id = m_nextFetchId++;
+	fetch->m_key = request->GetPath();
+	for(uint32_t i = 0; i < request->GetNumHeaders(); i++) {
+		std::string name = request->GetHeaderName(i);
+		if(!IsNotForwarded(name))
+			fetch->m_headers.push_back(std::make_pair(name, request->GetHeaderValue(i)));
+	}
+	request->GetHeaderNumber("X-Require-Length", fetch->m_size); //0 if malformed, the handler refused those
+	fetch->m_waiting.push_back(handler);
+	return fetch;
+}
+
+void HttpCacheProxy::QueueFetch(Ptr<HttpCacheFetch> fetch) {
+	if(!m_queuedFetches.empty() || !StartFetch(fetch))
+		m_queuedFetches.push_back(fetch);
+}
+
+void HttpCacheProxy::Served(const std::string &key, clen_t bytes) {
+	m_stats[key].m_bytesServed += bytes;
+	m_bytesServed += bytes;
+}
+
+/*
+ * False if every origin connection is busy.
+ */
+bool HttpCacheProxy::StartFetch(Ptr<HttpCacheFetch> fetch) {
+	NS_LOG_FUNCTION(this << fetch->m_key);
+	uint32_t origin = m_router->Select(fetch->m_key);
+	const Address &address = m_router->GetOriginAddress(origin);
+	uint16_t port = m_router->GetOriginPort(origin);
+	Ptr<HttpClientBasic> client = m_clientPool->Acquire(address, port);
+	if(client == 0)
+		return false;
+	fetch->m_origin = origin;
+	fetch->m_client = client;
+	fetch->m_startedAt = Simulator::Now();
+	m_fetches[fetch->m_id] = fetch;
+	m_router->RequestStarted(origin);
+
+	client->SetCollectionCB(MakeCallback(&HttpCacheProxy::FetchDoneCB, this).Bind(fetch->m_id), GetNode());
+	client->SetBodySink(MakeCallback(&HttpCacheProxy::FetchDataCB, this).Bind(fetch->m_id));
+	client->SetTimeout(m_originTimeout);
+	client->InitConnection(address, port, fetch->m_key);
+	for(auto &it : fetch->m_headers) {
+		client->AddReqHeader(it.first, it.second);
+	}
+	if(fetch->m_body != 0)
+		client->SetReqBody(fetch->m_body->Copy()); //kept for a retry on another connection
+	client->Connect();
+	return true;
+}
+
+/*
+ * Once the origin's response header is in: the headers the client is
+ * to get and the size, so that the body is relayed while it arrives.
+ */
+static void TakeResponseHeaders(Ptr<HttpCacheFetch> fetch) {
+	const Ptr<HttpResponse> &response = fetch->m_client->GetResponse();
+	if(response == 0 || !fetch->m_responseHeaders.empty())
+		return;
+	for(uint32_t i = 0; i < response->GetNumHeaders(); i++) {
+		std::string name = response->GetHeaderName(i);
+		if(!IsNotForwarded(name))
+			fetch->m_responseHeaders.push_back(std::make_pair(name, response->GetHeaderValue(i)));
+	}
+	if(!fetch->m_size)
+		fetch->m_size = response->GetContentLength();
+}
+
+void HttpCacheProxy::FetchDataCB(uint32_t id, Ptr<const Packet> data) {
+	auto it = m_fetches.find(id);
+	if(it == m_fetches.end())
+		return;
+	Ptr<HttpCacheFetch> fetch = it->second;
+	if(!fetch->m_received) {
+		fetch->m_firstByteAt = Simulator::Now();
+		if(fetch->m_passThrough)
+			TakeResponseHeaders(fetch);
+	}
+	fetch->m_received += data->GetSize();
+	m_stats[fetch->m_key].m_bytesFetched += data->GetSize();
+	m_bytesFetched += data->GetSize();
+	for(auto &handler : fetch->m_waiting) {
+		handler->FetchProgress();
+	}
+}
+
+void HttpCacheProxy::FetchDoneCB(uint32_t id) {
+	NS_LOG_FUNCTION(this << id);
+	auto it = m_fetches.find(id);
+	if(it == m_fetches.end())
+		return;
+	Ptr<HttpCacheFetch> fetch = it->second;
+	fetch->m_failed = fetch->m_client->WasAborted();
+	if(!fetch->m_failed) {
+		const Ptr<HttpResponse> &response = fetch->m_client->GetResponse();
+		fetch->m_statusCode = response->GetStatusCode();
+		fetch->m_statusText = response->GetStatusText();
+		fetch->m_failed = fetch->m_statusCode != 200;
+		if(fetch->m_passThrough && !fetch->m_received)
+			TakeResponseHeaders(fetch); //empty body
+	}
+	Simulator::ScheduleNow(&HttpCacheProxy::FetchDone, this, id);
+}
+
+void HttpCacheProxy::FetchDone(uint32_t id) {
+	NS_LOG_FUNCTION(this << id);
+	auto it = m_fetches.find(id);
+	if(it == m_fetches.end())
+		return;
+	Ptr<HttpCacheFetch> fetch = it->second;
+	m_fetches.erase(it);
+	auto byKey = m_fetchesByKey.find(fetch->m_key);
+	if(byKey != m_fetchesByKey.end() && byKey->second == fetch)
+		m_fetchesByKey.erase(byKey); //later misses fetch it again, or hit
+	if(m_clientPool != 0)
+		m_clientPool->Release(fetch->m_client);
+	fetch->m_client = 0;
+	fetch->m_done = true;
+	Time latency = (fetch->m_received ? fetch->m_firstByteAt : Simulator::Now()) - fetch->m_startedAt;
+	m_router->RequestDone(fetch->m_origin, latency, fetch->m_received, fetch->m_failed);
+	if(!fetch->m_failed && !fetch->m_passThrough)
+		m_cache->Insert(fetch->m_key, fetch->m_received, Simulator::Now() - fetch->m_startedAt);
+	else
+		NS_LOG_INFO("Fetching " << fetch->m_key << " from the origin failed");
+
+	std::vector<Ptr<HttpCacheProxyRequestHandler> > waiting;
+	waiting.swap(fetch->m_waiting);
+	for(auto &handler : waiting) {
+		handler->FetchDone();
+	}
+
+	while(!m_queuedFetches.empty() && StartFetch(m_queuedFetches.front())) {
+		m_queuedFetches.pop_front();
+	}
+}
+
+/*
+ * One line per object: path, hits, misses, misses coalesced into a
+ * fetch in flight, bytes served, bytes fetched from the origin and the
+ * origin time its hits saved in seconds.
+ */
+void HttpCacheProxy::WriteStats() const {
+	NS_LOG_FUNCTION(this);
+	std::ofstream outFile(m_statsFile.c_str(), std::ofstream::out | std::ofstream::trunc);
+	if(!outFile.is_open()) {
+		NS_LOG_ERROR("Cannot write " << m_statsFile);
+		return;
+	}
+	outFile << "path hits misses coalesced served fetched saved\n";
+	for(auto &it : m_stats) {
+		outFile << it.first << " " << it.second.m_hits << " " << it.second.m_misses << " "
+				<< it.second.m_coalesced << " "
+				<< it.second.m_bytesServed << " " << it.second.m_bytesFetched << " "
+				<< it.second.m_latencySaved.GetSeconds() << "\n";
+	}
+}
+
+/**************************************************
+ *          Http Cache Proxy Request Handler      *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpCacheProxyRequestHandler);
+
+TypeId HttpCacheProxyRequestHandler::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpCacheProxyRequestHandler")
+			.SetParent<HttpServerBaseRequestHandler>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpCacheProxyRequestHandler>();
+	return tid;
+}
+
+HttpCacheProxyRequestHandler::HttpCacheProxyRequestHandler(): m_total(0), m_first(0), m_sent(0),
+		m_bodyStarted(false) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpCacheProxyRequestHandler::~HttpCacheProxyRequestHandler() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpCacheProxyRequestHandler::Reset() {
+	HttpServerBaseRequestHandler::Reset();
+	m_fetch = 0;
+	m_total = 0;
+	m_first = 0;
+	m_sent = 0;
+	m_bodyStarted = false;
+}
+
+void HttpCacheProxyRequestHandler::RequestHeaderReceived() {
+	NS_LOG_FUNCTION(this);
+	HttpCacheProxy *proxy = dynamic_cast<HttpCacheProxy *>(GetServer());
+	NS_ASSERT_MSG(proxy, "HttpCacheProxyRequestHandler only works in an HttpCacheProxy");
+	if(GetRequest()->GetContentLength() > 0) {
+		//passed through once the whole body is in
+		if(IsRequestComplete())
+			PassThrough();
+		return;
+	}
+	clen_t size = 0;
+	if(!GetRequest()->GetHeaderNumber("X-Require-Length", size)) {
+		NS_LOG_WARN("Malformed X-Require-Length " << GetHeader("X-Require-Length"));
+		SetClen(0);
+		SetStatus(400, "Bad Request");
+		EndHeader();
+		return;
+	}
+	if(proxy->Lookup(GetPath(), size)) {
+		StartBody(size);
+		return;
+	}
+	m_fetch = proxy->Fetch(GetRequest(), this);
+	if(m_fetch->m_size)
+		StartBody(m_fetch->m_size); //relayed while it arrives
+}
+
+void HttpCacheProxyRequestHandler::RequestDataReceived() {
+	NS_LOG_FUNCTION(this);
+	if(IsRequestComplete() && m_fetch == 0)
+		PassThrough();
+}
+
+void HttpCacheProxyRequestHandler::PassThrough() {
+	NS_LOG_FUNCTION(this);
+	HttpCacheProxy *proxy = dynamic_cast<HttpCacheProxy *>(GetServer());
+	Address client;
+	GetSocket()->GetPeerName(client);
+	m_fetch = proxy->PassThrough(GetRequest(), GetRequestBody(), client, this);
+	if(m_fetch->m_size)
+		StartBody(m_fetch->m_size);
+}
+
+void HttpCacheProxyRequestHandler::StartBody(clen_t total) {
+	NS_LOG_FUNCTION(this << total);
+	if(m_fetch != 0) {
+		for(auto &it : m_fetch->m_responseHeaders) {
+			AddHeader(it.first, it.second);
+		}
+	}
+	m_total = total;
+	m_first = SelectRange(total);
+	m_sent = 0;
+	m_bodyStarted = true;
+	dynamic_cast<HttpCacheProxy *>(GetServer())->Served(GetPath(), GetClen());
+	EndHeader();
+}
+
+void HttpCacheProxyRequestHandler::ReadyToSend(uint32_t txSpace) {
+	NS_LOG_FUNCTION(this);
+	if(m_sent == GetClen()) {
+		EndResponse();
+		return;
+	}
+	clen_t available = m_fetch == 0 ? m_total : m_fetch->m_received;
+	clen_t from = m_first + m_sent;
+	clen_t upto = std::min(available, m_first + GetClen());
+	if(upto <= from)
+		return; //FetchProgress() resumes
+	uint32_t toBeSent = std::min((clen_t) txSpace, upto - from);
+	m_sent += SendVirtual(toBeSent);
+}
+
+void HttpCacheProxyRequestHandler::FetchProgress() {
+	if(m_bodyStarted)
+		ResumeSend();
+	else if(m_fetch->m_passThrough && m_fetch->m_size)
+		StartBody(m_fetch->m_size); //the origin's header is in
+}
+
+void HttpCacheProxyRequestHandler::FetchDone() {
+	NS_LOG_FUNCTION(this);
+	if(!IsRunning())
+		return;
+	if(!m_bodyStarted) {
+		if(!m_fetch->m_failed) {
+			StartBody(m_fetch->m_received);
+			return;
+		}
+		if(m_fetch->m_statusCode)
+			SetStatus(m_fetch->m_statusCode, m_fetch->m_statusText);
+		else
+			SetStatus(502, "Bad Gateway");
+		SetClen(0);
+		EndHeader();
+		return;
+	}
+	if(m_fetch->m_received < m_first + GetClen()) {
+		NS_LOG_INFO("Origin sent less than announced, closing the connection");
+		AbortResponse();
+		return;
+	}
+	ResumeSend();
+}
+
+} /* namespace ns3 */
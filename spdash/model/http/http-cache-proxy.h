@@ -0,0 +1,202 @@
+/*
+ * http-cache-proxy.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_CACHE_PROXY_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_CACHE_PROXY_H_
+
+#include "http-server.h"
+#include "http-segment-cache.h"
+#include "http-client-pool.h"
+#include "http-origin-router.h"
+#include "ns3/simple-ref-count.h"
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+class HttpCacheProxyRequestHandler;
+
+/*
+ * \brief One request of an HttpCacheProxy to its origin, always for the
+ *        whole object. The handlers waiting for it are told as body
+ *        bytes arrive and once it is complete.
+ */
+class HttpCacheFetch: public SimpleRefCount<HttpCacheFetch> {
+public:
+	HttpCacheFetch(): m_id(0), m_origin(0), m_size(0), m_received(0), m_done(false),
+			m_failed(false), m_passThrough(false), m_statusCode(0) {}
+
+	uint32_t m_id;
+	uint32_t m_origin; //!< index at the router
+	std::string m_key;
+	std::vector<std::pair<std::string, std::string> > m_headers; //!< forwarded to the origin
+	Ptr<Packet> m_body; //!< request body forwarded to the origin, 0 if none
+	std::vector<std::pair<std::string, std::string> > m_responseHeaders; //!< of the origin, passed back if m_passThrough
+	clen_t m_size; //!< announced in X-Require-Length, 0 if only known once complete
+	clen_t m_received;
+	bool m_done;
+	bool m_failed; //!< aborted, timed out or not a 200
+	bool m_passThrough; //!< request with a body: neither cached nor coalesced
+	uint16_t m_statusCode;
+	std::string m_statusText;
+	Time m_startedAt;
+	Time m_firstByteAt;
+	Ptr<HttpClientBasic> m_client;
+	std::vector<Ptr<HttpCacheProxyRequestHandler> > m_waiting;
+};
+
+/*
+ * \brief Hits, misses and bytes of one object at an HttpCacheProxy.
+ */
+struct HttpCacheObjectStats {
+	HttpCacheObjectStats(): m_hits(0), m_misses(0), m_coalesced(0), m_bytesServed(0),
+			m_bytesFetched(0) {}
+	uint64_t m_hits;
+	uint64_t m_misses;
+	uint64_t m_coalesced; //!< misses that joined a fetch in flight
+	uint64_t m_bytesServed; //!< to clients
+	uint64_t m_bytesFetched; //!< from the origin
+	Time m_latencySaved; //!< origin fetch time of every hit
+};
+
+/*
+ * \brief Caching http proxy, e.g. on the pgw or a MEC node between the
+ *        UEs and the remote host. Requests are keyed by path. A hit is
+ *        served from the HttpSegmentCache (CacheTypeId picks the
+ *        eviction policy), a miss is fetched from the origin over
+ *        keep-alive connections, with the request headers except
+ *        Connection and Range, and stored once complete. A miss whose
+ *        size the client announced in X-Require-Length is relayed while
+ *        it arrives, otherwise after it completed. Ranges are cut out of
+ *        the whole object.
+ *
+ *        Bodies are synthetic like everywhere in this module: the cache
+ *        keeps sizes, not bytes. The hit ratio, the share of bytes that
+ *        did not come from the origin (offload) and the origin time the
+ *        hits saved are logged at stop and, per object, written to
+ *        StatsFile.
+ *
+ *        With AddOrigin() misses are spread over several origins by an
+ *        HttpOriginRouter, RouterTypeId picks the policy; the router
+ *        keeps the load of every origin. Without, OriginAddress and
+ *        OriginPort are the only origin. A CacheCapacity of 0 caches
+ *        nothing, which leaves a plain layer 7 load balancer.
+ *
+ *        With Coalesce, a miss for a path that is being fetched already
+ *        does not go to the origin again but waits for the same fetch,
+ *        and is relayed from it as it arrives. Flash crowds of players
+ *        asking for the same segment then cost one origin request. Only
+ *        the first request's headers reach the origin, so this suits
+ *        responses that depend on the path alone.
+ *
+ *        A request with a body (e.g. a SpDash segment request carrying
+ *        the abr state) is answered per client: once the body arrived it
+ *        is passed through to the origin, body and byte tags included,
+ *        with X-Forwarded-For naming the client. It is neither looked
+ *        up, cached nor coalesced, and the origin's response headers
+ *        (e.g. X-LastQuality, X-Cookie) are passed back.
+ */
+class HttpCacheProxy: public HttpServer {
+public:
+	static TypeId GetTypeId(void);
+	HttpCacheProxy();
+	virtual ~HttpCacheProxy();
+
+	void AddOrigin(const Address &address, uint16_t port);
+	Ptr<HttpSegmentCache> GetCache() const;
+	Ptr<HttpOriginRouter> GetRouter() const;
+	double GetHitRatio() const;
+	double GetOriginOffload() const; ///< share of bytes served that did not come from the origin
+	uint64_t GetOriginFetchesSaved() const; ///< misses coalesced into a fetch in flight
+	uint64_t GetNumPassedThrough() const { return m_passedThrough; } ///< requests with a body
+	Time GetLatencySaved() const;
+	const std::map<std::string, HttpCacheObjectStats>& GetObjectStats() const;
+
+protected:
+	virtual void DoDispose(void);
+	virtual void DoInitialize(void);
+	virtual void StartApplication(void);
+	virtual void StopApplication(void);
+
+private:
+	bool Lookup(const std::string &key, clen_t &size);
+	Ptr<HttpCacheFetch> Fetch(Ptr<HttpRequest> request, Ptr<HttpCacheProxyRequestHandler> handler);
+	Ptr<HttpCacheFetch> PassThrough(Ptr<HttpRequest> request, Ptr<Packet> body, const Address &client,
+			Ptr<HttpCacheProxyRequestHandler> handler);
+	Ptr<HttpCacheFetch> NewFetch(Ptr<HttpRequest> request, Ptr<HttpCacheProxyRequestHandler> handler);
+	void QueueFetch(Ptr<HttpCacheFetch> fetch);
+	void Served(const std::string &key, clen_t bytes);
+	bool StartFetch(Ptr<HttpCacheFetch> fetch);
+	void FetchDataCB(uint32_t id, Ptr<const Packet> data);
+	void FetchDoneCB(uint32_t id);
+	void FetchDone(uint32_t id);
+	void WriteStats() const;
+
+	Address m_originAddress;
+	uint16_t m_originPort;
+	TypeId m_cacheTypeId;
+	uint64_t m_cacheCapacity;
+	uint32_t m_originConnections;
+	Time m_originTimeout;
+	TypeId m_originSocketFactory;
+	TypeId m_routerTypeId;
+	std::string m_statsFile;
+	bool m_coalesce;
+	std::vector<std::pair<Address, uint16_t> > m_origins; //!< from AddOrigin()
+
+	Ptr<HttpSegmentCache> m_cache;
+	Ptr<HttpOriginRouter> m_router;
+	Ptr<HttpClientPool> m_clientPool;
+	uint32_t m_nextFetchId;
+	std::map<uint32_t, Ptr<HttpCacheFetch> > m_fetches; //!< started, by id
+	std::deque<Ptr<HttpCacheFetch> > m_queuedFetches; //!< waiting for an origin connection
+	std::map<std::string, Ptr<HttpCacheFetch> > m_fetchesByKey; //!< started or queued, for Coalesce
+	std::map<std::string, HttpCacheObjectStats> m_stats;
+	uint64_t m_hits;
+	uint64_t m_misses;
+	uint64_t m_coalesced;
+	uint64_t m_passedThrough;
+	uint64_t m_bytesServed;
+	uint64_t m_bytesFetched;
+	Time m_latencySaved;
+
+	friend class HttpCacheProxyRequestHandler;
+};
+
+/*
+ * \brief Request handler of an HttpCacheProxy, installed by it.
+ */
+class HttpCacheProxyRequestHandler: public HttpServerBaseRequestHandler {
+public:
+	static TypeId GetTypeId(void);
+	HttpCacheProxyRequestHandler();
+	virtual ~HttpCacheProxyRequestHandler();
+
+	void FetchProgress(); ///< more of the object arrived
+	void FetchDone();
+
+protected:
+	virtual void Reset();
+	virtual void RequestHeaderReceived();
+	virtual void RequestDataReceived();
+	virtual void ReadyToSend(uint32_t txSpace);
+
+private:
+	void PassThrough();
+	void StartBody(clen_t total);
+
+	Ptr<HttpCacheFetch> m_fetch; //!< 0 for a hit
+	clen_t m_total; //!< size of the whole object
+	clen_t m_first; //!< first byte of the object sent
+	clen_t m_sent;
+	bool m_bodyStarted;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_CACHE_PROXY_H_ */
@@ -10,9 +10,12 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/tcp-socket.h"
+#include "ns3/tcp-socket-factory.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 NS_LOG_COMPONENT_DEFINE("HttpClientBasic");
@@ -24,21 +27,54 @@ TypeId HttpClientBasic::GetTypeId(void) {
 	static TypeId tid = TypeId("ns3::HttpClientBasic")
 				.SetParent<Application>()
 				.SetGroupName("Applications")
-				.AddConstructor<HttpClientBasic>();
+				.AddConstructor<HttpClientBasic>()
+				.AddAttribute("KeepAlive",
+						"Keep the connection open for the next request",
+						BooleanValue(true),
+						MakeBooleanAccessor(&HttpClientBasic::m_keepAlive),
+						MakeBooleanChecker())
+				.AddAttribute("Timeout",
+						"Time a request may take from Connect() to the end of the response, negative disables",
+						TimeValue(Seconds(-1)),
+						MakeTimeAccessor(&HttpClientBasic::m_timeout),
+						MakeTimeChecker())
+				.AddAttribute("SocketFactory",
+						"TypeId of the socket factory the connection is opened with, e.g. ns3::RudpSocketFactory",
+						TypeIdValue(TcpSocketFactory::GetTypeId()),
+						MakeTypeIdAccessor(&HttpClientBasic::m_socketFactory),
+						MakeTypeIdChecker())
+				.AddAttribute("Priority",
+						"Priority of the stream when multiplexed, lower is more urgent",
+						UintegerValue(16),
+						MakeUintegerAccessor(&HttpClientBasic::m_priority),
+						MakeUintegerChecker<uint8_t>())
+				.AddAttribute("TraceResolution",
+						"Minimum time between two samples of the download trace, 0 keeps every receive",
+						TimeValue(Time(0)),
+						MakeTimeAccessor(&HttpClientBasic::m_traceResolution),
+						MakeTimeChecker())
+				.AddAttribute("TraceGranularity",
+						"Minimum bytes between two samples of the download trace, 0 keeps every receive",
+						UintegerValue(0),
+						MakeUintegerAccessor(&HttpClientBasic::m_traceGranularity),
+						MakeUintegerChecker<uint64_t>());
 	return tid;
 }
 
-HttpClientBasic::HttpClientBasic(): m_peerPort(0) {
+HttpClientBasic::HttpClientBasic(): m_peerPort(0), m_keepAlive(true),
+		m_connected(false), m_aborted(false), m_timedOut(false), m_timeout(Seconds(-1)),
+		m_priority(16), m_socketFactory(TcpSocketFactory::GetTypeId()), m_traceGranularity(0) {
 	m_method = "GET";
 	m_path = "/";
 }
 
 HttpClientBasic::~HttpClientBasic() {
+	m_timeoutEvent.Cancel();
 }
 
 
 
-void HttpClientBasic::RecvResponseData(uint8_t *data, uint32_t len) {
+void HttpClientBasic::RecvResponseData(Ptr<const Packet> data) {
 }
 
 void HttpClientBasic::RecvResponseHeader() {
@@ -47,6 +83,10 @@ void HttpClientBasic::RecvResponseHeader() {
 
 void HttpClientBasic::InitConnection(Address peerAddress, uint16_t peerPort, std::string path) {
 	NS_LOG_FUNCTION(this);
+	if(m_socket != 0 && !IsConnectedTo(peerAddress, peerPort)) {
+		NS_ASSERT(m_exchanges.empty());
+		CloseSocket();
+	}
 	m_peerAddress = peerAddress;
 	m_peerPort = peerPort;
 	m_path = path;
@@ -56,8 +96,9 @@ void HttpClientBasic::InitConnection(Address peerAddress, uint16_t peerPort, std
 void HttpClientBasic::InitConnection(std::string path) {
 	NS_LOG_FUNCTION(this);
 
-	if(m_socket != 0){
-		m_socket = 0;
+	if(m_socket != 0 && !m_keepAlive){
+		NS_ASSERT(m_exchanges.empty());
+		CloseSocket();
 	}
 
 	if(path.length() != 0) {
@@ -65,14 +106,66 @@ void HttpClientBasic::InitConnection(std::string path) {
 	}
 
 	m_request = Create<HttpRequest>(m_method, m_path, "http1.1");
-	m_response = Create<HttpResponse>();
+	m_request->AddHeader("Connection", m_keepAlive ? "keep-alive" : "close");
+	m_reqBody = 0;
+}
+
+void HttpClientBasic::SetReqBody(const std::string &body) {
+	SetReqBody(Create<Packet>((const uint8_t *)body.data(), body.size()));
+}
 
+void HttpClientBasic::SetReqBody(Ptr<Packet> body) {
+	NS_ASSERT(m_request != 0);
+	m_reqBody = body->GetSize() ? body : Ptr<Packet>();
 }
 
 void HttpClientBasic::Connect() {
-	m_trace = HttpTrace();
-	TypeId tid = TypeId::LookupByName("ns3::TcpSocketFactory");
-	m_socket = Socket::CreateSocket(m_node, tid);
+	NS_LOG_FUNCTION(this);
+	NS_ASSERT(m_request != 0);
+	NS_ASSERT(m_keepAlive || m_exchanges.empty());
+
+	HttpExchange exchange;
+	exchange.m_request = m_request;
+	exchange.m_response = Create<HttpResponse>();
+	exchange.m_onComplete = m_onConnectionClosed;
+	exchange.m_bodySink = m_bodySink;
+	exchange.m_trace.SetDecimation(m_traceResolution, m_traceGranularity);
+	if(!m_timeout.IsNegative())
+		exchange.m_deadline = Simulator::Now() + m_timeout;
+	if(m_reqBody != 0)
+		m_request->AddHeader("Content-Length", std::to_string(m_reqBody->GetSize()));
+	uint8_t buf[2048];
+	uint32_t len;
+	while((len = m_request->ReadHeader(buf, sizeof(buf))) > 0) {
+		exchange.m_wire.append((char *)buf, len);
+	}
+	exchange.m_body = m_reqBody;
+	m_reqBody = 0;
+	m_exchanges.push_back(std::move(exchange));
+	m_request = 0;
+	if(m_exchanges.size() == 1)
+		ArmTimeout();
+
+	if(m_socket == 0) {
+		OpenSocket();
+	}
+	else if(m_connected) {
+		NS_LOG_LOGIC("Reusing connection, " << m_exchanges.size() << " in flight");
+		SendPending();
+	}
+	//still connecting, EvConnectionSucceeded sends it
+}
+
+void HttpClientBasic::OpenSocket() {
+	NS_LOG_FUNCTION(this);
+	if(m_mux != 0) {
+		Ptr<HttpMuxStream> stream = m_mux->OpenStream();
+		stream->SetPriority(m_priority);
+		m_socket = stream;
+	} else {
+		m_socket = Socket::CreateSocket(m_node, m_socketFactory);
+	}
+	m_connected = false;
 
 	m_socket->SetConnectCallback(
 			MakeCallback(&HttpClientBasic::EvConnectionSucceeded, this),
@@ -93,22 +186,110 @@ void HttpClientBasic::Connect() {
 	}
 }
 
+void HttpClientBasic::SendPending() {
+	NS_LOG_FUNCTION(this);
+	for(auto &exchange : m_exchanges) {
+		uint32_t wireLen = exchange.m_wire.size();
+		uint32_t total = wireLen + (exchange.m_body != 0 ? exchange.m_body->GetSize() : 0);
+		while(exchange.m_sent < total) {
+			uint32_t toSend = std::min(m_socket->GetTxAvailable(), total - exchange.m_sent);
+			if(toSend == 0)
+				return;
+			if(exchange.m_sent == 0)
+				exchange.m_trace.RequestSent();
+			int sent;
+			if(exchange.m_sent < wireLen) {
+				toSend = std::min(toSend, wireLen - exchange.m_sent);
+				sent = m_socket->Send((const uint8_t *)exchange.m_wire.data() + exchange.m_sent, toSend, 0);
+			} else {
+				sent = m_socket->Send(exchange.m_body->CreateFragment(exchange.m_sent - wireLen, toSend));
+			}
+			if(sent <= 0)
+				return;
+			exchange.m_sent += sent;
+			if((uint32_t)sent < toSend)
+				return; //wait for the next send callback
+		}
+	}
+}
+
 void HttpClientBasic::StopConnection() {
+	NS_LOG_FUNCTION(this);
+	Abort();
+}
+
+void HttpClientBasic::Abort() {
+	NS_LOG_FUNCTION(this);
 	if(m_socket) {
-		m_socket->SetConnectCallback(
-				MakeNullCallback<void, Ptr<Socket> >(),
-				MakeNullCallback<void, Ptr<Socket> >());
-		m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
-		m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t >());
-		m_socket->SetCloseCallbacks(
-				MakeNullCallback<void, Ptr<Socket> >(),
-				MakeNullCallback<void, Ptr<Socket> >());
-		m_socket->Close();
+		CloseSocket();
 	}
-	EndConnection();
+	FailPending();
 }
 
+void HttpClientBasic::SetTimeout(Time timeout) {
+	m_timeout = timeout;
+}
+
+void HttpClientBasic::SetMux(Ptr<HttpMuxConnection> mux) {
+	NS_ASSERT(m_socket == 0);
+	m_mux = mux;
+}
+
+void HttpClientBasic::SetPriority(uint8_t priority) {
+	m_priority = priority;
+	Ptr<HttpMuxStream> stream = DynamicCast<HttpMuxStream>(m_socket);
+	if(stream != 0)
+		stream->SetPriority(priority);
+}
+
+/*
+ * Requests are answered in order, so only the oldest one can be late.
+ */
+void HttpClientBasic::ArmTimeout() {
+	m_timeoutEvent.Cancel();
+	if(m_exchanges.empty() || m_exchanges.front().m_deadline.IsNegative())
+		return;
+	Time left = std::max(m_exchanges.front().m_deadline - Simulator::Now(), Time(0));
+	m_timeoutEvent = Simulator::Schedule(left, &HttpClientBasic::EvTimeout, this);
+}
+
+void HttpClientBasic::EvTimeout() {
+	NS_LOG_FUNCTION(this);
+	NS_LOG_INFO("Request timed out after " << m_timeout);
+	if(m_socket) {
+		CloseSocket();
+	}
+	m_exchanges.front().m_aborted = true;
+	m_exchanges.front().m_timedOut = true;
+	ResponseComplete(); //the rest is sent again on a new connection
+}
 
+void HttpClientBasic::CloseSocket() {
+	NS_LOG_FUNCTION(this);
+	m_socket->SetConnectCallback(
+			MakeNullCallback<void, Ptr<Socket> >(),
+			MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t >());
+	m_socket->SetCloseCallbacks(
+			MakeNullCallback<void, Ptr<Socket> >(),
+			MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->Close();
+	m_socket = 0;
+	m_connected = false;
+}
+
+bool HttpClientBasic::IsIdle() const {
+	return m_socket != 0 && m_connected && m_exchanges.empty();
+}
+
+uint32_t HttpClientBasic::GetNumPending() const {
+	return m_exchanges.size();
+}
+
+bool HttpClientBasic::IsConnectedTo(const Address &peerAddress, uint16_t peerPort) const {
+	return m_socket != 0 && m_peerAddress == peerAddress && m_peerPort == peerPort;
+}
 
 void HttpClientBasic::SetCollectionCB(Callback<void> onConnectionClosed, Ptr<Node> node) {
 	m_onConnectionClosed = onConnectionClosed;
@@ -116,15 +297,71 @@ void HttpClientBasic::SetCollectionCB(Callback<void> onConnectionClosed, Ptr<Nod
 	m_node = node;
 }
 
+void HttpClientBasic::SetBodySink(Callback<void, Ptr<const Packet> > sink) {
+	m_bodySink = sink;
+}
+
 void HttpClientBasic::AddReqHeader(std::string name, std::string value) {
 	m_request->AddHeader(name, value);
 }
 
-void HttpClientBasic::EndConnection() {
+void HttpClientBasic::SetReqRange(clen_t first, clen_t last) {
+	m_request->SetRange(first, last);
+}
+
+/*
+ * Completes the oldest exchange. Its callback may queue new requests, so
+ * the exchange is taken out of the queue before it runs.
+ */
+void HttpClientBasic::ResponseComplete() {
+	NS_LOG_FUNCTION(this);
+	HttpExchange exchange = std::move(m_exchanges.front());
+	m_exchanges.pop_front();
+	m_response = exchange.m_response;
+	m_trace = std::move(exchange.m_trace);
+	m_timedOut = exchange.m_timedOut;
+	m_aborted = exchange.m_aborted || !m_response->IsHeaderReceived()
+			|| (m_response->HasHeader("Content-Length") && exchange.m_bodyLeft > 0);
+	if(m_socket != 0 && (!m_keepAlive || !m_response->IsKeepAlive())) {
+		CloseSocket();
+	}
+	if(m_socket == 0 && !m_exchanges.empty()) {
+		RetryPending();
+	}
+	ArmTimeout();
 //	std::cout << m_trace.m_reqSentAt << " " << m_trace.m_firstByteAt << " " << m_trace.m_lastByteAt << std::endl;
-	if(!m_onConnectionClosed.IsNull()){
+	if(!exchange.m_onComplete.IsNull()){
 //		Simulator::ScheduleNow(m_onConnectionClosed, m_collectionBlob);
-		m_onConnectionClosed();
+		exchange.m_onComplete();
+	}
+}
+
+void HttpClientBasic::RetryPending() {
+	NS_LOG_FUNCTION(this << m_exchanges.size());
+	for(auto &exchange : m_exchanges) {
+		exchange.m_sent = 0;
+		exchange.m_bodyLeft = 0;
+		exchange.m_retried = true;
+		exchange.m_response = Create<HttpResponse>();
+		exchange.m_trace = HttpTrace();
+		exchange.m_trace.SetDecimation(m_traceResolution, m_traceGranularity);
+	}
+	OpenSocket();
+}
+
+void HttpClientBasic::FailPending() {
+	NS_LOG_FUNCTION(this << m_exchanges.size());
+	std::deque<HttpExchange> failed;
+	std::swap(failed, m_exchanges);
+	m_timeoutEvent.Cancel();
+	for(auto &exchange : failed) {
+		m_response = exchange.m_response;
+		m_trace = std::move(exchange.m_trace);
+		m_aborted = true;
+		m_timedOut = false;
+		if(!exchange.m_onComplete.IsNull()) {
+			exchange.m_onComplete();
+		}
 	}
 }
 
@@ -137,113 +374,120 @@ const HttpTrace& HttpClientBasic::GetTrace() const {
 	return m_trace;
 }
 
+bool HttpClientBasic::WasAborted() const {
+	return m_aborted;
+}
+
+bool HttpClientBasic::WasTimedOut() const {
+	return m_timedOut;
+}
+
+HttpTrace HttpClientBasic::TakeTrace() {
+	return std::move(m_trace);
+}
+
 
 
 //===================
 void HttpClientBasic::EvConnectionFailed(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
 	NS_LOG_LOGIC("Http Client connection failed");
-	EndConnection();
+	m_socket = 0;
+	m_connected = false;
+	FailPending();
 }
 
 void HttpClientBasic::EvConnectionSucceeded(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
-	EvHandleSend(socket, socket->GetTxAvailable());
+	m_connected = true;
+	SendPending();
 }
 
 void HttpClientBasic::EvErrorClosed(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
 	NS_LOG_LOGIC("Http Client connection error closed");
 //	std::cout << "Error Closed" << std::endl;
+	EvSocketClosed(socket);
 }
 
 void HttpClientBasic::EvHandleRecv(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
 
-	uint32_t rxAvailable = m_socket->GetRxAvailable();
-	if(rxAvailable == 0) return;
-
-	uint8_t *buf = new uint8_t[rxAvailable];
-	uint32_t rlen = m_socket->Recv(buf, rxAvailable, 0);
-	NS_ASSERT(rxAvailable == rlen);
-	m_trace.ResponseRecv(rlen);
-
-	if(!m_response->IsHeaderReceived()) {
-		m_response->ParseHeader(buf, rlen);
-
-		if(!m_response->IsHeaderReceived()) {
-			goto cleanup;
+	Ptr<Packet> packet;
+	while(m_socket == socket && (packet = socket->Recv())) {
+		//one packet may carry the tail of a response and the start of the next
+		while(packet != 0 && packet->GetSize() > 0) {
+			if(m_exchanges.empty()) {
+				NS_LOG_WARN("Dropping " << packet->GetSize() << " unexpected bytes");
+				break;
+			}
+			HttpExchange &exchange = m_exchanges.front();
+			Ptr<HttpResponse> response = exchange.m_response;
+			uint32_t used = 0;
+			if(!response->IsHeaderReceived()) {
+				//only the header is read out of the packet
+				uint8_t buf[1024];
+				uint32_t len = packet->CopyData(buf, sizeof(buf));
+				used = response->ParseHeader(buf, len);
+				packet->RemoveAtStart(used);
+				if(!response->IsHeaderReceived()) {
+					exchange.m_trace.ResponseRecv(used);
+					continue;
+				}
+				exchange.m_bodyLeft = response->GetContentLength();
+				m_response = response;
+				RecvResponseHeader();
+			}
+			//without Content-Length the body ends with the connection
+			bool framed = response->HasHeader("Content-Length");
+			uint32_t len = packet->GetSize();
+			if(framed) {
+				len = std::min((clen_t)len, exchange.m_bodyLeft);
+				exchange.m_bodyLeft -= len;
+			}
+			Ptr<Packet> body = packet;
+			if(len < packet->GetSize()) {
+				body = packet->CreateFragment(0, len);
+				packet->RemoveAtStart(len);
+			} else {
+				packet = 0;
+			}
+			exchange.m_trace.ResponseRecv(used + len);
+			if(len > 0) {
+				RecvResponseData(body);
+				if(!exchange.m_bodySink.IsNull())
+					exchange.m_bodySink(body);
+			}
+			if(!framed || exchange.m_bodyLeft > 0)
+				break;
+			ResponseComplete();
+			if(m_socket != socket)
+				break; //closed or replaced by the completion
 		}
-		RecvResponseHeader();
-		rlen = m_response->ReadBody(buf, sizeof(buf));
-
 	}
-	if (rlen > 0)
-		RecvResponseData(buf, rlen);
-cleanup:
-	delete[] buf;
 }
 
 void HttpClientBasic::EvHandleSend(Ptr<Socket> socket, uint32_t bufAvailable) {
 	NS_LOG_FUNCTION(this << socket);
-
-	m_trace.RequestSent();
-
-	uint8_t buf[2048];
-	uint32_t toSend = std::min(bufAvailable, (uint32_t)sizeof(buf));
-
-	uint32_t len = m_request->ReadHeader(buf, toSend);
-	if(len > 0) {
-		uint32_t sent = m_socket->Send(buf, len, 0);
-		NS_ASSERT(sent == len);
-	}
+	if(!m_connected) return;
+	SendPending();
 }
 
 void HttpClientBasic::EvSocketClosed(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
 	NS_LOG_LOGIC("Http Client connection closed");
 //	std::cout << "Success Closed" << std::endl;
-	EndConnection();
-}
-
-void HttpTrace::RequestSent() {
-	m_reqSentAt = Simulator::Now();
-}
-
-void HttpTrace::ResponseRecv(uint32_t len) {
-
-	if(m_firstByteAt.IsZero())
-		m_firstByteAt = Simulator::Now();
-
-	auto now = Simulator::Now();
-	if(m_trace.size() > 1) {
-		m_speed = (len*8 * 1.0e6) / (now.GetMicroSeconds() - m_lastByteAt.GetMicroSeconds());
+	CloseSocket();
+	if(m_exchanges.empty())
+		return;
+	HttpExchange &front = m_exchanges.front();
+	if(front.m_trace.m_resLen == 0 && !front.m_retried) {
+		//the server dropped an idle connection before reading our requests
+		RetryPending();
+		return;
 	}
-	m_lastByteAt = now;
-	m_resLen += len;
-	std::pair<Time, uint64_t> entry(Simulator::Now(), m_resLen);
-
-	m_trace.push_back(entry);
-}
-
-void HttpTrace::StoreInFile(std::ostream &outFile) {
-	outFile << "{" ;
-	outFile << "\"reqSentAt\":" << m_reqSentAt.GetSeconds() << ",";
-	outFile << "\"firstByteAt\":" << m_firstByteAt.GetSeconds() << ",";
-	outFile << "\"lastByteAt\":" << m_lastByteAt.GetSeconds() << ",";
-	outFile << "\"trace\": [";
-	std::string separator = "";
-	for(auto it: m_trace) {
-		outFile << separator << "[";
-		outFile << it.first.GetSeconds() << "," << it.second;
-		outFile << "]";
-		separator = ",";
-	}
-	outFile << "]";
-	outFile << "}";
-}
-double HttpTrace::GetDownloadSpeed() const {
-	return m_speed;
+	//the response ends with the connection, or got truncated
+	ResponseComplete();
 }
 
 } /* namespace ns3 */
@@ -10,8 +10,13 @@
 
 
 #include "http-common-request-response.h"
+#include "http-trace.h"
+#include "http-mux.h"
 #include "ns3/application.h"
 #include "ns3/socket.h"
+#include "ns3/packet.h"
+#include "ns3/event-id.h"
+#include <deque>
 
 
 //class Socket;
@@ -20,39 +25,76 @@
 namespace ns3 {
 
 
-struct HttpTrace {
-	Time m_reqSentAt, m_firstByteAt, m_lastByteAt;
-	clen_t m_resLen;
-	double m_speed;
-	std::list<std::pair<Time, uint64_t> > m_trace;
-
-	HttpTrace(): m_resLen(0), m_speed(0){}
-
-	void RequestSent();
-	void ResponseRecv(uint32_t len);
-	void StoreInFile(std::ostream &outFile);
-	double GetDownloadSpeed() const;
-};
-
+/*
+ * \brief Http/1.1 client on one connection. The collection callback fires
+ *        once the response is complete, i.e. Content-Length bytes of body
+ *        arrived or the server closed the connection. With KeepAlive the
+ *        socket stays open afterwards and the next InitConnection/Connect
+ *        to the same server reuses it.
+ *
+ *        With KeepAlive, Connect() may be called again before the previous
+ *        response arrived: the requests are pipelined, i.e. written back to
+ *        back and answered in order. Each request keeps the collection
+ *        callback that was set when it was sent, and GetResponse()/GetTrace()
+ *        refer to the response whose callback is running. If the server
+ *        closes the connection, requests it did not answer are sent again
+ *        on a new connection.
+ *
+ *        Received packets are not copied: the body part of each one is
+ *        handed as is (or as a fragment sharing its buffer) to the body
+ *        sink, only header bytes are read out to be parsed. Like the
+ *        collection callback, the sink is captured by Connect().
+ *
+ *        A request not answered Timeout after its Connect() is aborted:
+ *        the connection is torn down, the callback fires with
+ *        WasAborted() true and later requests go out on a new connection.
+ *        Abort() does the same for every request in flight.
+ *
+ *        With SetMux() the client does not open tcp connections of its
+ *        own but streams of the given HttpMuxConnection, with its
+ *        Priority. Nothing else changes, a stream behaves like a socket.
+ *        Likewise SocketFactory picks the transport of its own
+ *        connections, e.g. ns3::RudpSocketFactory instead of tcp.
+ */
 class HttpClientBasic : public Object {
 public:
 	static TypeId GetTypeId(void);
 	HttpClientBasic();
 	virtual ~HttpClientBasic();
 	void SetCollectionCB(Callback<void> cb, Ptr<Node> node);
+	void SetBodySink(Callback<void, Ptr<const Packet> > sink);
 	void InitConnection(Address peerAddress, uint16_t peerPort, std::string path="/");
 	void InitConnection(std::string path = "");
 	void StopConnection();
+	void Abort(); ///< drop the connection and fail every request in flight
+	void SetTimeout(Time timeout); ///< for the following requests, negative disables
+	void SetMux(Ptr<HttpMuxConnection> mux); ///< open streams of mux instead of connections
+	void SetPriority(uint8_t priority); ///< of the mux stream, lower is more urgent
+	bool IsIdle() const; ///< connected and no request in flight
+	uint32_t GetNumPending() const; ///< requests sent or queued, not yet answered
+	bool IsConnectedTo(const Address &peerAddress, uint16_t peerPort) const;
 
 
 	void AddReqHeader(std::string name, std::string value);
+	void SetReqRange(clen_t first, clen_t last = HTTP_RANGE_END); ///< ask for part of the body
+	/*
+	 * Body of the request being built, sent right after its header with
+	 * a matching Content-Length. InitConnection() clears it. The packet
+	 * variant keeps the byte tags of body, so it may be a virtual packet
+	 * whose tags carry typed metadata.
+	 */
+	void SetReqBody(const std::string &body);
+	void SetReqBody(Ptr<Packet> body);
 	void Connect();
 	const HttpTrace& GetTrace() const;
+	bool WasAborted() const; ///< the last response did not complete
+	bool WasTimedOut() const; ///< the last response was aborted by the timeout
+	HttpTrace TakeTrace(); ///< moves the trace of the last response out
 
 	const Ptr<HttpResponse>& GetResponse() const; //earlier protected
 
 protected:
-	virtual void RecvResponseData(uint8_t *data, uint32_t len);
+	virtual void RecvResponseData(Ptr<const Packet> data); ///< body bytes only
 	virtual void RecvResponseHeader();
 
 private:
@@ -62,12 +104,39 @@ private:
 	void EvHandleSend (Ptr<Socket> socket, uint32_t bufAvailable);
 	void EvSocketClosed (Ptr<Socket> socket);
 	void EvErrorClosed (Ptr<Socket> socket);
-
-	void EndConnection();
+	void EvTimeout ();
+
+	struct HttpExchange {
+		HttpExchange(): m_sent(0), m_bodyLeft(0), m_retried(false),
+				m_aborted(false), m_timedOut(false), m_deadline(-1) {}
+		Ptr<HttpRequest> m_request;
+		Ptr<HttpResponse> m_response;
+		std::string m_wire; //!< serialized request header
+		Ptr<Packet> m_body; //!< sent after m_wire, 0 if none
+		uint32_t m_sent;
+		clen_t m_bodyLeft;
+		bool m_retried;
+		bool m_aborted;
+		bool m_timedOut;
+		Time m_deadline; //!< negative if none
+		HttpTrace m_trace;
+		Callback<void> m_onComplete;
+		Callback<void, Ptr<const Packet> > m_bodySink;
+	};
+
+	void OpenSocket();
+	void SendPending();
+	void ResponseComplete();
+	void RetryPending();
+	void FailPending();
+	void CloseSocket();
+	void ArmTimeout();
 
 	//Internal variable
-	Ptr<HttpRequest> m_request;
-	Ptr<HttpResponse> m_response;
+	Ptr<HttpRequest> m_request; //!< request being built
+	Ptr<Packet> m_reqBody; //!< body of m_request, 0 if none
+	Ptr<HttpResponse> m_response; //!< last completed response
+	std::deque<HttpExchange> m_exchanges; //!< in flight, oldest first
 	Ptr<Socket> m_socket; //!< IPv4 Socket
 	uint16_t m_peerPort; //!< Remote peer port
 	std::string m_path;
@@ -76,10 +145,22 @@ private:
 	Ptr<Node> m_node;
 //	Ptr<Object> m_collectionBlob;
 	Callback<void> m_onConnectionClosed;
+	Callback<void, Ptr<const Packet> > m_bodySink;
+	bool m_keepAlive;
+	bool m_connected;
+	bool m_aborted;
+	bool m_timedOut;
+	Time m_timeout;
+	EventId m_timeoutEvent;
+	Ptr<HttpMuxConnection> m_mux;
+	uint8_t m_priority;
+	TypeId m_socketFactory;
+	Time m_traceResolution;
+	uint64_t m_traceGranularity;
 
 	//=================
 	// Trace
-	HttpTrace m_trace;
+	HttpTrace m_trace; //!< of the last completed response
 };
 
 } /* namespace ns3 */
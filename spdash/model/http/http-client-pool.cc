@@ -0,0 +1,150 @@
+/*
+ * http-client-pool.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-client-pool.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/tcp-socket-factory.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpClientPool");
+NS_OBJECT_ENSURE_REGISTERED(HttpClientPool);
+
+TypeId HttpClientPool::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpClientPool")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpClientPool>()
+			.AddAttribute("MaxIdle",
+					"Maximum number of idle connections kept open",
+					UintegerValue(4),
+					MakeUintegerAccessor(&HttpClientPool::m_maxIdle),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute("MaxConnections",
+					"Maximum number of connections to one server, 0 for no limit",
+					UintegerValue(0),
+					MakeUintegerAccessor(&HttpClientPool::m_maxConnections),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute("Multiplex",
+					"Carry all requests to one server as streams of a single tcp connection",
+					BooleanValue(false),
+					MakeBooleanAccessor(&HttpClientPool::m_multiplex),
+					MakeBooleanChecker())
+			.AddAttribute("SocketFactory",
+					"TypeId of the socket factory connections are opened with",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&HttpClientPool::m_socketFactory),
+					MakeTypeIdChecker());
+	return tid;
+}
+
+HttpClientPool::HttpClientPool(): m_maxIdle(4), m_maxConnections(0), m_multiplex(false),
+		m_socketFactory(TcpSocketFactory::GetTypeId()) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpClientPool::~HttpClientPool() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpClientPool::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	m_clients.clear();
+	m_muxes.clear();
+	m_node = 0;
+	Object::DoDispose();
+}
+
+void HttpClientPool::SetNode(Ptr<Node> node) {
+	m_node = node;
+}
+
+Ptr<HttpClientBasic> HttpClientPool::Acquire(Address peerAddress, uint16_t peerPort,
+		uint32_t maxPending) {
+	NS_LOG_FUNCTION(this << maxPending);
+	PooledClient *pooled = NULL;
+	uint32_t connections = 0;
+	for (auto &it : m_clients) {
+		if (!it.m_client->IsConnectedTo(peerAddress, peerPort))
+			continue;
+		connections++;
+		if (it.m_leases < maxPending && (!pooled || it.m_leases < pooled->m_leases))
+			pooled = &it;
+	}
+	if (!pooled) {
+		if (m_maxConnections > 0 && connections >= m_maxConnections)
+			return 0;
+		Ptr<HttpClientBasic> client = CreateObject<HttpClientBasic>();
+		client->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+		if (m_multiplex)
+			client->SetMux(GetMux(peerAddress, peerPort));
+		m_clients.push_back(PooledClient(client));
+		pooled = &m_clients.back();
+		NS_LOG_LOGIC("new connection, open=" << connections);
+	}
+	pooled->m_leases++;
+	Ptr<HttpClientBasic> client = pooled->m_client;
+	client->SetCollectionCB(MakeNullCallback<void>(), m_node);
+	client->SetBodySink(MakeNullCallback<void, Ptr<const Packet> >());
+	client->InitConnection(peerAddress, peerPort);
+	return client;
+}
+
+void HttpClientPool::Release(Ptr<HttpClientBasic> client) {
+	NS_LOG_FUNCTION(this);
+	client->SetCollectionCB(MakeNullCallback<void>(), m_node);
+	for (auto &it : m_clients) {
+		if (it.m_client == client && it.m_leases > 0) {
+			it.m_leases--;
+			break;
+		}
+	}
+	uint32_t idle = 0;
+	for (auto it = m_clients.begin(); it != m_clients.end();) {
+		Ptr<HttpClientBasic> cur = it->m_client;
+		if (it->m_leases > 0 || cur->GetNumPending() > 0) {
+			++it;
+		} else if (!cur->IsIdle()) {
+			it = m_clients.erase(it); //connection is gone
+		} else if (++idle > m_maxIdle) {
+			cur->StopConnection();
+			it = m_clients.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void HttpClientPool::StopAll() {
+	NS_LOG_FUNCTION(this);
+	//StopConnection may call back into the owner, work on a copy
+	std::list<PooledClient> clients;
+	std::swap(clients, m_clients);
+	for (auto &it : clients) {
+		it.m_client->StopConnection();
+	}
+	for (auto mux : m_muxes) {
+		mux->Close();
+	}
+	m_muxes.clear();
+}
+
+Ptr<HttpMuxConnection> HttpClientPool::GetMux(Address peerAddress, uint16_t peerPort) {
+	for (auto it : m_muxes) {
+		if (it->IsConnectedTo(peerAddress, peerPort))
+			return it; //reconnects by itself if the connection broke
+	}
+	Ptr<HttpMuxConnection> mux = CreateObject<HttpMuxConnection>();
+	mux->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+	mux->Connect(m_node, peerAddress, peerPort);
+	m_muxes.push_back(mux);
+	return mux;
+}
+
+} /* namespace ns3 */
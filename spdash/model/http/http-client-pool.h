@@ -0,0 +1,66 @@
+/*
+ * http-client-pool.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_CLIENT_POOL_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_CLIENT_POOL_H_
+
+#include "http-client-basic.h"
+#include "http-mux.h"
+#include "ns3/node.h"
+#include <list>
+
+namespace ns3 {
+
+/*
+ * \brief Keep-alive connections of one player. Acquire() hands out the
+ *        client connected to the server with the fewest leases out, as
+ *        long as it has less than maxPending of them; otherwise a new
+ *        client, unless MaxConnections to that server are open already, in
+ *        which case it returns 0. Every Acquire() is one lease, returned by
+ *        exactly one Release() after the response. A leased client is never
+ *        closed or forgotten, even before its request is queued; at most
+ *        MaxIdle unleased idle connections are kept open.
+ *
+ *        With Multiplex, all clients to one server are streams of a single
+ *        HttpMuxConnection, MaxConnections then limits concurrent streams.
+ */
+class HttpClientPool: public Object {
+public:
+	static TypeId GetTypeId(void);
+	HttpClientPool();
+	virtual ~HttpClientPool();
+
+	void SetNode(Ptr<Node> node);
+	Ptr<HttpClientBasic> Acquire(Address peerAddress, uint16_t peerPort,
+			uint32_t maxPending = 1);
+	void Release(Ptr<HttpClientBasic> client);
+	void StopAll();
+
+protected:
+	virtual void DoDispose(void);
+
+private:
+	struct PooledClient {
+		PooledClient(Ptr<HttpClientBasic> client): m_client(client), m_leases(0) {}
+		Ptr<HttpClientBasic> m_client;
+		uint32_t m_leases; //!< Acquire()s not Release()d yet
+	};
+
+	Ptr<HttpMuxConnection> GetMux(Address peerAddress, uint16_t peerPort);
+
+	Ptr<Node> m_node;
+	std::list<PooledClient> m_clients;
+	std::list<Ptr<HttpMuxConnection> > m_muxes;
+	uint32_t m_maxIdle;
+	uint32_t m_maxConnections;
+	bool m_multiplex;
+	TypeId m_socketFactory;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_CLIENT_POOL_H_ */
@@ -8,94 +8,77 @@
 #include "http-common-request-response.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include "ns3/log.h"
 
-#define HRR_BUFFER_LENGTH 2048
-
 NS_LOG_COMPONENT_DEFINE("HttpCommonRequestResponse");
 
 namespace ns3 {
 
 
-void AddToBuffer(std::queue<std::pair<char*, uint16_t> > &q, const char *buf,
-		uint16_t len) {
-	char *nbuf = new char[len];
-	std::memcpy(nbuf, buf, len);
-	std::pair<char*, uint16_t> pair(nbuf, len);
-	q.push(pair);
-}
-
-uint16_t ReadFromBuffer(std::queue<std::pair<char*, uint16_t> > &q, char *buf,
-		uint16_t len) {
-	uint16_t ret = 0;
-	while (len && !q.empty()) {
-		auto pt = q.front();
-		uint16_t mlen = std::min(len, pt.second);
-		std::memcpy(buf, pt.first, mlen);
-		buf += mlen;
-		ret += mlen;
-		len -= mlen;
-		if (mlen < pt.second) {
-			char *nbuf = new char[pt.second - mlen];
-			std::memcpy(nbuf, pt.first + mlen, pt.second - mlen);
-			delete[] pt.first;
-			pt.first = nbuf;
-			pt.second -= mlen;
-			NS_ASSERT(len == 0);
-		} else {
-			delete[] pt.first;
-			q.pop();
-		}
-	}
-	return ret;
+/****************************************************
+ *                                                  *
+ ****************************************************/
+
+HttpHeaderTemplate::HttpHeaderTemplate(std::string version, uint16_t statusCode,
+		std::string statusText): m_version(version), m_statusCode(statusCode), m_statusText(statusText) {
+	m_wire.append(version).append(" ").append(std::to_string(statusCode))
+			.append(" ").append(statusText).append("\r\n");
 }
 
+void HttpHeaderTemplate::AddHeader(std::string name, std::string value) {
+	m_wire.append(name).append(": ").append(value).append("\r\n");
+}
 
 /****************************************************
  *                                                  *
  ****************************************************/
 
-HttpCommonRequestResponse::HttpCommonRequestResponse(HttReqResState hrrs): m_tmpbuflen(0), m_state(hrrs) {
+HttpCommonRequestResponse::HttpCommonRequestResponse(HttReqResState hrrs): m_state(hrrs),
+		m_initialState(hrrs), m_template(NULL) {
 }
 
 HttpCommonRequestResponse::~HttpCommonRequestResponse() {
 	NS_LOG_FUNCTION(this);
 }
 
-void HttpCommonRequestResponse::ParseHeader(uint8_t *buf, uint16_t len) {
+uint32_t HttpCommonRequestResponse::ParseHeader(const uint8_t *buf, uint32_t len) {
 	NS_LOG_FUNCTION(this);
 	NS_ASSERT(m_state != HTTP_REQ_RES_INVALID);
 
-	if (m_state == HTTP_REQ_RES_READ_BODY) {
-		AddToBuffer(m_body, (char*) buf, len);
-		return;
-	}
-
-	std::string headerLine;
-	uint8_t last = m_tmpbuflen > 0 ? m_tmpbuf[m_tmpbuflen - 1] : 0;
-	uint16_t offset = 0;
-	for (uint16_t i = 0; i < len; i++) {
-		if (m_state == HTTP_REQ_RES_READ_BODY) {
-			offset = i;
-			break;
+	uint32_t i = 0;
+	while (i < len && m_state != HTTP_REQ_RES_READ_BODY) {
+		const uint8_t *eol = (const uint8_t*) std::memchr(buf + i, '\n', len - i);
+		if (!eol) { //line continues in the next segment
+			m_line.append((const char*) buf + i, len - i);
+			return len;
 		}
-
-		uint8_t cur = buf[i];
-		m_tmpbuf[m_tmpbuflen++] = cur;
-		if (last == '\r' and cur == '\n') { //Got a headerLine
-			ProcessHeaderLine(); //tmpbuffer already have the buffer;
-			m_tmpbuflen = 0;
+		uint32_t end = eol - buf + 1;
+		if (m_line.empty()) {
+			ProcessHeaderLine((const char*) buf + i, end - i);
+		} else {
+			m_line.append((const char*) buf + i, end - i);
+			ProcessHeaderLine(m_line.data(), m_line.size());
+			m_line.clear();
 		}
-		last = cur;
+		i = end;
 	}
-	if (m_state == HTTP_REQ_RES_READ_BODY)
-		AddToBuffer(m_body, (char*) (buf + offset), len - offset);
+	return i;
+}
+
+void HttpCommonRequestResponse::AddBody(const uint8_t *buf, uint32_t len) {
+	NS_LOG_FUNCTION(this);
+	NS_ASSERT(m_state == HTTP_REQ_RES_READ_BODY);
+	m_body.Write(buf, len);
 }
 
 void HttpCommonRequestResponse::AddHeader(std::string key, std::string value) {
 	NS_LOG_FUNCTION(this);
 	NS_ASSERT(m_state == HTTP_REQ_RES_INVALID);
-	m_headers[key] = value;
+	SetHeader(key.data(), key.size(), value.data(), value.size());
 }
 
 void HttpCommonRequestResponse::EndHeader() {
@@ -103,41 +86,59 @@ void HttpCommonRequestResponse::EndHeader() {
 
 	NS_ASSERT(m_state == HTTP_REQ_RES_INVALID);
 
-	ReadFirstHeaderLine();
-	for (auto it : m_headers) {
-		auto sptr = std::string(it.first + ": " + it.second + "\r\n");
-		const char *headerLine = sptr.c_str();
-		AddToBuffer(m_request, headerLine, std::strlen(headerLine));
-
+	if (m_template)
+		AddToHeaderBuffer(m_template->GetWire().data(), m_template->GetWire().size());
+	else
+		ReadFirstHeaderLine();
+	const char *arena = m_headerArena.data();
+	for (auto &it : m_headers) {
+		AddToHeaderBuffer(arena + it.m_name, it.m_nameLen);
+		AddToHeaderBuffer(": ", 2);
+		AddToHeaderBuffer(arena + it.m_value, it.m_valueLen);
+		AddToHeaderBuffer("\r\n", 2);
 	}
-	const char *headerLine = "\r\n";
-	AddToBuffer(m_request, headerLine, std::strlen(headerLine));
+	AddToHeaderBuffer("\r\n", 2);
 
 	m_state = HTTP_REQ_RES_LOCK;
 
 }
 
-void HttpCommonRequestResponse::AddToHeaderBuffer(const char *buf, uint16_t len) {
-	AddToBuffer(m_request, buf, len);
+void HttpCommonRequestResponse::AddToHeaderBuffer(const char *buf, uint32_t len) {
+	m_request.Write((const uint8_t*) buf, len);
 }
 
-uint16_t HttpCommonRequestResponse::ReadHeader(uint8_t *buf, uint16_t len) {
+uint32_t HttpCommonRequestResponse::ReadHeader(uint8_t *buf, uint32_t len) {
 	NS_LOG_FUNCTION(this);
 
 	if (m_state != HTTP_REQ_RES_LOCK) {
 		EndHeader();
 	}
 
-	return ReadFromBuffer(m_request, (char*) buf, len);
+	return m_request.Read(buf, len);
 }
 
 
-uint16_t HttpCommonRequestResponse::ReadBody(uint8_t *buf, uint16_t len) {
+uint32_t HttpCommonRequestResponse::ReadBody(uint8_t *buf, uint32_t len) {
 	NS_LOG_FUNCTION(this);
 
 	NS_ASSERT(m_state == HTTP_REQ_RES_READ_BODY);
 
-	return ReadFromBuffer(m_request, (char*) buf, len);
+	return m_body.Read(buf, len);
+}
+
+void HttpCommonRequestResponse::Reset() {
+	NS_LOG_FUNCTION(this);
+	m_state = m_initialState;
+	m_line.clear();
+	m_body.Clear();
+	m_request.Clear();
+	m_headerArena.clear();
+	m_headers.clear();
+	m_template = NULL;
+}
+
+uint32_t HttpCommonRequestResponse::GetHeaderSize() const {
+	return m_request.GetSize();
 }
 
 bool HttpCommonRequestResponse::IsHeaderReceived() {
@@ -145,42 +146,147 @@ bool HttpCommonRequestResponse::IsHeaderReceived() {
 	return m_state == HTTP_REQ_RES_READ_BODY;
 }
 
-void HttpCommonRequestResponse::ProcessHeaderLine() {
+static inline bool HttpIsSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline bool HttpEqualsNoCase(const char *a, const char *b, uint32_t len) {
+	for (uint32_t i = 0; i < len; i++) {
+		if (std::tolower((unsigned char) a[i]) != std::tolower((unsigned char) b[i]))
+			return false;
+	}
+	return true;
+}
+
+void HttpCommonRequestResponse::ProcessHeaderLine(const char *line, uint32_t len) {
 	NS_LOG_FUNCTION(this);
-	NS_ASSERT(
-			m_state != HTTP_REQ_RES_INVALID && m_state != HTTP_REQ_RES_READ_BODY
-					&& m_tmpbuflen >= 2);
-	if (m_tmpbuflen == 2) { //Header ended here
+	NS_ASSERT(m_state != HTTP_REQ_RES_INVALID && m_state != HTTP_REQ_RES_READ_BODY);
+
+	while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+		len--;
+	if (len == 0) { //Header ended here
 		m_state = HTTP_REQ_RES_READ_BODY;
 		return;
 	}
 
-	std::stringstream ss;
-	ss.write((char*) m_tmpbuf, m_tmpbuflen - 1); // I need \r
 	if (m_state == HTTP_REQ_RES_PARSE_L1) {
-		ProcessFirstHeaderLine(ss);
+		ProcessFirstHeaderLine(line, len);
 		m_state = HTTP_REQ_RES_PARSE_HEADER;
 		return;
 	}
 
-	std::string key, value;
-	std::getline(ss, key, ':');
-	auto c = ss.get();
-	while (c == ' ') {
-		c = ss.get();
-	};
-	ss.unget();
-	std::getline(ss, value, '\r');
-	NS_LOG_INFO("key: " << key << " <=> value: " << value);
-//	std::cout << "orig: " << m_tmpbuflen << " key: " << key << " <=> value: "
-//			<< value << std::endl;
-	m_headers[key] = value;
+	const char *colon = (const char*) std::memchr(line, ':', len);
+	if (!colon) {
+		NS_LOG_WARN("Ignoring malformed header line");
+		return;
+	}
+	uint32_t nameLen = colon - line;
+	const char *value = colon + 1;
+	uint32_t valueLen = len - nameLen - 1;
+	while (valueLen > 0 && HttpIsSpace(*value)) {
+		value++;
+		valueLen--;
+	}
+	while (valueLen > 0 && HttpIsSpace(value[valueLen - 1]))
+		valueLen--;
+	NS_LOG_INFO("key: " << std::string(line, nameLen) << " <=> value: " << std::string(value, valueLen));
+	SetHeader(line, nameLen, value, valueLen);
+}
+
+void HttpCommonRequestResponse::SetHeader(const char *name, uint32_t nameLen,
+		const char *value, uint32_t valueLen) {
+	int idx = FindHeader(name, nameLen);
+	if (idx < 0) {
+		HttpHeaderField field;
+		field.m_name = m_headerArena.size();
+		field.m_nameLen = nameLen;
+		m_headerArena.append(name, nameLen);
+		m_headers.push_back(field);
+		idx = m_headers.size() - 1;
+	}
+	//a replaced value stays in the arena, headers are rarely set twice
+	m_headers[idx].m_value = m_headerArena.size();
+	m_headers[idx].m_valueLen = valueLen;
+	m_headerArena.append(value, valueLen);
+}
+
+int HttpCommonRequestResponse::FindHeader(const char *name, uint32_t nameLen) const {
+	const char *arena = m_headerArena.data();
+	for (uint32_t i = 0; i < m_headers.size(); i++) {
+		const HttpHeaderField &field = m_headers[i];
+		if (field.m_nameLen == nameLen && HttpEqualsNoCase(arena + field.m_name, name, nameLen))
+			return i;
+	}
+	return -1;
+}
+
+std::string HttpCommonRequestResponse::NextToken(const char *&line, uint32_t &len) {
+	while (len > 0 && HttpIsSpace(*line)) {
+		line++;
+		len--;
+	}
+	const char *start = line;
+	while (len > 0 && !HttpIsSpace(*line)) {
+		line++;
+		len--;
+	}
+	return std::string(start, line - start);
 }
 
 std::string HttpCommonRequestResponse::GetHeader(std::string name) {
-	if(m_headers.find(name) == m_headers.end())
+	int idx = FindHeader(name.data(), name.size());
+	if (idx < 0)
 		return std::string();
-	return m_headers[name];
+	return m_headerArena.substr(m_headers[idx].m_value, m_headers[idx].m_valueLen);
+}
+
+std::string HttpCommonRequestResponse::GetHeaderName(uint32_t idx) const {
+	return m_headerArena.substr(m_headers[idx].m_name, m_headers[idx].m_nameLen);
+}
+
+std::string HttpCommonRequestResponse::GetHeaderValue(uint32_t idx) const {
+	return m_headerArena.substr(m_headers[idx].m_value, m_headers[idx].m_valueLen);
+}
+
+bool HttpCommonRequestResponse::HasHeader(std::string name) {
+	return FindHeader(name.data(), name.size()) >= 0;
+}
+
+clen_t HttpCommonRequestResponse::GetContentLength() {
+	int idx = FindHeader("Content-Length", 14);
+	if (idx < 0)
+		return 0;
+	const char *value = m_headerArena.data() + m_headers[idx].m_value;
+	clen_t clen = 0;
+	for (uint32_t i = 0; i < m_headers[idx].m_valueLen && std::isdigit((unsigned char) value[i]); i++)
+		clen = clen * 10 + (value[i] - '0');
+	return clen;
+}
+
+bool HttpCommonRequestResponse::GetHeaderNumber(std::string name, clen_t &value) {
+	value = 0;
+	int idx = FindHeader(name.data(), name.size());
+	if (idx < 0)
+		return true;
+	std::string text = m_headerArena.substr(m_headers[idx].m_value, m_headers[idx].m_valueLen);
+	//strtoull would skip spaces and accept a sign
+	if (text.empty() || !std::isdigit((unsigned char) text[0]))
+		return false;
+	char *end;
+	errno = 0;
+	clen_t parsed = std::strtoull(text.c_str(), &end, 10);
+	if (*end || errno == ERANGE)
+		return false;
+	value = parsed;
+	return true;
+}
+
+bool HttpCommonRequestResponse::IsKeepAlive() {
+	int idx = FindHeader("Connection", 10);
+	if (idx < 0)
+		return true;
+	return !(m_headers[idx].m_valueLen == 5
+			&& HttpEqualsNoCase(m_headerArena.data() + m_headers[idx].m_value, "close", 5));
 }
 
 /****************************************************
@@ -203,14 +309,26 @@ HttpRequest::~HttpRequest() {
 	NS_LOG_FUNCTION(this);
 }
 
+void HttpRequest::Reset() {
+	HttpCommonRequestResponse::Reset();
+	m_method.clear();
+	m_path.clear();
+	m_version.clear();
+}
+
 void HttpRequest::ReadFirstHeaderLine(){
-	auto sptr = std::string(m_method + " " + m_path + " " + m_version + "\r\n");
-	auto ptr = sptr.c_str();
-	AddToHeaderBuffer(ptr, std::strlen(ptr));
+	AddToHeaderBuffer(m_method.data(), m_method.size());
+	AddToHeaderBuffer(" ", 1);
+	AddToHeaderBuffer(m_path.data(), m_path.size());
+	AddToHeaderBuffer(" ", 1);
+	AddToHeaderBuffer(m_version.data(), m_version.size());
+	AddToHeaderBuffer("\r\n", 2);
 }
 
-void HttpRequest::ProcessFirstHeaderLine(std::stringstream &ss) {
-	ss >> m_method >> m_path >> m_version;
+void HttpRequest::ProcessFirstHeaderLine(const char *line, uint32_t len) {
+	m_method = NextToken(line, len);
+	m_path = NextToken(line, len);
+	m_version = NextToken(line, len);
 }
 
 const std::string& HttpRequest::getMethod() const {
@@ -225,6 +343,47 @@ const std::string& HttpRequest::GetVersion() const {
 	return m_version;
 }
 
+void HttpRequest::SetRange(clen_t first, clen_t last) {
+	std::string range = "bytes=" + std::to_string(first) + "-";
+	if (last != HTTP_RANGE_END)
+		range += std::to_string(last);
+	AddHeader("Range", range);
+}
+
+HttpRangeResult HttpRequest::GetRange(clen_t total, clen_t &first, clen_t &last) {
+	std::string range = GetHeader("Range");
+	if (range.compare(0, 6, "bytes=") != 0 || range.find(',') != std::string::npos)
+		return HTTP_RANGE_NONE;
+	const char *spec = range.c_str() + 6;
+	const char *dash = std::strchr(spec, '-');
+	if (!dash)
+		return HTTP_RANGE_NONE;
+	char *end;
+	if (dash == spec) { //suffix range, the last n bytes
+		clen_t n = std::strtoull(dash + 1, &end, 10);
+		if (end == dash + 1 || *end)
+			return HTTP_RANGE_NONE;
+		if (n == 0 || total == 0)
+			return HTTP_RANGE_UNSATISFIABLE;
+		first = n < total ? total - n : 0;
+		last = total - 1;
+		return HTTP_RANGE_OK;
+	}
+	first = std::strtoull(spec, &end, 10);
+	if (end != dash)
+		return HTTP_RANGE_NONE;
+	last = HTTP_RANGE_END;
+	if (dash[1]) {
+		last = std::strtoull(dash + 1, &end, 10);
+		if (*end || last < first)
+			return HTTP_RANGE_NONE;
+	}
+	if (first >= total)
+		return HTTP_RANGE_UNSATISFIABLE;
+	last = std::min(last, total - 1);
+	return HTTP_RANGE_OK;
+}
+
 } /* namespace ns3 */
 
 /****************************************************
@@ -250,16 +409,22 @@ HttpResponse::~HttpResponse() {
 }
 
 void HttpResponse::ReadFirstHeaderLine(){
-	auto sptr = std::string(m_version + " " + std::to_string(m_statusCode) + " " + m_statusText + "\r\n");
-	auto ptr = sptr.c_str();
-	AddToHeaderBuffer(ptr, std::strlen(ptr));
+	std::string code = std::to_string(m_statusCode);
+	AddToHeaderBuffer(m_version.data(), m_version.size());
+	AddToHeaderBuffer(" ", 1);
+	AddToHeaderBuffer(code.data(), code.size());
+	AddToHeaderBuffer(" ", 1);
+	AddToHeaderBuffer(m_statusText.data(), m_statusText.size());
+	AddToHeaderBuffer("\r\n", 2);
 }
 
-void HttpResponse::ProcessFirstHeaderLine(std::stringstream &ss) {
-	ss >> m_version >> m_statusCode >> m_statusText;
+void HttpResponse::ProcessFirstHeaderLine(const char *line, uint32_t len) {
+	m_version = NextToken(line, len);
+	m_statusCode = std::atoi(NextToken(line, len).c_str());
+	m_statusText = NextToken(line, len);
 }
 
-uint8_t HttpResponse::GetStatusCode() const {
+uint16_t HttpResponse::GetStatusCode() const {
 	return m_statusCode;
 }
 
@@ -283,4 +448,28 @@ void HttpResponse::SetVersion(const std::string &mVersion) {
 	m_version = mVersion;
 }
 
+void HttpResponse::SetContentRange(clen_t first, clen_t last, clen_t total) {
+	if (first > last) {
+		AddHeader("Content-Range", "bytes */" + std::to_string(total));
+		return;
+	}
+	AddHeader("Content-Range", "bytes " + std::to_string(first) + "-"
+			+ std::to_string(last) + "/" + std::to_string(total));
+}
+
+bool HttpResponse::GetContentRange(clen_t &first, clen_t &last, clen_t &total) {
+	std::string range = GetHeader("Content-Range");
+	if (range.compare(0, 6, "bytes ") != 0)
+		return false;
+	char *end;
+	first = std::strtoull(range.c_str() + 6, &end, 10);
+	if (*end != '-')
+		return false;
+	last = std::strtoull(end + 1, &end, 10);
+	if (*end != '/')
+		return false;
+	total = std::strtoull(end + 1, &end, 10); //0 for an unknown ("*") length
+	return first <= last;
+}
+
 } /* namespace ns3 */
@@ -10,8 +10,8 @@
 
 #include "ns3/object.h"
 #include "http-common.h"
-#include <map>
-#include <queue>
+#include "http-ring-buffer.h"
+#include <vector>
 
 enum HttReqResState{
 	HTTP_REQ_RES_PARSE_L1,
@@ -21,39 +21,107 @@ enum HttReqResState{
 	HTTP_REQ_RES_INVALID //during creation
 };
 
+enum HttpRangeResult {
+	HTTP_RANGE_NONE, //!< no usable Range header, serve the whole body
+	HTTP_RANGE_OK,
+	HTTP_RANGE_UNSATISFIABLE
+};
+
 
 namespace ns3 {
 
-struct CaseInsensitiveCompare{
-  bool operator()(const std::string &a, const std::string &b){return false;};
+/*
+ * A header field, as offsets into the header arena of its message.
+ */
+struct HttpHeaderField {
+	uint32_t m_name;
+	uint32_t m_nameLen;
+	uint32_t m_value;
+	uint32_t m_valueLen;
+};
+
+/*
+ * Status line and constant header fields of a response, serialized once
+ * into one contiguous buffer. A message given the template in
+ * SetHeaderTemplate() copies it as is and only serializes the fields
+ * added to the message itself, e.g. Content-Length.
+ */
+class HttpHeaderTemplate {
+public:
+	HttpHeaderTemplate(std::string version, uint16_t statusCode, std::string statusText);
+	void AddHeader(std::string name, std::string value);
+	const std::string& GetVersion() const { return m_version; }
+	uint16_t GetStatusCode() const { return m_statusCode; }
+	const std::string& GetStatusText() const { return m_statusText; }
+	const std::string& GetWire() const { return m_wire; } ///< every line ends with CRLF
+private:
+	std::string m_version;
+	uint16_t m_statusCode;
+	std::string m_statusText;
+	std::string m_wire;
 };
 
 class HttpCommonRequestResponse: public Object {
 public:
 	HttpCommonRequestResponse(HttReqResState hrrs = HTTP_REQ_RES_PARSE_L1);
 	virtual ~HttpCommonRequestResponse();
-	virtual void ParseHeader(uint8_t *buf, uint16_t len);
+	/*
+	 * Consumes header bytes and stops right after the empty line which
+	 * ends the header. Returns the number of bytes consumed, whatever
+	 * follows belongs to the body (or to the next message). Lines are
+	 * parsed in place in buf; only a line split across calls is copied.
+	 */
+	virtual uint32_t ParseHeader(const uint8_t *buf, uint32_t len);
+	virtual void AddBody(const uint8_t *buf, uint32_t len);
 	virtual void AddHeader(std::string key, std::string value);
-	virtual uint16_t ReadHeader(uint8_t *buf, uint16_t len);
-	virtual uint16_t ReadBody(uint8_t *buf, uint16_t len);
+	virtual uint32_t ReadHeader(uint8_t *buf, uint32_t len);
+	virtual uint32_t ReadBody(uint8_t *buf, uint32_t len);
 	virtual bool IsHeaderReceived();
 	virtual void EndHeader();
-	virtual std::string GetHeader(std::string name);
+	virtual std::string GetHeader(std::string name); ///< names match case-insensitively
+	bool HasHeader(std::string name);
+	uint32_t GetNumHeaders() const { return m_headers.size(); }
+	std::string GetHeaderName(uint32_t idx) const; ///< in the order they were added
+	std::string GetHeaderValue(uint32_t idx) const;
+	clen_t GetContentLength(); ///< 0 if there is no Content-Length header
+	/*
+	 * Reads a header holding a decimal number, e.g. one the peer chose.
+	 * value is 0 if the header is absent or malformed; returns false
+	 * only if it is present and not a plain unsigned number.
+	 */
+	bool GetHeaderNumber(std::string name, clen_t &value);
+	bool IsKeepAlive(); ///< false if the peer asked for Connection: close
+	/*
+	 * Back to the state right after construction. The buffers keep
+	 * their capacity, so a recycled message does not allocate again.
+	 */
+	virtual void Reset();
+	/*
+	 * The first line and constant fields come from tpl instead, which
+	 * must outlive the message. Only for outgoing messages.
+	 */
+	void SetHeaderTemplate(const HttpHeaderTemplate *tpl) { m_template = tpl; }
+	uint32_t GetHeaderSize() const; ///< serialized header bytes not read yet
 protected:
-	virtual void ProcessFirstHeaderLine(std::stringstream &) = 0;
+	virtual void ProcessFirstHeaderLine(const char *line, uint32_t len) = 0;
 	virtual void ReadFirstHeaderLine() = 0;
-	virtual void AddToHeaderBuffer(const char *buf, uint16_t len);
+	virtual void AddToHeaderBuffer(const char *buf, uint32_t len);
+	static std::string NextToken(const char *&line, uint32_t &len);
 private:
-	void ProcessHeaderLine();
+	void ProcessHeaderLine(const char *line, uint32_t len);
+	void SetHeader(const char *name, uint32_t nameLen, const char *value, uint32_t valueLen);
+	int FindHeader(const char *name, uint32_t nameLen) const;
 
-	uint8_t m_tmpbuf[2048]; //I do not expect a line to go beyond
-	uint16_t m_tmpbuflen;
+	std::string m_line; //!< header line split across ParseHeader calls
 	HttReqResState m_state;
-	std::queue<std::pair<char *, uint16_t> > m_body;
-	std::queue<std::pair<char *, uint16_t> > m_request;
+	HttReqResState m_initialState;
+	const HttpHeaderTemplate *m_template;
+	HttpRingBuffer m_body;
+	HttpRingBuffer m_request;
 
 	//=============
-	std::map<std::string, std::string> m_headers;
+	std::string m_headerArena; //!< names and values back to back
+	std::vector<HttpHeaderField> m_headers; //!< in insertion order
 
 };
 }
@@ -72,9 +140,21 @@ public:
 	const std::string& getMethod() const;
 	const std::string& GetPath() const;
 	const std::string& GetVersion() const;
+	/*
+	 * Asks for bytes first to last (inclusive) of the body, last may be
+	 * HTTP_RANGE_END for everything from first on.
+	 */
+	void SetRange(clen_t first, clen_t last = HTTP_RANGE_END);
+	/*
+	 * Resolves the Range header against a body of total bytes into the
+	 * inclusive [first, last]. Only a single "bytes=" range is
+	 * understood, anything else is ignored as the RFC allows.
+	 */
+	HttpRangeResult GetRange(clen_t total, clen_t &first, clen_t &last);
+	virtual void Reset();
 
 protected:
-	virtual void ProcessFirstHeaderLine(std::stringstream &ss);
+	virtual void ProcessFirstHeaderLine(const char *line, uint32_t len);
 	virtual void ReadFirstHeaderLine();
 private:
 
@@ -99,15 +179,20 @@ public:
 	~HttpResponse();
 
 
-	uint8_t GetStatusCode() const;
+	uint16_t GetStatusCode() const;
 	const std::string& GetStatusText() const;
 	const std::string& GetVersion() const;
 	void SetStatusCode(uint16_t mStatusCode);
 	void SetStatusText(const std::string &mStatusText);
 	void SetVersion(const std::string &mVersion);
+	/*
+	 * Content-Range of a 206 (or, with first > last, of a 416) response.
+	 */
+	void SetContentRange(clen_t first, clen_t last, clen_t total);
+	bool GetContentRange(clen_t &first, clen_t &last, clen_t &total);
 
 protected:
-	virtual void ProcessFirstHeaderLine(std::stringstream &ss);
+	virtual void ProcessFirstHeaderLine(const char *line, uint32_t len);
 	virtual void ReadFirstHeaderLine();
 private:
 //==============================================
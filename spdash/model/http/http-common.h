@@ -14,6 +14,8 @@ namespace ns3 {
 
 typedef uint64_t clen_t;
 
+#define HTTP_RANGE_END ((clen_t) -1) //!< last byte of an open ended range
+
 
 }
 
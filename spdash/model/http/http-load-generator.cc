@@ -0,0 +1,300 @@
+/*
+ * http-load-generator.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-load-generator.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/pointer.h"
+#include "ns3/nstime.h"
+#include "ns3/tcp-socket-factory.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpLoadGenerator");
+NS_OBJECT_ENSURE_REGISTERED(HttpLoadGenerator);
+
+TypeId HttpLoadGenerator::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpLoadGenerator")
+			.SetParent<Application>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpLoadGenerator>()
+			.AddAttribute("RemoteAddress",
+					"Server address",
+					AddressValue(),
+					MakeAddressAccessor(&HttpLoadGenerator::m_peerAddress),
+					MakeAddressChecker())
+			.AddAttribute("RemotePort",
+					"Server port",
+					UintegerValue(9),
+					MakeUintegerAccessor(&HttpLoadGenerator::m_peerPort),
+					MakeUintegerChecker<uint16_t>())
+			.AddAttribute("Path",
+					"Path of every request",
+					StringValue("/load"),
+					MakeStringAccessor(&HttpLoadGenerator::m_path),
+					MakeStringChecker())
+			.AddAttribute("InterArrivalTime",
+					"Seconds between two arrivals, exponential for Poisson arrivals",
+					StringValue("ns3::ExponentialRandomVariable[Mean=0.1]"),
+					MakePointerAccessor(&HttpLoadGenerator::m_interArrival),
+					MakePointerChecker<RandomVariableStream>())
+			.AddAttribute("ArrivalTrace",
+					"Text file of arrival times in seconds since the start, replaces InterArrivalTime",
+					StringValue(""),
+					MakeStringAccessor(&HttpLoadGenerator::m_arrivalTrace),
+					MakeStringChecker())
+			.AddAttribute("ResponseSize",
+					"Body bytes asked for by a request",
+					StringValue("ns3::ConstantRandomVariable[Constant=100000]"),
+					MakePointerAccessor(&HttpLoadGenerator::m_responseSize),
+					MakePointerChecker<RandomVariableStream>())
+			.AddAttribute("MaxRequests",
+					"Number of arrivals, 0 for no limit",
+					UintegerValue(0),
+					MakeUintegerAccessor(&HttpLoadGenerator::m_maxRequests),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute("MaxConnections",
+					"Requests in flight at a time, each on its own connection",
+					UintegerValue(8),
+					MakeUintegerAccessor(&HttpLoadGenerator::m_maxConnections),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("MaxBacklog",
+					"Arrivals waiting for a connection before more are dropped, 0 for no limit",
+					UintegerValue(0),
+					MakeUintegerAccessor(&HttpLoadGenerator::m_maxBacklog),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute("Timeout",
+					"A request not answered this long after it was sent fails, negative for never",
+					TimeValue(Seconds(-1)),
+					MakeTimeAccessor(&HttpLoadGenerator::m_timeout),
+					MakeTimeChecker())
+			.AddAttribute("SocketFactory",
+					"TypeId of the socket factory connections are opened with",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&HttpLoadGenerator::m_socketFactory),
+					MakeTypeIdChecker())
+			.AddAttribute("LatencyFile",
+					"Where to write one line per request at stop, empty for none",
+					StringValue(""),
+					MakeStringAccessor(&HttpLoadGenerator::m_latencyFile),
+					MakeStringChecker());
+	return tid;
+}
+
+HttpLoadGenerator::HttpLoadGenerator(): m_peerPort(0), m_maxRequests(0),
+		m_maxConnections(8), m_maxBacklog(0), m_timeout(Seconds(-1)),
+		m_socketFactory(TcpSocketFactory::GetTypeId()), m_running(false),
+		m_nextArrival(0), m_numArrived(0), m_nextId(0), m_numFailed(0),
+		m_numDropped(0) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpLoadGenerator::~HttpLoadGenerator() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpLoadGenerator::DoDispose() {
+	NS_LOG_FUNCTION(this);
+	m_clientPool = 0;
+	m_inFlight.clear();
+	m_backlog.clear();
+	m_interArrival = 0;
+	m_responseSize = 0;
+	Application::DoDispose();
+}
+
+uint32_t HttpLoadGenerator::GetNumCompleted() const {
+	return m_records.size() - m_numFailed;
+}
+
+uint32_t HttpLoadGenerator::GetNumFailed() const {
+	return m_numFailed;
+}
+
+uint32_t HttpLoadGenerator::GetNumDropped() const {
+	return m_numDropped;
+}
+
+/*
+ * Nearest rank over the completed requests, zero if there are none.
+ */
+Time HttpLoadGenerator::GetLatencyPercentile(double percentile) const {
+	std::vector<Time> latencies;
+	for(auto &it : m_records) {
+		if(it.m_ok)
+			latencies.push_back(it.m_done - it.m_arrival);
+	}
+	if(latencies.empty())
+		return Time(0);
+	percentile = std::min(std::max(percentile, 0.0), 100.0);
+	size_t rank = std::ceil(percentile / 100 * latencies.size());
+	rank = std::max(rank, (size_t) 1) - 1;
+	std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+	return latencies[rank];
+}
+
+void HttpLoadGenerator::StartApplication() {
+	NS_LOG_FUNCTION(this);
+	m_running = true;
+	m_startedAt = Simulator::Now();
+	m_clientPool = CreateObject<HttpClientPool>();
+	m_clientPool->SetAttribute("MaxConnections", UintegerValue(m_maxConnections));
+	m_clientPool->SetAttribute("MaxIdle", UintegerValue(m_maxConnections));
+	m_clientPool->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+	m_clientPool->SetNode(GetNode());
+	if(!m_arrivalTrace.empty() && !LoadArrivalTrace()) {
+		NS_LOG_ERROR("Cannot read arrival trace " << m_arrivalTrace);
+		return;
+	}
+	ScheduleNextArrival();
+}
+
+void HttpLoadGenerator::StopApplication() {
+	NS_LOG_FUNCTION(this);
+	if(!m_running) return;
+	m_running = false;
+	m_arrivalEvent.Cancel();
+	m_backlog.clear();
+	m_inFlight.clear(); //their callbacks are not counted
+	if(m_clientPool != 0)
+		m_clientPool->StopAll();
+
+	NS_LOG_INFO("Node " << GetNode()->GetId() << ": " << GetNumCompleted() << " completed, "
+			<< m_numFailed << " failed, " << m_numDropped << " dropped, latency p50 "
+			<< GetLatencyPercentile(50).GetSeconds() << "s p90 "
+			<< GetLatencyPercentile(90).GetSeconds() << "s p99 "
+			<< GetLatencyPercentile(99).GetSeconds() << "s");
+	if(!m_latencyFile.empty())
+		WriteLatencies();
+}
+
+bool HttpLoadGenerator::LoadArrivalTrace() {
+	NS_LOG_FUNCTION(this << m_arrivalTrace);
+	std::ifstream inFile(m_arrivalTrace.c_str());
+	if(!inFile.is_open())
+		return false;
+	double at;
+	while(inFile >> at) {
+		m_arrivals.push_back(Seconds(at));
+	}
+	std::sort(m_arrivals.begin(), m_arrivals.end());
+	m_nextArrival = 0;
+	return true;
+}
+
+void HttpLoadGenerator::ScheduleNextArrival() {
+	if(!m_running) return;
+	if(m_maxRequests && m_numArrived >= m_maxRequests)
+		return;
+	Time delay;
+	if(!m_arrivalTrace.empty()) {
+		if(m_nextArrival >= m_arrivals.size())
+			return;
+		Time at = m_startedAt + m_arrivals[m_nextArrival++];
+		delay = std::max(at - Simulator::Now(), Time(0));
+	} else {
+		delay = Seconds(m_interArrival->GetValue());
+	}
+	m_arrivalEvent = Simulator::Schedule(delay, &HttpLoadGenerator::Arrival, this);
+}
+
+void HttpLoadGenerator::Arrival() {
+	NS_LOG_FUNCTION(this);
+	if(!m_running) return;
+	m_numArrived++;
+	ScheduleNextArrival();
+
+	if(m_maxBacklog && m_backlog.size() >= m_maxBacklog) {
+		m_numDropped++;
+		NS_LOG_LOGIC("Backlog full, arrival dropped");
+		return;
+	}
+	LoadRequest request;
+	request.m_id = m_nextId++;
+	request.m_size = std::max(m_responseSize->GetValue(), 0.0);
+	request.m_arrival = Simulator::Now();
+	m_backlog.push_back(request);
+	Dispatch();
+}
+
+void HttpLoadGenerator::Dispatch() {
+	NS_LOG_FUNCTION(this);
+	while(m_running && !m_backlog.empty()) {
+		Ptr<HttpClientBasic> client = m_clientPool->Acquire(m_peerAddress, m_peerPort);
+		if(client == 0)
+			break; //tried again after the next response
+		LoadRequest request = m_backlog.front();
+		m_backlog.pop_front();
+		request.m_sent = Simulator::Now();
+		request.m_client = client;
+
+		client->SetCollectionCB(MakeCallback(&HttpLoadGenerator::RequestDoneCB, this).Bind(request.m_id), GetNode());
+		client->SetTimeout(m_timeout);
+		client->InitConnection(m_peerAddress, m_peerPort, m_path + "-" + std::to_string(request.m_id));
+		client->AddReqHeader("X-Require-Length", std::to_string(request.m_size));
+		client->Connect();
+		m_inFlight[request.m_id] = request;
+	}
+}
+
+void HttpLoadGenerator::RequestDoneCB(uint32_t id) {
+	NS_LOG_FUNCTION(this << id);
+	auto it = m_inFlight.find(id);
+	if(it == m_inFlight.end())
+		return;
+	LoadRecord record;
+	record.m_arrival = it->second.m_arrival;
+	record.m_sent = it->second.m_sent;
+	record.m_done = Simulator::Now();
+	record.m_size = it->second.m_size;
+	record.m_ok = !it->second.m_client->WasAborted();
+	if(!record.m_ok)
+		m_numFailed++;
+	m_records.push_back(record);
+	m_finished.push_back(id);
+	Simulator::ScheduleNow(&HttpLoadGenerator::RequestDone, this);
+}
+
+void HttpLoadGenerator::RequestDone() {
+	NS_LOG_FUNCTION(this);
+	for(auto id : m_finished) {
+		auto it = m_inFlight.find(id);
+		if(it == m_inFlight.end())
+			continue;
+		if(m_clientPool != 0)
+			m_clientPool->Release(it->second.m_client);
+		m_inFlight.erase(it);
+	}
+	m_finished.clear();
+	Dispatch();
+}
+
+/*
+ * One line per request: arrival, sent and done time in seconds, bytes
+ * asked for and 1 if it completed.
+ */
+void HttpLoadGenerator::WriteLatencies() const {
+	NS_LOG_FUNCTION(this);
+	std::ofstream outFile(m_latencyFile.c_str(), std::ofstream::out | std::ofstream::trunc);
+	if(!outFile.is_open()) {
+		NS_LOG_ERROR("Cannot write " << m_latencyFile);
+		return;
+	}
+	outFile << "arrival sent done bytes ok\n";
+	for(auto &it : m_records) {
+		outFile << it.m_arrival.GetSeconds() << " " << it.m_sent.GetSeconds() << " "
+				<< it.m_done.GetSeconds() << " " << it.m_size << " " << it.m_ok << "\n";
+	}
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,111 @@
+/*
+ * http-load-generator.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_LOAD_GENERATOR_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_LOAD_GENERATOR_H_
+
+#include "http-client-pool.h"
+#include "ns3/application.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/event-id.h"
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * \brief Open loop http workload. Requests arrive on their own schedule,
+ *        not when the previous one finished as with HttpClientCollection:
+ *        the gaps are drawn from InterArrivalTime (exponential, i.e.
+ *        Poisson arrivals, by default) or, with ArrivalTrace, read from a
+ *        text file of arrival times in seconds since the start, one per
+ *        line. Every request asks for a body of ResponseSize bytes through
+ *        X-Require-Length, so the server should run DashRequestHandler.
+ *
+ *        Up to MaxConnections requests are in flight on as many keep-alive
+ *        connections; the others wait in a backlog, at most MaxBacklog of
+ *        them (0 for no limit) before arrivals are dropped. The latency of
+ *        a request counts from its arrival, so it includes the wait in the
+ *        backlog. Latencies of completed requests are kept for the
+ *        percentiles, logged at stop, and written to LatencyFile if set.
+ */
+class HttpLoadGenerator: public Application {
+public:
+	static TypeId GetTypeId(void);
+	HttpLoadGenerator();
+	virtual ~HttpLoadGenerator();
+
+	uint32_t GetNumCompleted() const;
+	uint32_t GetNumFailed() const; ///< aborted or timed out
+	uint32_t GetNumDropped() const; ///< backlog was full
+	Time GetLatencyPercentile(double percentile) const; ///< of completed requests, 0 to 100
+
+protected:
+	virtual void DoDispose();
+
+private:
+	struct LoadRequest {
+		LoadRequest(): m_id(0), m_size(0) {}
+		uint32_t m_id;
+		clen_t m_size;
+		Time m_arrival;
+		Time m_sent;
+		Ptr<HttpClientBasic> m_client;
+	};
+
+	struct LoadRecord {
+		Time m_arrival;
+		Time m_sent;
+		Time m_done;
+		clen_t m_size;
+		bool m_ok;
+	};
+
+	virtual void StartApplication();
+	virtual void StopApplication();
+
+	bool LoadArrivalTrace();
+	void ScheduleNextArrival();
+	void Arrival();
+	void Dispatch();
+	void RequestDoneCB(uint32_t id);
+	void RequestDone();
+	void WriteLatencies() const;
+
+	Address m_peerAddress; //!< Remote peer address
+	uint16_t m_peerPort; //!< Remote peer port
+	std::string m_path;
+	Ptr<RandomVariableStream> m_interArrival;
+	Ptr<RandomVariableStream> m_responseSize;
+	std::string m_arrivalTrace;
+	uint32_t m_maxRequests;
+	uint32_t m_maxConnections;
+	uint32_t m_maxBacklog;
+	Time m_timeout;
+	TypeId m_socketFactory;
+	std::string m_latencyFile;
+
+	bool m_running;
+	Time m_startedAt;
+	EventId m_arrivalEvent;
+	std::vector<Time> m_arrivals; //!< from ArrivalTrace
+	uint32_t m_nextArrival;
+	uint32_t m_numArrived;
+	uint32_t m_nextId;
+	Ptr<HttpClientPool> m_clientPool;
+	std::deque<LoadRequest> m_backlog;
+	std::map<uint32_t, LoadRequest> m_inFlight;
+	std::vector<uint32_t> m_finished; //!< ids whose callback ran, released by RequestDone
+	std::vector<LoadRecord> m_records;
+	uint32_t m_numFailed;
+	uint32_t m_numDropped;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_LOAD_GENERATOR_H_ */
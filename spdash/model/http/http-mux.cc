@@ -0,0 +1,694 @@
+/*
+ * http-mux.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-mux.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/tcp-socket-factory.h"
+#include <algorithm>
+
+#define HTTP_MUX_DEFAULT_PRIORITY 16
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpMux");
+
+/**************************************************
+ *               Http Mux Frame Header            *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpMuxFrameHeader);
+
+TypeId HttpMuxFrameHeader::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpMuxFrameHeader")
+			.SetParent<Header>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpMuxFrameHeader>();
+	return tid;
+}
+
+HttpMuxFrameHeader::HttpMuxFrameHeader(): m_length(0), m_type(HTTP_MUX_FRAME_DATA),
+		m_flags(0), m_streamId(0) {
+}
+
+TypeId HttpMuxFrameHeader::GetInstanceTypeId(void) const {
+	return GetTypeId();
+}
+
+uint32_t HttpMuxFrameHeader::GetSerializedSize(void) const {
+	return HTTP_MUX_FRAME_HEADER_SIZE;
+}
+
+void HttpMuxFrameHeader::Serialize(Buffer::Iterator start) const {
+	start.WriteU8((m_length >> 16) & 0xff);
+	start.WriteHtonU16(m_length & 0xffff);
+	start.WriteU8(m_type);
+	start.WriteU8(m_flags);
+	start.WriteHtonU32(m_streamId);
+}
+
+uint32_t HttpMuxFrameHeader::Deserialize(Buffer::Iterator start) {
+	m_length = start.ReadU8() << 16;
+	m_length |= start.ReadNtohU16();
+	m_type = start.ReadU8();
+	m_flags = start.ReadU8();
+	m_streamId = start.ReadNtohU32();
+	return HTTP_MUX_FRAME_HEADER_SIZE;
+}
+
+void HttpMuxFrameHeader::Print(std::ostream &os) const {
+	os << "type=" << (uint32_t) m_type << " flags=" << (uint32_t) m_flags
+			<< " stream=" << m_streamId << " length=" << m_length;
+}
+
+/**************************************************
+ *                 Http Mux Stream                *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpMuxStream);
+
+TypeId HttpMuxStream::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpMuxStream")
+			.SetParent<Socket>()
+			.SetGroupName("Applications");
+	return tid;
+}
+
+HttpMuxStream::HttpMuxStream(): m_id(0), m_priority(HTTP_MUX_DEFAULT_PRIORITY),
+		m_connecting(false), m_sendClosed(false), m_finSent(false), m_finReceived(false),
+		m_errno(ERROR_NOTERROR), m_txSize(0), m_txBufferSize(0), m_sendWindow(0),
+		m_rxSize(0), m_consumed(0) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpMuxStream::~HttpMuxStream() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpMuxStream::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	m_conn = 0;
+	m_txQueue.clear();
+	m_rxQueue.clear();
+	Socket::DoDispose();
+}
+
+uint32_t HttpMuxStream::GetStreamId() const {
+	return m_id;
+}
+
+void HttpMuxStream::SetPriority(uint8_t priority) {
+	NS_LOG_FUNCTION(this << (uint32_t) priority);
+	if(priority == m_priority)
+		return;
+	m_priority = priority;
+	if(m_conn != 0)
+		m_conn->SendControl(HTTP_MUX_FRAME_PRIORITY, m_id, priority, 1);
+}
+
+uint8_t HttpMuxStream::GetPriority() const {
+	return m_priority;
+}
+
+enum Socket::SocketErrno HttpMuxStream::GetErrno(void) const {
+	return m_errno;
+}
+
+enum Socket::SocketType HttpMuxStream::GetSocketType(void) const {
+	return NS3_SOCK_STREAM;
+}
+
+Ptr<Node> HttpMuxStream::GetNode(void) const {
+	return m_conn != 0 ? m_conn->m_node : Ptr<Node>();
+}
+
+int HttpMuxStream::Bind(const Address &address) {
+	return 0; //bound by the connection
+}
+
+int HttpMuxStream::Bind() {
+	return 0;
+}
+
+int HttpMuxStream::Bind6() {
+	return 0;
+}
+
+int HttpMuxStream::Close(void) {
+	NS_LOG_FUNCTION(this << m_id);
+	if(m_conn == 0)
+		return 0;
+	Ptr<HttpMuxStream> self = this;
+	Ptr<HttpMuxConnection> conn = m_conn;
+	if(m_rxSize > 0) {
+		//closing with unread data resets, like tcp
+		conn->SendControl(HTTP_MUX_FRAME_RST_STREAM, m_id, 0, 0);
+		conn->StreamDone(this);
+		return 0;
+	}
+	return ShutdownSend();
+}
+
+int HttpMuxStream::ShutdownSend(void) {
+	NS_LOG_FUNCTION(this);
+	if(m_conn == 0 || m_sendClosed)
+		return 0;
+	m_sendClosed = true;
+	m_conn->SendFrames();
+	return 0;
+}
+
+int HttpMuxStream::ShutdownRecv(void) {
+	return 0;
+}
+
+int HttpMuxStream::Connect(const Address &address) {
+	NS_LOG_FUNCTION(this << address);
+	if(m_conn == 0) {
+		m_errno = ERROR_NOTCONN;
+		return -1;
+	}
+	m_connecting = true;
+	if(m_conn->m_connected)
+		Simulator::ScheduleNow(&HttpMuxStream::Connected, Ptr<HttpMuxStream>(this));
+	return 0;
+}
+
+int HttpMuxStream::Listen(void) {
+	m_errno = ERROR_OPNOTSUPP;
+	return -1;
+}
+
+uint32_t HttpMuxStream::GetTxAvailable(void) const {
+	if(m_conn == 0 || m_sendClosed || m_txSize >= m_txBufferSize)
+		return 0;
+	return m_txBufferSize - m_txSize;
+}
+
+int HttpMuxStream::Send(Ptr<Packet> p, uint32_t flags) {
+	NS_LOG_FUNCTION(this << p->GetSize());
+	if(m_conn == 0 || m_sendClosed) {
+		m_errno = ERROR_SHUTDOWN;
+		return -1;
+	}
+	if(p->GetSize() > GetTxAvailable()) {
+		m_errno = ERROR_MSGSIZE;
+		return -1;
+	}
+	uint32_t len = p->GetSize();
+	if(len == 0)
+		return 0;
+	m_txQueue.push_back(p->Copy()); //the frames are cut out of it
+	m_txSize += len;
+	m_conn->SendFrames();
+	return len;
+}
+
+int HttpMuxStream::SendTo(Ptr<Packet> p, uint32_t flags, const Address &toAddress) {
+	return Send(p, flags);
+}
+
+uint32_t HttpMuxStream::GetRxAvailable(void) const {
+	return m_rxSize;
+}
+
+Ptr<Packet> HttpMuxStream::Recv(uint32_t maxSize, uint32_t flags) {
+	NS_LOG_FUNCTION(this << maxSize);
+	if(m_rxQueue.empty() || maxSize == 0) {
+		m_errno = ERROR_AGAIN;
+		return 0;
+	}
+	Ptr<Packet> packet = m_rxQueue.front();
+	if(packet->GetSize() > maxSize) {
+		Ptr<Packet> part = packet->CreateFragment(0, maxSize);
+		packet->RemoveAtStart(maxSize);
+		packet = part;
+	} else {
+		m_rxQueue.pop_front();
+	}
+	m_rxSize -= packet->GetSize();
+	m_consumed += packet->GetSize();
+	//give the credit back once half the window is read
+	if(m_conn != 0 && !m_finReceived && m_consumed >= m_conn->m_initialWindow / 2) {
+		m_conn->SendControl(HTTP_MUX_FRAME_WINDOW_UPDATE, m_id, m_consumed, 4);
+		m_consumed = 0;
+	}
+	return packet;
+}
+
+Ptr<Packet> HttpMuxStream::RecvFrom(uint32_t maxSize, uint32_t flags, Address &fromAddress) {
+	GetPeerName(fromAddress);
+	return Recv(maxSize, flags);
+}
+
+int HttpMuxStream::GetSockName(Address &address) const {
+	if(m_conn == 0 || m_conn->m_socket == 0) {
+		return -1;
+	}
+	return m_conn->m_socket->GetSockName(address);
+}
+
+int HttpMuxStream::GetPeerName(Address &address) const {
+	if(m_conn == 0 || m_conn->m_socket == 0) {
+		return -1;
+	}
+	return m_conn->m_socket->GetPeerName(address);
+}
+
+bool HttpMuxStream::SetAllowBroadcast(bool allowBroadcast) {
+	return !allowBroadcast;
+}
+
+bool HttpMuxStream::GetAllowBroadcast() const {
+	return false;
+}
+
+bool HttpMuxStream::HasFrameToSend() const {
+	if(m_txSize > 0)
+		return m_sendWindow > 0;
+	return m_sendClosed && !m_finSent;
+}
+
+void HttpMuxStream::Received(Ptr<Packet> data, bool endStream) {
+	NS_LOG_FUNCTION(this << m_id << data->GetSize() << endStream);
+	Ptr<HttpMuxStream> self = this;
+	if(m_sendClosed && data->GetSize() > 0) {
+		//data for a stream we are done with, tell the peer to stop
+		Ptr<HttpMuxConnection> conn = m_conn;
+		conn->SendControl(HTTP_MUX_FRAME_RST_STREAM, m_id, 0, 0);
+		conn->StreamDone(this);
+		return;
+	}
+	if(data->GetSize() > 0) {
+		m_rxQueue.push_back(data);
+		m_rxSize += data->GetSize();
+		NotifyDataRecv();
+	}
+	if(!endStream || m_conn == 0)
+		return;
+	m_finReceived = true;
+	if(m_finSent)
+		m_conn->StreamDone(this);
+	NotifyNormalClose();
+}
+
+void HttpMuxStream::Reset() {
+	NS_LOG_FUNCTION(this << m_id);
+	m_conn = 0;
+	m_txQueue.clear();
+	m_txSize = 0;
+	m_errno = ERROR_SHUTDOWN;
+	NotifyErrorClose();
+}
+
+void HttpMuxStream::Connected() {
+	NS_LOG_FUNCTION(this << m_id);
+	if(!m_connecting || m_conn == 0)
+		return;
+	m_connecting = false;
+	NotifyConnectionSucceeded();
+}
+
+void HttpMuxStream::ConnectFailed() {
+	NS_LOG_FUNCTION(this << m_id);
+	m_conn = 0;
+	m_connecting = false;
+	m_errno = ERROR_NOROUTETOHOST;
+	NotifyConnectionFailed();
+}
+
+/**************************************************
+ *               Http Mux Connection              *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpMuxConnection);
+
+TypeId HttpMuxConnection::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpMuxConnection")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpMuxConnection>()
+			.AddAttribute("InitialWindow",
+					"Bytes of a stream the receiver accepts before it returns credit",
+					UintegerValue(65535),
+					MakeUintegerAccessor(&HttpMuxConnection::m_initialWindow),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("MaxFrameSize",
+					"Largest DATA frame payload, smaller frames interleave streams more finely",
+					UintegerValue(16384),
+					MakeUintegerAccessor(&HttpMuxConnection::m_maxFrameSize),
+					MakeUintegerChecker<uint32_t>(1, 0xffffff))
+			.AddAttribute("StreamBufferSize",
+					"Send buffer of each stream",
+					UintegerValue(131072),
+					MakeUintegerAccessor(&HttpMuxConnection::m_streamBufferSize),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("SocketFactory",
+					"TypeId of the socket factory the connection is opened with",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&HttpMuxConnection::m_socketFactory),
+					MakeTypeIdChecker());
+	return tid;
+}
+
+HttpMuxConnection::HttpMuxConnection(): m_peerPort(0), m_connected(false), m_sending(false),
+		m_nextStreamId(1), m_lastServed(0), m_lastPeerStream(0), m_initialWindow(65535), m_maxFrameSize(16384),
+		m_streamBufferSize(131072), m_socketFactory(TcpSocketFactory::GetTypeId()) {
+	NS_LOG_FUNCTION(this);
+	m_rxBuffer = Create<Packet>();
+}
+
+HttpMuxConnection::~HttpMuxConnection() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpMuxConnection::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	Close();
+	m_node = 0;
+	m_acceptStream = MakeNullCallback<void, Ptr<Socket> >();
+	Object::DoDispose();
+}
+
+void HttpMuxConnection::Connect(Ptr<Node> node, Address peerAddress, uint16_t peerPort) {
+	NS_LOG_FUNCTION(this << peerAddress << peerPort);
+	m_node = node;
+	m_peerAddress = peerAddress;
+	m_peerPort = peerPort;
+	m_nextStreamId = 1;
+	OpenSocket();
+}
+
+void HttpMuxConnection::Accept(Ptr<Socket> socket) {
+	NS_LOG_FUNCTION(this << socket);
+	m_socket = socket;
+	m_node = socket->GetNode();
+	m_nextStreamId = 2;
+	m_connected = true;
+	SetSocketCallbacks();
+}
+
+void HttpMuxConnection::SetAcceptStreamCallback(Callback<void, Ptr<Socket> > cb) {
+	m_acceptStream = cb;
+}
+
+Ptr<HttpMuxStream> HttpMuxConnection::OpenStream() {
+	NS_LOG_FUNCTION(this);
+	if(m_socket == 0)
+		OpenSocket(); //the connection broke since, start over
+	Ptr<HttpMuxStream> stream = CreateObject<HttpMuxStream>();
+	stream->m_conn = this;
+	stream->m_id = m_nextStreamId;
+	stream->m_sendWindow = m_initialWindow;
+	stream->m_txBufferSize = m_streamBufferSize;
+	m_nextStreamId += 2;
+	m_streams[stream->m_id] = stream;
+	return stream;
+}
+
+bool HttpMuxConnection::IsConnectedTo(const Address &peerAddress, uint16_t peerPort) const {
+	return m_peerAddress == peerAddress && m_peerPort == peerPort;
+}
+
+bool HttpMuxConnection::IsOpen() const {
+	return m_socket != 0;
+}
+
+uint32_t HttpMuxConnection::GetNumStreams() const {
+	return m_streams.size();
+}
+
+void HttpMuxConnection::Close() {
+	NS_LOG_FUNCTION(this);
+	Ptr<HttpMuxConnection> self = this;
+	if(m_socket != 0)
+		DropSocket();
+	std::map<uint32_t, Ptr<HttpMuxStream> > streams;
+	std::swap(streams, m_streams);
+	for(auto &it : streams) {
+		it.second->Reset();
+	}
+}
+
+void HttpMuxConnection::OpenSocket() {
+	NS_LOG_FUNCTION(this);
+	NS_ASSERT(m_node != 0);
+	m_socket = Socket::CreateSocket(m_node, m_socketFactory);
+	m_connected = false;
+	m_socket->SetConnectCallback(
+			MakeCallback(&HttpMuxConnection::EvConnectionSucceeded, this),
+			MakeCallback(&HttpMuxConnection::EvConnectionFailed, this));
+	SetSocketCallbacks();
+	if (Ipv4Address::IsMatchingType(m_peerAddress) == true) {
+		m_socket->Connect(
+				InetSocketAddress(Ipv4Address::ConvertFrom(m_peerAddress),
+						m_peerPort));
+	} else if (Ipv6Address::IsMatchingType(m_peerAddress) == true) {
+		m_socket->Connect(
+				Inet6SocketAddress(Ipv6Address::ConvertFrom(m_peerAddress),
+						m_peerPort));
+	}
+}
+
+void HttpMuxConnection::SetSocketCallbacks() {
+	m_socket->SetRecvCallback(MakeCallback(&HttpMuxConnection::EvHandleRecv, this));
+	m_socket->SetSendCallback(MakeCallback(&HttpMuxConnection::EvHandleSend, this));
+	m_socket->SetCloseCallbacks(MakeCallback(&HttpMuxConnection::EvSocketClosed, this),
+			MakeCallback(&HttpMuxConnection::EvSocketClosed, this));
+}
+
+void HttpMuxConnection::DropSocket() {
+	NS_LOG_FUNCTION(this);
+	m_socket->SetConnectCallback(
+			MakeNullCallback<void, Ptr<Socket> >(),
+			MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t >());
+	m_socket->SetCloseCallbacks(
+			MakeNullCallback<void, Ptr<Socket> >(),
+			MakeNullCallback<void, Ptr<Socket> >());
+	m_socket->Close();
+	m_socket = 0;
+	m_connected = false;
+	m_control.clear();
+	m_rxBuffer = Create<Packet>();
+}
+
+void HttpMuxConnection::EvConnectionSucceeded(Ptr<Socket> socket) {
+	NS_LOG_FUNCTION(this << socket);
+	m_connected = true;
+	std::vector<Ptr<HttpMuxStream> > streams;
+	for(auto &it : m_streams) {
+		streams.push_back(it.second);
+	}
+	for(auto &stream : streams) {
+		stream->Connected();
+	}
+	SendFrames();
+}
+
+void HttpMuxConnection::EvConnectionFailed(Ptr<Socket> socket) {
+	NS_LOG_FUNCTION(this << socket);
+	Ptr<HttpMuxConnection> self = this;
+	DropSocket();
+	std::map<uint32_t, Ptr<HttpMuxStream> > streams;
+	std::swap(streams, m_streams);
+	for(auto &it : streams) {
+		it.second->ConnectFailed();
+	}
+}
+
+void HttpMuxConnection::EvSocketClosed(Ptr<Socket> socket) {
+	NS_LOG_FUNCTION(this << socket);
+	NS_LOG_LOGIC("Mux connection closed with " << m_streams.size() << " streams open");
+	Close();
+}
+
+void HttpMuxConnection::EvHandleSend(Ptr<Socket> socket, uint32_t txSpace) {
+	NS_LOG_FUNCTION(this << socket);
+	SendFrames();
+}
+
+void HttpMuxConnection::EvHandleRecv(Ptr<Socket> socket) {
+	NS_LOG_FUNCTION(this << socket);
+	Ptr<HttpMuxConnection> self = this;
+	Ptr<Packet> packet;
+	while(m_socket == socket && (packet = socket->Recv())) {
+		m_rxBuffer->AddAtEnd(packet);
+		HttpMuxFrameHeader header;
+		while(m_socket == socket && m_rxBuffer->GetSize() >= HTTP_MUX_FRAME_HEADER_SIZE) {
+			m_rxBuffer->PeekHeader(header);
+			if(m_rxBuffer->GetSize() < HTTP_MUX_FRAME_HEADER_SIZE + header.m_length)
+				break;
+			m_rxBuffer->RemoveHeader(header);
+			Ptr<Packet> payload = m_rxBuffer->CreateFragment(0, header.m_length);
+			m_rxBuffer->RemoveAtStart(header.m_length);
+			ProcessFrame(header, payload);
+		}
+	}
+}
+
+void HttpMuxConnection::ProcessFrame(const HttpMuxFrameHeader &header, Ptr<Packet> payload) {
+	NS_LOG_FUNCTION(this << (uint32_t) header.m_type << header.m_streamId << header.m_length);
+	uint8_t buf[4] = {0, 0, 0, 0};
+	payload->CopyData(buf, sizeof(buf));
+
+	auto it = m_streams.find(header.m_streamId);
+	Ptr<HttpMuxStream> stream = it == m_streams.end() ? Ptr<HttpMuxStream>() : it->second;
+	bool peerStream = (header.m_streamId & 1) != (m_nextStreamId & 1);
+	if(stream == 0 && peerStream && header.m_streamId > m_lastPeerStream
+			&& (header.m_type == HTTP_MUX_FRAME_DATA || header.m_type == HTTP_MUX_FRAME_PRIORITY)
+			&& !m_acceptStream.IsNull()) {
+		//first frame of a stream the peer opened
+		stream = CreateObject<HttpMuxStream>();
+		stream->m_conn = this;
+		stream->m_id = header.m_streamId;
+		stream->m_sendWindow = m_initialWindow;
+		stream->m_txBufferSize = m_streamBufferSize;
+		m_streams[stream->m_id] = stream;
+		m_lastPeerStream = stream->m_id;
+		m_acceptStream(stream);
+	}
+	if(stream == 0) {
+		if(header.m_type == HTTP_MUX_FRAME_DATA)
+			SendControl(HTTP_MUX_FRAME_RST_STREAM, header.m_streamId, 0, 0);
+		return;
+	}
+
+	switch(header.m_type) {
+	case HTTP_MUX_FRAME_DATA:
+		stream->Received(payload, header.m_flags & HTTP_MUX_FLAG_END_STREAM);
+		break;
+	case HTTP_MUX_FRAME_WINDOW_UPDATE:
+		stream->m_sendWindow += (buf[0] << 24) | (buf[1] << 16) | (buf[2] << 8) | buf[3];
+		SendFrames();
+		break;
+	case HTTP_MUX_FRAME_PRIORITY:
+		stream->m_priority = buf[0];
+		break;
+	case HTTP_MUX_FRAME_RST_STREAM:
+		StreamDone(stream);
+		stream->Reset();
+		break;
+	default:
+		NS_LOG_WARN("Ignoring frame of unknown type " << (uint32_t) header.m_type);
+	}
+}
+
+void HttpMuxConnection::SendControl(uint8_t type, uint32_t streamId, uint32_t value, uint32_t len) {
+	NS_LOG_FUNCTION(this << (uint32_t) type << streamId << value);
+	if(m_socket == 0)
+		return;
+	uint8_t buf[4];
+	for(uint32_t i = 0; i < len; i++) {
+		buf[i] = value >> (8 * (len - i - 1));
+	}
+	Ptr<Packet> frame = Create<Packet>(buf, len);
+	HttpMuxFrameHeader header;
+	header.m_length = len;
+	header.m_type = type;
+	header.m_streamId = streamId;
+	frame->AddHeader(header);
+	m_control.push_back(frame);
+	SendFrames();
+}
+
+/*
+ * Streams write from their send callbacks, which run from in here: their
+ * Send() only queues and this loop picks the data up.
+ */
+void HttpMuxConnection::SendFrames() {
+	if(m_sending || !m_connected || m_socket == 0)
+		return;
+	NS_LOG_FUNCTION(this);
+	Ptr<HttpMuxConnection> self = this;
+	m_sending = true;
+	while(m_socket != 0) {
+		if(!m_control.empty()) {
+			if(m_socket->GetTxAvailable() < m_control.front()->GetSize())
+				break;
+			m_socket->Send(m_control.front());
+			m_control.pop_front();
+			continue;
+		}
+		Ptr<HttpMuxStream> stream = NextStream();
+		uint32_t txSpace = m_socket->GetTxAvailable();
+		if(stream == 0 || txSpace <= HTTP_MUX_FRAME_HEADER_SIZE)
+			break;
+
+		uint32_t len = std::min(stream->m_txSize, m_maxFrameSize);
+		len = std::min(len, txSpace - HTTP_MUX_FRAME_HEADER_SIZE);
+		len = std::min((int64_t) len, std::max(stream->m_sendWindow, (int64_t) 0));
+		Ptr<Packet> frame = Create<Packet>();
+		for(uint32_t left = len; left > 0;) {
+			Ptr<Packet> front = stream->m_txQueue.front();
+			if(front->GetSize() <= left) {
+				frame->AddAtEnd(front);
+				left -= front->GetSize();
+				stream->m_txQueue.pop_front();
+			} else {
+				frame->AddAtEnd(front->CreateFragment(0, left));
+				front->RemoveAtStart(left);
+				left = 0;
+			}
+		}
+		stream->m_txSize -= len;
+		stream->m_sendWindow -= len;
+
+		HttpMuxFrameHeader header;
+		header.m_length = len;
+		header.m_streamId = stream->m_id;
+		if(stream->m_sendClosed && stream->m_txSize == 0) {
+			header.m_flags |= HTTP_MUX_FLAG_END_STREAM;
+			stream->m_finSent = true;
+		}
+		frame->AddHeader(header);
+		m_socket->Send(frame);
+		m_lastServed = stream->m_id;
+
+		if(stream->m_finSent) {
+			if(stream->m_finReceived)
+				StreamDone(stream);
+		} else if(len > 0) {
+			stream->NotifySend(stream->GetTxAvailable());
+		}
+	}
+	m_sending = false;
+}
+
+/*
+ * The most urgent stream with a frame to send. The search starts after
+ * the stream served last and only a strictly more urgent stream replaces
+ * the first candidate, so streams of the same priority take turns.
+ */
+Ptr<HttpMuxStream> HttpMuxConnection::NextStream() {
+	Ptr<HttpMuxStream> best;
+	auto start = m_streams.upper_bound(m_lastServed);
+	for(auto it = start; it != m_streams.end(); ++it) {
+		if(it->second->HasFrameToSend() && (!best || it->second->m_priority < best->m_priority))
+			best = it->second;
+	}
+	for(auto it = m_streams.begin(); it != start; ++it) {
+		if(it->second->HasFrameToSend() && (!best || it->second->m_priority < best->m_priority))
+			best = it->second;
+	}
+	return best;
+}
+
+void HttpMuxConnection::StreamDone(Ptr<HttpMuxStream> stream) {
+	NS_LOG_FUNCTION(this << stream->m_id);
+	m_streams.erase(stream->m_id);
+	stream->m_conn = 0;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,206 @@
+/*
+ * http-mux.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_MUX_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_MUX_H_
+
+#include "ns3/header.h"
+#include "ns3/socket.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/address.h"
+#include <deque>
+#include <map>
+
+/*
+ * Framing between two HttpMuxConnections, modelled on http/2. Every frame
+ * starts with a 9 byte header, integers big endian:
+ *
+ *   u24 length, u8 type, u8 flags, u32 stream id
+ *
+ * DATA          payload is stream bytes, END_STREAM closes the sender side
+ * WINDOW_UPDATE u32 payload, credit the receiver returns after reading
+ * PRIORITY      u8 payload, lower is more urgent
+ * RST_STREAM    no payload, the stream is dropped on both sides
+ *
+ * Streams are opened implicitly by their first frame; the connecting side
+ * uses odd ids. There is no SETTINGS exchange, both sides are expected to
+ * use the same InitialWindow.
+ */
+#define HTTP_MUX_FRAME_DATA 0
+#define HTTP_MUX_FRAME_WINDOW_UPDATE 1
+#define HTTP_MUX_FRAME_PRIORITY 2
+#define HTTP_MUX_FRAME_RST_STREAM 3
+
+#define HTTP_MUX_FLAG_END_STREAM 0x1
+
+#define HTTP_MUX_FRAME_HEADER_SIZE 9
+
+namespace ns3 {
+
+class HttpMuxConnection;
+
+class HttpMuxFrameHeader: public Header {
+public:
+	static TypeId GetTypeId(void);
+	HttpMuxFrameHeader();
+	virtual TypeId GetInstanceTypeId(void) const;
+	virtual uint32_t GetSerializedSize(void) const;
+	virtual void Serialize(Buffer::Iterator start) const;
+	virtual uint32_t Deserialize(Buffer::Iterator start);
+	virtual void Print(std::ostream &os) const;
+
+	uint32_t m_length; ///< 24 bits on the wire
+	uint8_t m_type;
+	uint8_t m_flags;
+	uint32_t m_streamId;
+};
+
+/*
+ * \brief One stream of an HttpMuxConnection, seen as a stream socket.
+ *        HttpClientBasic and the server request handlers use it exactly
+ *        like a tcp socket: Send() queues bytes which the connection
+ *        writes as DATA frames when the stream's turn and flow control
+ *        window allow, Recv() returns the payload of received frames.
+ *        Close() ends the sending side; closing with unread data, or
+ *        receiving data after Close(), resets the stream, like tcp does.
+ */
+class HttpMuxStream: public Socket {
+public:
+	static TypeId GetTypeId(void);
+	HttpMuxStream();
+	virtual ~HttpMuxStream();
+
+	uint32_t GetStreamId() const;
+	void SetPriority(uint8_t priority); ///< lower is more urgent, tells the peer too
+	uint8_t GetPriority() const;
+
+	virtual enum SocketErrno GetErrno(void) const;
+	virtual enum SocketType GetSocketType(void) const;
+	virtual Ptr<Node> GetNode(void) const;
+	virtual int Bind(const Address &address);
+	virtual int Bind();
+	virtual int Bind6();
+	virtual int Close(void);
+	virtual int ShutdownSend(void);
+	virtual int ShutdownRecv(void);
+	virtual int Connect(const Address &address); ///< the address is the connection's
+	virtual int Listen(void);
+	virtual uint32_t GetTxAvailable(void) const;
+	virtual int Send(Ptr<Packet> p, uint32_t flags);
+	virtual int SendTo(Ptr<Packet> p, uint32_t flags, const Address &toAddress);
+	virtual uint32_t GetRxAvailable(void) const;
+	virtual Ptr<Packet> Recv(uint32_t maxSize, uint32_t flags);
+	virtual Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address &fromAddress);
+	virtual int GetSockName(Address &address) const;
+	virtual int GetPeerName(Address &address) const;
+	virtual bool SetAllowBroadcast(bool allowBroadcast);
+	virtual bool GetAllowBroadcast() const;
+
+protected:
+	virtual void DoDispose(void);
+
+private:
+	friend class HttpMuxConnection;
+
+	bool HasFrameToSend() const; ///< data within the window, or the END_STREAM
+	void Received(Ptr<Packet> data, bool endStream);
+	void Reset();
+	void Connected();
+	void ConnectFailed();
+
+	Ptr<HttpMuxConnection> m_conn; //!< 0 once the stream is gone
+	uint32_t m_id;
+	uint8_t m_priority;
+	bool m_connecting;
+	bool m_sendClosed; //!< Close() called, END_STREAM after the queue
+	bool m_finSent;
+	bool m_finReceived;
+	enum SocketErrno m_errno;
+
+	std::deque<Ptr<Packet> > m_txQueue;
+	uint32_t m_txSize;
+	uint32_t m_txBufferSize;
+	int64_t m_sendWindow; //!< bytes the peer is ready to take
+	std::deque<Ptr<Packet> > m_rxQueue;
+	uint32_t m_rxSize;
+	uint32_t m_consumed; //!< read since the last WINDOW_UPDATE
+};
+
+/*
+ * \brief Carries many HttpMuxStreams over one tcp connection (or one of
+ *        another SocketFactory). The
+ *        client side opens the connection with Connect() and streams
+ *        with OpenStream(); if the tcp connection is gone by then, it is
+ *        opened again. The server side Accept()s a tcp socket and hands
+ *        every stream the peer opens to the accept stream callback.
+ *
+ *        Output is scheduled frame by frame: control frames first, then
+ *        one DATA frame of at most MaxFrameSize from the most urgent
+ *        stream that has something to send, streams of equal priority
+ *        take turns. Each stream can have InitialWindow bytes unread at
+ *        the receiver, so a stalled stream does not block the others.
+ */
+class HttpMuxConnection: public Object {
+public:
+	static TypeId GetTypeId(void);
+	HttpMuxConnection();
+	virtual ~HttpMuxConnection();
+
+	void Connect(Ptr<Node> node, Address peerAddress, uint16_t peerPort);
+	void Accept(Ptr<Socket> socket);
+	void SetAcceptStreamCallback(Callback<void, Ptr<Socket> > cb);
+	Ptr<HttpMuxStream> OpenStream();
+	bool IsConnectedTo(const Address &peerAddress, uint16_t peerPort) const;
+	bool IsOpen() const; ///< the tcp connection is up or being set up
+	uint32_t GetNumStreams() const;
+	void Close(); ///< drops the tcp connection, open streams get an error
+
+protected:
+	virtual void DoDispose(void);
+
+private:
+	friend class HttpMuxStream;
+
+	void OpenSocket();
+	void SetSocketCallbacks();
+	void EvConnectionSucceeded(Ptr<Socket> socket);
+	void EvConnectionFailed(Ptr<Socket> socket);
+	void EvHandleRecv(Ptr<Socket> socket);
+	void EvHandleSend(Ptr<Socket> socket, uint32_t txSpace);
+	void EvSocketClosed(Ptr<Socket> socket);
+
+	void ProcessFrame(const HttpMuxFrameHeader &header, Ptr<Packet> payload);
+	void SendControl(uint8_t type, uint32_t streamId, uint32_t value, uint32_t len);
+	void SendFrames();
+	Ptr<HttpMuxStream> NextStream();
+	void StreamDone(Ptr<HttpMuxStream> stream);
+	void DropSocket();
+
+	Ptr<Socket> m_socket;
+	Ptr<Node> m_node;
+	Address m_peerAddress;
+	uint16_t m_peerPort;
+	bool m_connected;
+	bool m_sending; //!< inside SendFrames, streams may Send() from their callbacks
+	uint32_t m_nextStreamId;
+	uint32_t m_lastServed; //!< stream id that sent the last DATA frame
+	uint32_t m_lastPeerStream; //!< highest stream id the peer opened
+	std::map<uint32_t, Ptr<HttpMuxStream> > m_streams;
+	std::deque<Ptr<Packet> > m_control; //!< serialized frames, sent before any DATA
+	Ptr<Packet> m_rxBuffer; //!< bytes of a partly received frame
+	Callback<void, Ptr<Socket> > m_acceptStream;
+
+	uint32_t m_initialWindow;
+	uint32_t m_maxFrameSize;
+	uint32_t m_streamBufferSize;
+	TypeId m_socketFactory;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_MUX_H_ */
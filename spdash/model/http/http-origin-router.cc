@@ -0,0 +1,255 @@
+/*
+ * http-origin-router.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-origin-router.h"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpOriginRouter");
+
+NS_OBJECT_ENSURE_REGISTERED(HttpOriginRouter);
+
+TypeId HttpOriginRouter::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpOriginRouter")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddAttribute("LatencyAlpha",
+					"Weight of a new sample in the moving average latency of an origin",
+					DoubleValue(0.125),
+					MakeDoubleAccessor(&HttpOriginRouter::m_alpha),
+					MakeDoubleChecker<double>(0, 1));
+	return tid;
+}
+
+HttpOriginRouter::HttpOriginRouter(): m_alpha(0.125) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpOriginRouter::~HttpOriginRouter() {
+	NS_LOG_FUNCTION(this);
+}
+
+void HttpOriginRouter::AddOrigin(const Address &address, uint16_t port) {
+	NS_LOG_FUNCTION(this << address << port);
+	Origin origin;
+	origin.m_address = address;
+	origin.m_port = port;
+	m_origins.push_back(origin);
+}
+
+uint32_t HttpOriginRouter::GetNumOrigins() const {
+	return m_origins.size();
+}
+
+const Address& HttpOriginRouter::GetOriginAddress(uint32_t origin) const {
+	return m_origins[origin].m_address;
+}
+
+uint16_t HttpOriginRouter::GetOriginPort(uint32_t origin) const {
+	return m_origins[origin].m_port;
+}
+
+const HttpOriginStats& HttpOriginRouter::GetStats(uint32_t origin) const {
+	return m_origins[origin].m_stats;
+}
+
+void HttpOriginRouter::RequestStarted(uint32_t origin) {
+	HttpOriginStats &stats = m_origins[origin].m_stats;
+	stats.m_requests++;
+	stats.m_active++;
+	stats.m_maxActive = std::max(stats.m_maxActive, stats.m_active);
+}
+
+void HttpOriginRouter::RequestDone(uint32_t origin, Time latency, clen_t bytes, bool failed) {
+	HttpOriginStats &stats = m_origins[origin].m_stats;
+	NS_ASSERT(stats.m_active > 0);
+	stats.m_active--;
+	stats.m_bytes += bytes;
+	if(failed) {
+		stats.m_failed++;
+		return;
+	}
+	if(!stats.m_latencySampled) {
+		stats.m_latency = latency;
+		stats.m_latencySampled = true;
+		return;
+	}
+	stats.m_latency = NanoSeconds((1 - m_alpha) * stats.m_latency.GetNanoSeconds()
+			+ m_alpha * latency.GetNanoSeconds());
+}
+
+/**************************************************
+ *                Round Robin Router              *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpRoundRobinRouter);
+
+TypeId HttpRoundRobinRouter::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpRoundRobinRouter")
+			.SetParent<HttpOriginRouter>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpRoundRobinRouter>();
+	return tid;
+}
+
+HttpRoundRobinRouter::HttpRoundRobinRouter(): m_next(0) {
+}
+
+uint32_t HttpRoundRobinRouter::Select(const std::string &key) {
+	NS_ASSERT(!m_origins.empty());
+	uint32_t origin = m_next % m_origins.size();
+	m_next = origin + 1;
+	return origin;
+}
+
+std::string HttpRoundRobinRouter::GetName() const {
+	return "RoundRobin";
+}
+
+/**************************************************
+ *            Least Connections Router            *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpLeastConnectionsRouter);
+
+TypeId HttpLeastConnectionsRouter::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpLeastConnectionsRouter")
+			.SetParent<HttpOriginRouter>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpLeastConnectionsRouter>();
+	return tid;
+}
+
+HttpLeastConnectionsRouter::HttpLeastConnectionsRouter(): m_next(0) {
+}
+
+uint32_t HttpLeastConnectionsRouter::Select(const std::string &key) {
+	NS_ASSERT(!m_origins.empty());
+	uint32_t best = m_next % m_origins.size();
+	for(uint32_t i = 1; i < m_origins.size(); i++) {
+		uint32_t cur = (m_next + i) % m_origins.size();
+		if(m_origins[cur].m_stats.m_active < m_origins[best].m_stats.m_active)
+			best = cur;
+	}
+	m_next = best + 1;
+	return best;
+}
+
+std::string HttpLeastConnectionsRouter::GetName() const {
+	return "LeastConnections";
+}
+
+/**************************************************
+ *             Consistent Hash Router             *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpConsistentHashRouter);
+
+TypeId HttpConsistentHashRouter::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpConsistentHashRouter")
+			.SetParent<HttpOriginRouter>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpConsistentHashRouter>()
+			.AddAttribute("VirtualNodes",
+					"Points of every origin on the hash ring",
+					UintegerValue(100),
+					MakeUintegerAccessor(&HttpConsistentHashRouter::m_virtualNodes),
+					MakeUintegerChecker<uint32_t>(1));
+	return tid;
+}
+
+HttpConsistentHashRouter::HttpConsistentHashRouter(): m_virtualNodes(100) {
+}
+
+/*
+ * 64 bit FNV-1a, unlike std::hash the same on every platform, so runs
+ * can be repeated anywhere.
+ */
+uint64_t HttpConsistentHashRouter::Hash(const std::string &key) {
+	uint64_t hash = 14695981039346656037ULL;
+	for(auto c : key) {
+		hash ^= (uint8_t) c;
+		hash *= 1099511628211ULL;
+	}
+	//spread the low entropy of short keys over the whole ring
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+void HttpConsistentHashRouter::AddOrigin(const Address &address, uint16_t port) {
+	HttpOriginRouter::AddOrigin(address, port);
+	uint32_t origin = m_origins.size() - 1;
+	for(uint32_t i = 0; i < m_virtualNodes; i++) {
+		m_ring[Hash(std::to_string(origin) + "#" + std::to_string(i))] = origin;
+	}
+}
+
+uint32_t HttpConsistentHashRouter::Select(const std::string &key) {
+	NS_ASSERT(!m_ring.empty());
+	auto it = m_ring.lower_bound(Hash(key));
+	if(it == m_ring.end())
+		it = m_ring.begin();
+	return it->second;
+}
+
+std::string HttpConsistentHashRouter::GetName() const {
+	return "ConsistentHash";
+}
+
+/**************************************************
+ *              Latency Aware Router              *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpLatencyAwareRouter);
+
+TypeId HttpLatencyAwareRouter::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpLatencyAwareRouter")
+			.SetParent<HttpOriginRouter>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpLatencyAwareRouter>();
+	return tid;
+}
+
+uint32_t HttpLatencyAwareRouter::Select(const std::string &key) {
+	NS_ASSERT(!m_origins.empty());
+	uint32_t best = 0;
+	double bestWait = -1;
+	for(uint32_t i = 0; i < m_origins.size(); i++) {
+		const HttpOriginStats &stats = m_origins[i].m_stats;
+		if(!stats.m_latencySampled) {
+			if(stats.m_active == 0)
+				return i;
+			continue; //its first answer is still to come
+		}
+		double wait = stats.m_latency.GetSeconds() * (stats.m_active + 1);
+		if(bestWait < 0 || wait < bestWait) {
+			best = i;
+			bestWait = wait;
+		}
+	}
+	if(bestWait >= 0)
+		return best;
+	//no sample anywhere yet and every origin busy
+	for(uint32_t i = 1; i < m_origins.size(); i++) {
+		if(m_origins[i].m_stats.m_active < m_origins[best].m_stats.m_active)
+			best = i;
+	}
+	return best;
+}
+
+std::string HttpLatencyAwareRouter::GetName() const {
+	return "LatencyAware";
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,131 @@
+/*
+ * http-origin-router.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_ORIGIN_ROUTER_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_ORIGIN_ROUTER_H_
+
+#include "http-common.h"
+#include "ns3/object.h"
+#include "ns3/address.h"
+#include "ns3/nstime.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * \brief Load of one origin server as seen by its router.
+ */
+struct HttpOriginStats {
+	HttpOriginStats(): m_requests(0), m_active(0), m_maxActive(0), m_failed(0), m_bytes(0),
+			m_latencySampled(false) {}
+	uint64_t m_requests;
+	uint32_t m_active; //!< requests in flight
+	uint32_t m_maxActive;
+	uint64_t m_failed;
+	uint64_t m_bytes;
+	bool m_latencySampled;
+	Time m_latency; //!< moving average of the time to the first byte
+};
+
+/*
+ * \brief Picks the origin server of every request an HttpCacheProxy
+ *        forwards and keeps the load of each. Derived classes are the
+ *        policies; RequestStarted() and RequestDone() keep the load they
+ *        decide on up to date.
+ */
+class HttpOriginRouter: public Object {
+public:
+	static TypeId GetTypeId(void);
+	HttpOriginRouter();
+	virtual ~HttpOriginRouter();
+
+	virtual void AddOrigin(const Address &address, uint16_t port);
+	uint32_t GetNumOrigins() const;
+	const Address& GetOriginAddress(uint32_t origin) const;
+	uint16_t GetOriginPort(uint32_t origin) const;
+	const HttpOriginStats& GetStats(uint32_t origin) const;
+
+	virtual uint32_t Select(const std::string &key) = 0;
+	void RequestStarted(uint32_t origin);
+	void RequestDone(uint32_t origin, Time latency, clen_t bytes, bool failed);
+	virtual std::string GetName() const = 0;
+
+protected:
+	struct Origin {
+		Address m_address;
+		uint16_t m_port;
+		HttpOriginStats m_stats;
+	};
+	std::vector<Origin> m_origins;
+
+private:
+	double m_alpha; //!< weight of a new latency sample
+};
+
+/*
+ * \brief Every origin in turn.
+ */
+class HttpRoundRobinRouter: public HttpOriginRouter {
+public:
+	static TypeId GetTypeId(void);
+	HttpRoundRobinRouter();
+	virtual uint32_t Select(const std::string &key);
+	virtual std::string GetName() const;
+private:
+	uint32_t m_next;
+};
+
+/*
+ * \brief The origin with the fewest requests in flight, ties in turn.
+ */
+class HttpLeastConnectionsRouter: public HttpOriginRouter {
+public:
+	static TypeId GetTypeId(void);
+	HttpLeastConnectionsRouter();
+	virtual uint32_t Select(const std::string &key);
+	virtual std::string GetName() const;
+private:
+	uint32_t m_next;
+};
+
+/*
+ * \brief Hashes the path onto a ring of VirtualNodes points per origin,
+ *        so every segment always goes to the same origin and adding an
+ *        origin only moves the paths that land on its points. Keeps the
+ *        origins' own caches apart.
+ */
+class HttpConsistentHashRouter: public HttpOriginRouter {
+public:
+	static TypeId GetTypeId(void);
+	HttpConsistentHashRouter();
+	virtual void AddOrigin(const Address &address, uint16_t port);
+	virtual uint32_t Select(const std::string &key);
+	virtual std::string GetName() const;
+private:
+	static uint64_t Hash(const std::string &key);
+
+	uint32_t m_virtualNodes;
+	std::map<uint64_t, uint32_t> m_ring; //!< point -> origin
+};
+
+/*
+ * \brief The origin with the lowest expected wait, its moving average
+ *        time to the first byte scaled by the requests in flight plus
+ *        one. Origins without a sample yet are tried first.
+ */
+class HttpLatencyAwareRouter: public HttpOriginRouter {
+public:
+	static TypeId GetTypeId(void);
+	virtual uint32_t Select(const std::string &key);
+	virtual std::string GetName() const;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_ORIGIN_ROUTER_H_ */
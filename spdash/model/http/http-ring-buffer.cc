@@ -0,0 +1,81 @@
+/*
+ * http-ring-buffer.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-ring-buffer.h"
+#include "ns3/assert.h"
+#include <algorithm>
+#include <cstring>
+
+#define HRB_MIN_CAPACITY 256
+
+namespace ns3 {
+
+HttpRingBuffer::HttpRingBuffer(): m_data(NULL), m_capacity(0), m_head(0), m_size(0) {
+}
+
+HttpRingBuffer::~HttpRingBuffer() {
+	delete[] m_data;
+}
+
+void HttpRingBuffer::Write(const uint8_t *buf, uint32_t len) {
+	if (len == 0)
+		return;
+	Reserve(m_size + len);
+	uint32_t tail = (m_head + m_size) & (m_capacity - 1);
+	uint32_t first = std::min(len, m_capacity - tail);
+	std::memcpy(m_data + tail, buf, first);
+	std::memcpy(m_data, buf + first, len - first);
+	m_size += len;
+}
+
+uint32_t HttpRingBuffer::Read(uint8_t *buf, uint32_t len) {
+	len = std::min(len, m_size);
+	if (len == 0)
+		return 0;
+	uint32_t first = std::min(len, m_capacity - m_head);
+	std::memcpy(buf, m_data + m_head, first);
+	std::memcpy(buf + first, m_data, len - first);
+	m_head = (m_head + len) & (m_capacity - 1);
+	m_size -= len;
+	if (m_size == 0)
+		m_head = 0;
+	return len;
+}
+
+uint32_t HttpRingBuffer::GetSize() const {
+	return m_size;
+}
+
+bool HttpRingBuffer::IsEmpty() const {
+	return m_size == 0;
+}
+
+void HttpRingBuffer::Clear() {
+	m_head = 0;
+	m_size = 0;
+}
+
+void HttpRingBuffer::Reserve(uint32_t size) {
+	NS_ASSERT_MSG(size >= m_size, "Http buffer larger than 4 GiB");
+	if (size <= m_capacity)
+		return;
+	uint32_t capacity = m_capacity ? m_capacity : HRB_MIN_CAPACITY;
+	while (capacity < size) {
+		NS_ASSERT_MSG(capacity <= 0x80000000u, "Http buffer larger than 4 GiB");
+		capacity <<= 1;
+	}
+	uint8_t *data = new uint8_t[capacity];
+	uint32_t size0 = m_size;
+	Read(data, m_size); //unwraps to the front of the new storage
+	delete[] m_data;
+	m_data = data;
+	m_capacity = capacity;
+	m_head = 0;
+	m_size = size0;
+}
+
+} /* namespace ns3 */
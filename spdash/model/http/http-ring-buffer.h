@@ -0,0 +1,46 @@
+/*
+ * http-ring-buffer.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_RING_BUFFER_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_RING_BUFFER_H_
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/*
+ * \brief Byte fifo backing the header and body queues of http messages.
+ *        Write() appends and Read() consumes from the front, both copy
+ *        the bytes once and never allocate per chunk. The storage is a
+ *        power of two sized ring that doubles when it fills up, so a
+ *        message costs O(log size) allocations in total.
+ */
+class HttpRingBuffer {
+public:
+	HttpRingBuffer();
+	~HttpRingBuffer();
+
+	void Write(const uint8_t *buf, uint32_t len);
+	uint32_t Read(uint8_t *buf, uint32_t len);
+	uint32_t GetSize() const;
+	bool IsEmpty() const;
+	void Clear();
+
+private:
+	HttpRingBuffer(const HttpRingBuffer &);
+	HttpRingBuffer& operator=(const HttpRingBuffer &);
+	void Reserve(uint32_t size);
+
+	uint8_t *m_data;
+	uint32_t m_capacity; //!< 0 or a power of two
+	uint32_t m_head; //!< index of the first byte
+	uint32_t m_size;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_RING_BUFFER_H_ */
@@ -0,0 +1,194 @@
+/*
+ * http-segment-cache.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-segment-cache.h"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpSegmentCache");
+
+NS_OBJECT_ENSURE_REGISTERED(HttpSegmentCache);
+
+TypeId HttpSegmentCache::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpSegmentCache")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddAttribute("Capacity",
+					"Bytes of objects kept",
+					UintegerValue(100000000),
+					MakeUintegerAccessor(&HttpSegmentCache::m_capacity),
+					MakeUintegerChecker<uint64_t>());
+	return tid;
+}
+
+HttpSegmentCache::HttpSegmentCache(): m_capacity(100000000), m_used(0), m_seq(0),
+		m_evictions(0) {
+	NS_LOG_FUNCTION(this);
+}
+
+HttpSegmentCache::~HttpSegmentCache() {
+	NS_LOG_FUNCTION(this);
+}
+
+bool HttpSegmentCache::Lookup(const std::string &key, clen_t &size, Time &fetchTime) {
+	auto it = m_entries.find(key);
+	if(it == m_entries.end())
+		return false;
+	it->second.m_hits++;
+	Touch(key, it->second);
+	size = it->second.m_size;
+	fetchTime = it->second.m_fetchTime;
+	return true;
+}
+
+bool HttpSegmentCache::Contains(const std::string &key) const {
+	return m_entries.find(key) != m_entries.end();
+}
+
+void HttpSegmentCache::Insert(const std::string &key, clen_t size, Time fetchTime) {
+	NS_LOG_FUNCTION(this << key << size);
+	Erase(key);
+	if(size > m_capacity)
+		return;
+	MakeRoom(size);
+	Entry entry;
+	entry.m_size = size;
+	entry.m_fetchTime = fetchTime;
+	entry.m_hits = 1;
+	entry.m_lastUse = 0;
+	entry.m_priority = 0;
+	Entry &inserted = m_entries.insert(std::make_pair(key, entry)).first->second;
+	m_order.insert(Rank(0, 0, key)); //replaced right away
+	Touch(key, inserted);
+	m_used += size;
+}
+
+void HttpSegmentCache::Erase(const std::string &key) {
+	auto it = m_entries.find(key);
+	if(it == m_entries.end())
+		return;
+	m_order.erase(Rank(it->second.m_priority, it->second.m_lastUse, key));
+	m_used -= it->second.m_size;
+	m_entries.erase(it);
+}
+
+uint64_t HttpSegmentCache::GetCapacity() const {
+	return m_capacity;
+}
+
+uint64_t HttpSegmentCache::GetUsed() const {
+	return m_used;
+}
+
+uint32_t HttpSegmentCache::GetNumObjects() const {
+	return m_entries.size();
+}
+
+uint64_t HttpSegmentCache::GetNumEvictions() const {
+	return m_evictions;
+}
+
+void HttpSegmentCache::Evicted(const Entry &entry) {
+}
+
+void HttpSegmentCache::Touch(const std::string &key, Entry &entry) {
+	m_order.erase(Rank(entry.m_priority, entry.m_lastUse, key));
+	entry.m_lastUse = ++m_seq;
+	entry.m_priority = GetPriority(entry);
+	m_order.insert(Rank(entry.m_priority, entry.m_lastUse, key));
+}
+
+void HttpSegmentCache::MakeRoom(clen_t size) {
+	while(!m_order.empty() && m_used + size > m_capacity) {
+		auto victim = m_entries.find(std::get<2>(*m_order.begin()));
+		NS_LOG_LOGIC("Evicting " << victim->first);
+		m_order.erase(m_order.begin());
+		m_used -= victim->second.m_size;
+		m_evictions++;
+		Evicted(victim->second);
+		m_entries.erase(victim);
+	}
+}
+
+/**************************************************
+ *                    Lru Cache                   *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpLruCache);
+
+TypeId HttpLruCache::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpLruCache")
+			.SetParent<HttpSegmentCache>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpLruCache>();
+	return tid;
+}
+
+std::string HttpLruCache::GetName() const {
+	return "LRU";
+}
+
+double HttpLruCache::GetPriority(const Entry &entry) const {
+	return 0; //the rank falls back to the last use
+}
+
+/**************************************************
+ *                    Lfu Cache                   *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpLfuCache);
+
+TypeId HttpLfuCache::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpLfuCache")
+			.SetParent<HttpSegmentCache>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpLfuCache>();
+	return tid;
+}
+
+std::string HttpLfuCache::GetName() const {
+	return "LFU";
+}
+
+double HttpLfuCache::GetPriority(const Entry &entry) const {
+	return entry.m_hits;
+}
+
+/**************************************************
+ *                   Gdsf Cache                   *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(HttpGdsfCache);
+
+TypeId HttpGdsfCache::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::HttpGdsfCache")
+			.SetParent<HttpSegmentCache>()
+			.SetGroupName("Applications")
+			.AddConstructor<HttpGdsfCache>();
+	return tid;
+}
+
+HttpGdsfCache::HttpGdsfCache(): m_inflation(0) {
+}
+
+std::string HttpGdsfCache::GetName() const {
+	return "GDSF";
+}
+
+double HttpGdsfCache::GetPriority(const Entry &entry) const {
+	return m_inflation + (double) entry.m_hits / std::max(entry.m_size, (clen_t) 1);
+}
+
+void HttpGdsfCache::Evicted(const Entry &entry) {
+	m_inflation = std::max(m_inflation, entry.m_priority);
+}
+
+} /* namespace ns3 */
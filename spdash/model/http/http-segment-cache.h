@@ -0,0 +1,120 @@
+/*
+ * http-segment-cache.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_SEGMENT_CACHE_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_SEGMENT_CACHE_H_
+
+#include "http-common.h"
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+namespace ns3 {
+
+/*
+ * \brief Index of the objects an HttpCacheProxy holds, keyed by path.
+ *        Bodies are synthetic, so only sizes are kept. Once Capacity
+ *        bytes are used, objects are evicted lowest priority first;
+ *        derived classes define the priority of an object each time it
+ *        is inserted or hit. Objects larger than Capacity are not
+ *        cached at all.
+ */
+class HttpSegmentCache: public Object {
+public:
+	static TypeId GetTypeId(void);
+	HttpSegmentCache();
+	virtual ~HttpSegmentCache();
+
+	/*
+	 * Counts a hit and returns true if key is cached, size is set to
+	 * its bytes and fetchTime to how long the origin took for it.
+	 */
+	bool Lookup(const std::string &key, clen_t &size, Time &fetchTime);
+	bool Contains(const std::string &key) const;
+	void Insert(const std::string &key, clen_t size, Time fetchTime);
+	void Erase(const std::string &key);
+
+	uint64_t GetCapacity() const;
+	uint64_t GetUsed() const;
+	uint32_t GetNumObjects() const;
+	uint64_t GetNumEvictions() const;
+	virtual std::string GetName() const = 0;
+
+protected:
+	struct Entry {
+		clen_t m_size;
+		Time m_fetchTime;
+		uint64_t m_hits;
+		uint64_t m_lastUse; //!< sequence number, for ties and lru
+		double m_priority;
+	};
+
+	virtual double GetPriority(const Entry &entry) const = 0;
+	virtual void Evicted(const Entry &entry);
+
+private:
+	typedef std::tuple<double, uint64_t, std::string> Rank;
+
+	void Touch(const std::string &key, Entry &entry);
+	void MakeRoom(clen_t size);
+
+	uint64_t m_capacity;
+	uint64_t m_used;
+	uint64_t m_seq;
+	uint64_t m_evictions;
+	std::map<std::string, Entry> m_entries;
+	std::set<Rank> m_order; //!< lowest priority first
+};
+
+/*
+ * \brief Evicts the least recently used object.
+ */
+class HttpLruCache: public HttpSegmentCache {
+public:
+	static TypeId GetTypeId(void);
+	virtual std::string GetName() const;
+protected:
+	virtual double GetPriority(const Entry &entry) const;
+};
+
+/*
+ * \brief Evicts the least frequently used object, the least recently
+ *        used among equally popular ones.
+ */
+class HttpLfuCache: public HttpSegmentCache {
+public:
+	static TypeId GetTypeId(void);
+	virtual std::string GetName() const;
+protected:
+	virtual double GetPriority(const Entry &entry) const;
+};
+
+/*
+ * \brief Size aware: greedy dual size frequency, priority is hits per
+ *        byte plus an inflation value that rises to the priority of
+ *        each evicted object, so objects popular long ago age out.
+ *        Favours the many small low quality segments over a few large
+ *        ones.
+ */
+class HttpGdsfCache: public HttpSegmentCache {
+public:
+	static TypeId GetTypeId(void);
+	HttpGdsfCache();
+	virtual std::string GetName() const;
+protected:
+	virtual double GetPriority(const Entry &entry) const;
+	virtual void Evicted(const Entry &entry);
+private:
+	double m_inflation;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_SEGMENT_CACHE_H_ */
@@ -7,10 +7,13 @@
 
 
 #include "http-server-base-request-handler.h"
+#include "http-server.h"
 
 #include "ns3/log.h"
 #include "ns3/socket.h"
+#include "ns3/packet.h"
 #include "ns3/application.h"
+#include "ns3/simulator.h"
 
 
 namespace ns3 {
@@ -35,7 +38,7 @@ TypeId HttpServerBaseRequestHandler::GetTypeId(void) {
 
 HttpServerBaseRequestHandler::HttpServerBaseRequestHandler() :
 		m_clen(0), m_server(NULL), m_sendStarted(false), m_headerSent(false), m_processedHeader(
-				false), m_running(true) {
+				false), m_running(true), m_keepAlive(false), m_reqBodyLeft(0), m_reqBodyRead(0), m_slot(0) {
 	NS_LOG_FUNCTION(this);
 
 }
@@ -45,24 +48,27 @@ HttpServerBaseRequestHandler::~HttpServerBaseRequestHandler(){
 //	std::cout << "~HttpServerClient" << std::endl;
 }
 
+/*
+ * The whole header goes out in one Send, unless the tx buffer has less
+ * room than that.
+ */
 void HttpServerBaseRequestHandler::SendHeaders() {
 	NS_LOG_FUNCTION(this);
 
-	uint16_t canSend = std::min(m_socket->GetTxAvailable(), (uint32_t)1024);
-	if(!canSend)
-		return;
-	uint8_t *buf = new uint8_t[canSend];
-	uint16_t toBeSent = m_response->ReadHeader(buf, canSend);
-	uint16_t sent;
-	if(!toBeSent) {
-		m_headerSent = true;
-		goto clean;
+	while(!m_headerSent) {
+		uint32_t size = m_response->GetHeaderSize();
+		if(!size) {
+			m_headerSent = true;
+			break;
+		}
+		uint32_t canSend = std::min(m_socket->GetTxAvailable(), size);
+		if(!canSend)
+			return;
+		m_headerBuf.resize(canSend);
+		uint32_t toBeSent = m_response->ReadHeader(m_headerBuf.data(), canSend);
+		uint32_t sent = m_socket->Send(m_headerBuf.data(), toBeSent, 0);
+		NS_ASSERT(sent == toBeSent);
 	}
-	sent = m_socket->Send(buf, toBeSent, 0);
-	NS_ASSERT(sent == toBeSent);
-
-clean:
-	delete[] buf;
 }
 
 void HttpServerBaseRequestHandler::HandleSend(Ptr<Socket> socket, uint32_t txSpace) {
@@ -70,29 +76,101 @@ void HttpServerBaseRequestHandler::HandleSend(Ptr<Socket> socket, uint32_t txSpa
 	if(!m_sendStarted || !m_running)
 		return;
 	if(!m_headerSent) {
-		return SendHeaders();
+		SendHeaders();
+		if(!m_headerSent)
+			return;
+		//start with the body right away, else it waits for the next ack
+		txSpace = socket->GetTxAvailable();
+		if(!txSpace)
+			return;
 	}
 	ReadyToSend(txSpace);
 }
 
 void HttpServerBaseRequestHandler::HandleRead(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
+	while(m_running && socket->GetRxAvailable() > 0) {
+		Ptr<Packet> packet = socket->Recv(2048, 0);
+		if(packet == 0 || !packet->GetSize())
+			break;
+		HandleInput(packet);
+	}
+}
+
+/*
+ * Only header bytes are copied out for parsing. The body and whatever
+ * follows it are kept as fragments of the packet, so that their byte
+ * tags survive and the body is never copied.
+ */
+void HttpServerBaseRequestHandler::HandleInput(Ptr<Packet> packet) {
+	uint32_t len = packet->GetSize();
+	NS_LOG_FUNCTION(this << len);
+	m_idleEvent.Cancel();
+
+	uint32_t consumed = 0;
+	bool headerReceived = false;
+	if(!m_processedHeader) {
+		m_inputBuf.resize(len);
+		packet->CopyData(m_inputBuf.data(), len);
+		consumed = m_request->ParseHeader(m_inputBuf.data(), len);
+		if(!m_request->IsHeaderReceived())
+			return;
+		m_processedHeader = true;
+		headerReceived = true;
+		m_keepAlive = m_keepAlive && m_request->IsKeepAlive();
+		m_reqBodyLeft = m_request->GetContentLength();
+	}
+	uint32_t bodyLen = std::min((clen_t)(len - consumed), m_reqBodyLeft);
+	if(bodyLen) {
+		m_reqBodyLeft -= bodyLen;
+		Ptr<Packet> body = packet->CreateFragment(consumed, bodyLen);
+		if(m_reqBody == 0)
+			m_reqBody = body;
+		else
+			m_reqBody->AddAtEnd(body);
+	}
+	//anything after the body is the next request
+	uint32_t rest = consumed + bodyLen;
+	if(rest < len) {
+		Ptr<Packet> next = packet->CreateFragment(rest, len - rest);
+		if(m_pendingInput == 0)
+			m_pendingInput = next;
+		else
+			m_pendingInput->AddAtEnd(next);
+	}
+	if(headerReceived)
+		RequestHeaderReceived();
+	else if(bodyLen)
+		RequestDataReceived();
+}
+
+Ptr<Packet> HttpServerBaseRequestHandler::GetRequestBody() const {
+	if(m_reqBody == 0)
+		return 0;
+	return m_reqBody->Copy();
+}
+
+void HttpServerBaseRequestHandler::ResumeRead(Ptr<Packet> pending) {
+	NS_LOG_FUNCTION(this);
 	if(!m_running) return;
-	uint8_t buf[2048];
-	uint16_t len = 0;
-	len = socket->Recv(buf, 2048, 0);
-	m_request->ParseHeader(buf, len);
-	if(!m_request->IsHeaderReceived())
-		return;
-	if(m_processedHeader)
-		return RequestDataReceived();
-	RequestHeaderReceived();
-	m_processedHeader = true;
+	if(pending != 0)
+		HandleInput(pending);
+	HandleRead(m_socket);
+}
+
+void HttpServerBaseRequestHandler::HandleIdleTimeout() {
+	NS_LOG_FUNCTION(this);
+	NS_LOG_INFO("Closing idle connection");
+	Ptr<HttpServerBaseRequestHandler> self = this;
+	CleanCBs();
+	m_socket->Close();
 }
 
 void HttpServerBaseRequestHandler::HandlePeerClose(Ptr<Socket> socket) {
 	NS_LOG_FUNCTION(this << socket);
+	Ptr<HttpServerBaseRequestHandler> self = this;
 	CleanCBs();
+	socket->Close(); //peer is done with a kept alive connection
 }
 
 void HttpServerBaseRequestHandler::HandlePeerError(Ptr<Socket> socket) {
@@ -100,12 +178,33 @@ void HttpServerBaseRequestHandler::HandlePeerError(Ptr<Socket> socket) {
 	CleanCBs();
 }
 
+void HttpServerBaseRequestHandler::Reset() {
+	NS_LOG_FUNCTION(this);
+	m_idleEvent.Cancel();
+	m_socket = 0;
+	m_server = NULL;
+	m_onClose = MakeNullCallback<void>();
+	m_clen = 0;
+	m_sendStarted = false;
+	m_headerSent = false;
+	m_processedHeader = false;
+	m_running = true;
+	m_keepAlive = false;
+	m_reqBodyLeft = 0;
+	m_reqBody = 0;
+	m_reqBodyRead = 0;
+	m_pendingInput = 0;
+	if(m_request != 0)
+		m_request->Reset();
+	if(m_response != 0) {
+		m_response->Reset();
+		m_response->SetVersion("http1.1");
+		SetStatus(407, "Not Found");
+	}
+}
+
 void HttpServerBaseRequestHandler::RequestHeaderReceived() {
 	NS_LOG_FUNCTION(this);
-	std::string path = GetPath();
-	AddHeader("Server", "Hello NS3 http server");
-	AddHeader("Server-x", "Hello NS3 http server");
-	AddHeader("Server-x2", "Hello NS3 http server");
 	EndHeader();
 }
 void HttpServerBaseRequestHandler::RequestDataReceived() {
@@ -120,6 +219,27 @@ void HttpServerBaseRequestHandler::AddHeader(std::string name, std::string value
 	NS_LOG_FUNCTION(this << " " << name << " " << value);
 	GetResponse()->AddHeader(name, value);
 }
+clen_t HttpServerBaseRequestHandler::SelectRange(clen_t total) {
+	NS_LOG_FUNCTION(this << total);
+	clen_t first = 0, last = 0;
+	switch(GetRequest()->GetRange(total, first, last)) {
+	case HTTP_RANGE_OK:
+		SetStatus(206, "Partial Content");
+		GetResponse()->SetContentRange(first, last, total);
+		SetClen(last - first + 1);
+		return first;
+	case HTTP_RANGE_UNSATISFIABLE:
+		SetStatus(416, "Range Not Satisfiable");
+		GetResponse()->SetContentRange(1, 0, total);
+		SetClen(0);
+		return 0;
+	default:
+		SetStatus(200, "OK");
+		SetClen(total);
+		return 0;
+	}
+}
+
 void HttpServerBaseRequestHandler::SetStatus(uint16_t code, std::string status) {
 	NS_LOG_FUNCTION(this);
 	GetResponse()->SetStatusCode(code);
@@ -141,6 +261,15 @@ uint16_t HttpServerBaseRequestHandler::Send(const uint8_t *data, const uint16_t
 	return m_socket->Send(data, len, 0);
 }
 
+uint32_t HttpServerBaseRequestHandler::SendVirtual(uint32_t len) {
+	NS_LOG_FUNCTION(this << len);
+	NS_ASSERT(m_sendStarted);
+	if(!len)
+		return 0;
+	int sent = m_socket->Send(Create<Packet>(len));
+	return sent < 0 ? 0 : sent;
+}
+
 void HttpServerBaseRequestHandler::SocketClosed() {
 
 }
@@ -148,24 +277,60 @@ void HttpServerBaseRequestHandler::SocketClosed() {
 void HttpServerBaseRequestHandler::EndHeader(){
 	NS_LOG_FUNCTION(this);
 	m_sendStarted = true;
+	if(m_server)
+		m_response->SetHeaderTemplate(m_server->GetHeaderTemplate(m_response->GetVersion(),
+				m_response->GetStatusCode(), m_response->GetStatusText()));
 	AddHeader("Content-Length", std::to_string(m_clen));
+	AddHeader("Connection", m_keepAlive ? "keep-alive" : "close");
 	m_response->EndHeader();
 	HandleSend(m_socket, m_socket->GetTxAvailable());
 }
 
 void HttpServerBaseRequestHandler::EndResponse() {
 	NS_LOG_FUNCTION(this);
+	if(!m_running) return;
+	Ptr<HttpServerBaseRequestHandler> self = this; //server drops its reference in CleanCBs
+	CleanCBs();
+	if(m_keepAlive && m_server) {
+		m_server->ContinueConnection(m_socket, m_pendingInput);
+		return;
+	}
+	m_socket->Close();
+}
+
+void HttpServerBaseRequestHandler::ResumeSend() {
+	NS_LOG_FUNCTION(this);
+	if(!m_sendStarted || !m_running) return;
+	uint32_t txSpace = m_socket->GetTxAvailable();
+	if(txSpace)
+		HandleSend(m_socket, txSpace);
+}
+
+void HttpServerBaseRequestHandler::AbortResponse() {
+	NS_LOG_FUNCTION(this);
+	if(!m_running) return;
+	Ptr<HttpServerBaseRequestHandler> self = this;
 	CleanCBs();
 	m_socket->Close();
 }
 
-uint16_t HttpServerBaseRequestHandler::Recv(uint8_t *data, uint16_t len) {
-	return GetRequest()->ReadBody(data, len);
+uint32_t HttpServerBaseRequestHandler::Recv(uint8_t *data, uint32_t len) {
+	if(m_reqBody == 0 || m_reqBodyRead >= m_reqBody->GetSize())
+		return 0;
+	len = std::min(len, m_reqBody->GetSize() - m_reqBodyRead);
+	m_reqBody->CreateFragment(m_reqBodyRead, len)->CopyData(data, len);
+	m_reqBodyRead += len;
+	return len;
+}
+
+bool HttpServerBaseRequestHandler::PeekRequestTag(Tag &tag) const {
+	return m_reqBody != 0 && m_reqBody->FindFirstMatchingByteTag(tag);
 }
 
 void HttpServerBaseRequestHandler::CleanCBs() {
 	if(!m_running) return;
 	m_running = false;
+	m_idleEvent.Cancel();
 	if(!m_onClose.IsNull()) m_onClose();
 	m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
 	m_socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t >());
@@ -175,13 +340,18 @@ void HttpServerBaseRequestHandler::CleanCBs() {
 }
 
 void HttpServerBaseRequestHandler::InitFromServer(Ptr<Socket> sock, HttpServer *server,
-			Callback<void> onClose) {
+			Callback<void> onClose, bool keepAlive, Time idleTimeout) {
 	m_socket = sock;
 	m_server = server;
 	m_onClose = onClose;
+	m_keepAlive = keepAlive;
+	if(idleTimeout.IsStrictlyPositive())
+		m_idleEvent = Simulator::Schedule(idleTimeout, &HttpServerBaseRequestHandler::HandleIdleTimeout, this);
 
-	m_request = Create<HttpRequest>();
-	m_response = Create<HttpResponse>("http1.1", 407, "Not Found");
+	if(m_request == 0) { //a recycled handler has them reset already
+		m_request = Create<HttpRequest>();
+		m_response = Create<HttpResponse>("http1.1", 407, "Not Found");
+	}
 	m_socket->SetRecvCallback(MakeCallback(&HttpServerBaseRequestHandler::HandleRead, this));
 	m_socket->SetSendCallback(MakeCallback(&HttpServerBaseRequestHandler::HandleSend, this));
 	m_socket->SetCloseCallbacks(
@@ -12,7 +12,11 @@
 #include "ns3/type-id.h"
 #include "ns3/ptr.h"
 #include "ns3/object-factory.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
 #include "ext-callback.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -25,6 +29,13 @@ class HttpServer;
  * 	      Here derived classes are expected to implement vitual
  * 	      functions only. Several functions are kept not virtual
  * 	      intentionally.
+ *
+ * 	      A handler serves exactly one request. On a keep-alive
+ * 	      connection EndResponse() hands the socket back to the server,
+ * 	      which attaches another handler for the next request. Finished
+ * 	      handlers are recycled by the server: derived classes that keep
+ * 	      per request state must override Reset(), clear it and call
+ * 	      the base class version.
  */
 class HttpServerBaseRequestHandler: public Object {
 public:
@@ -35,6 +46,7 @@ public:
 //===================Request Handler==========
 
 protected:
+	virtual void Reset(); ///< back to a fresh handler, request and response included
 	virtual void RequestHeaderReceived();
 	virtual void RequestDataReceived();
 	virtual void ReadyToSend(uint32_t);
@@ -47,22 +59,55 @@ protected:
 	const Ptr<HttpRequest>& GetRequest() const {return m_request;}
 	const Ptr<HttpResponse>& GetResponse() const {return m_response;}
 	uint16_t Send(const uint8_t *data, const uint16_t len);
-	uint16_t Recv(uint8_t *data, uint16_t len);
+	/*
+	 * Sends len zero bytes as one virtual packet: no payload is
+	 * allocated or copied. Meant for synthetic bodies whose content
+	 * does not matter, len should not exceed the tx space.
+	 */
+	uint32_t SendVirtual(uint32_t len);
+	uint32_t Recv(uint8_t *data, uint32_t len); ///< reads the request body, from where the last call stopped
+	/*
+	 * Finds a byte tag of the tag's type on the request body received so
+	 * far, e.g. typed metadata the client attached instead of encoding it.
+	 */
+	bool PeekRequestTag(Tag &tag) const;
+	Ptr<Packet> GetRequestBody() const; ///< copy of the body received so far, tags included, 0 if none
+	bool IsRequestComplete() const { return m_processedHeader && !m_reqBodyLeft; } ///< header and whole body arrived
 	void EndResponse(); ///< indicate that response ended.
+	/*
+	 * Calls ReadyToSend() again if there is tx space, for bodies whose
+	 * bytes become available later, e.g. from an upstream server.
+	 */
+	void ResumeSend();
+	void AbortResponse(); ///< closes the connection in the middle of a response
+	HttpServer* GetServer() const { return m_server; }
+	const Ptr<Socket>& GetSocket() const { return m_socket; }
+	bool IsRunning() const { return m_running; } ///< false once the connection is handed back or gone
 	void EndHeader(); ///< indicate that the response header have ended.
 	void SetClen(clen_t mClen) { m_clen = mClen; }
+	clen_t GetClen() const { return m_clen; }
+	/*
+	 * Applies the Range of the request to a body of total bytes: sets
+	 * the status (200, 206 or 416), Content-Range and the content
+	 * length. Returns the offset of the first byte to send, the number
+	 * of bytes to send is GetClen().
+	 */
+	clen_t SelectRange(clen_t total);
 	void SetStatus(uint16_t code, std::string status);
 private:
 	void HandleRead(Ptr<Socket> socket);
+	void HandleInput(Ptr<Packet> packet);
 	void HandleSend(Ptr<Socket> socket, uint32_t packetSizeToReturn);
+	void HandleIdleTimeout();
 	void SendHeaders();
+	void ResumeRead(Ptr<Packet> pending);
 
 	void HandlePeerClose(Ptr<Socket> socket);
 	void HandlePeerError(Ptr<Socket> socket);
 
 	void CleanCBs();
 	void InitFromServer(Ptr<Socket> sock, HttpServer *server,
-			Callback<void> onClose);
+			Callback<void> onClose, bool keepAlive, Time idleTimeout);
 
 	Ptr<Socket> m_socket;
 	Ptr<HttpRequest> m_request;
@@ -73,7 +118,16 @@ private:
 	bool m_headerSent;
 	bool m_processedHeader;
 	bool m_running;
+	bool m_keepAlive;
+	clen_t m_reqBodyLeft; ///< request body bytes not received yet
+	Ptr<Packet> m_reqBody; ///< request body as received, tags included, 0 if none
+	uint32_t m_reqBodyRead; ///< bytes of m_reqBody already handed out by Recv()
+	Ptr<Packet> m_pendingInput; ///< bytes of the following (pipelined) requests, 0 if none
+	std::vector<uint8_t> m_inputBuf; ///< received header bytes being parsed
+	std::vector<uint8_t> m_headerBuf; ///< serialized header on its way to the socket
+	EventId m_idleEvent;
 	Callback<void> m_onClose;
+	uint32_t m_slot; ///< index in the server's live handlers
 	friend class HttpServer;
 };
 
@@ -50,13 +50,13 @@ TypeId HttpServerSimpleRequestHandler::GetTypeId(void) {
 	return tid;
 }
 
-HttpServerSimpleRequestHandler::HttpServerSimpleRequestHandler(): m_sent(false){}
+HttpServerSimpleRequestHandler::HttpServerSimpleRequestHandler(): m_sent(false), m_left(0){}
 
 void HttpServerSimpleRequestHandler::ReadyToSend(uint32_t bufLen){
 	NS_LOG_FUNCTION(this);
 	char buf[1024];
-	uint32_t tobeSend = std::min(bufLen, (uint32_t)sizeof(buf));
-	if(m_ifs.good()) {
+	uint32_t tobeSend = std::min((clen_t)std::min(bufLen, (uint32_t)sizeof(buf)), m_left);
+	if(tobeSend && m_ifs.good()) {
 		m_ifs.read(buf, tobeSend);
 		uint16_t canbeSend = tobeSend;
 		if(!m_ifs) {
@@ -64,12 +64,21 @@ void HttpServerSimpleRequestHandler::ReadyToSend(uint32_t bufLen){
 		}
 		uint16_t sent = Send((uint8_t *) buf, canbeSend);
 		NS_ASSERT(sent == canbeSend);
-		if(canbeSend == tobeSend)
+		m_left -= canbeSend;
+		if(canbeSend == tobeSend && m_left)
 			return;
 	}
 	EndResponse();
 }
 
+void HttpServerSimpleRequestHandler::Reset() {
+	HttpServerBaseRequestHandler::Reset();
+	m_sent = false;
+	m_left = 0;
+	m_ifs.close();
+	m_ifs.clear();
+}
+
 void HttpServerSimpleRequestHandler::RequestHeaderReceived() {
 	std::string path = GetPath();
 	if(path.at(0) != '/')
@@ -79,9 +88,9 @@ void HttpServerSimpleRequestHandler::RequestHeaderReceived() {
 		m_ifs.open(path, std::ifstream::binary);
 		if (m_ifs) { // File found
 			m_ifs.seekg(0, m_ifs.end);
-			int length = m_ifs.tellg();
-			m_ifs.seekg(0, m_ifs.beg);
-			SetClen(length);
+			clen_t length = m_ifs.tellg();
+			m_ifs.seekg(SelectRange(length), m_ifs.beg);
+			m_left = GetClen();
 			EndHeader();
 			return;
 		}
@@ -22,8 +22,10 @@ public:
 protected:
 	virtual void ReadyToSend(uint32_t);
 	virtual void RequestHeaderReceived();
+	virtual void Reset();
 private:
 	bool m_sent;
+	clen_t m_left; //!< bytes of the (range of the) file not sent yet
 	std::string m_cwd;
 	std::ifstream m_ifs;
 };
@@ -31,6 +31,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/global-value.h"
 #include <ns3/core-module.h>
@@ -62,12 +63,50 @@ TypeId HttpServer::GetTypeId(void) {
 					"Call back function to create RequestHandler",
 					TypeIdValue(HttpServerBaseRequestHandler::GetTypeId()),
 					MakeTypeIdAccessor(&HttpServer::GetReqHandlerFactoryTypeId, &HttpServer::SetReqHandlerFactoryTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute(
+					"KeepAlive",
+					"Keep the connection open after a response unless the client asks for Connection: close",
+					BooleanValue(true),
+					MakeBooleanAccessor(&HttpServer::m_keepAlive),
+					MakeBooleanChecker())
+			.AddAttribute(
+					"IdleTimeout",
+					"Close a connection which waits this long for the next request, zero disables it",
+					TimeValue(Seconds(30)),
+					MakeTimeAccessor(&HttpServer::m_idleTimeout),
+					MakeTimeChecker())
+			.AddAttribute(
+					"Multiplex",
+					"Connections carry HttpMux streams, every stream gets its own request handler",
+					BooleanValue(false),
+					MakeBooleanAccessor(&HttpServer::m_multiplex),
+					MakeBooleanChecker())
+			.AddAttribute(
+					"ServerName",
+					"Value of the Server header of every response, empty leaves it out",
+					StringValue("Hello NS3 http server"),
+					MakeStringAccessor(&HttpServer::m_serverName),
+					MakeStringChecker())
+			.AddAttribute(
+					"HandlerPoolSize",
+					"Finished request handlers kept for reuse, 0 creates a new one for every request",
+					UintegerValue(64),
+					MakeUintegerAccessor(&HttpServer::m_handlerPoolSize),
+					MakeUintegerChecker<uint32_t>())
+			.AddAttribute(
+					"SocketFactory",
+					"TypeId of the socket factory to listen with, e.g. ns3::RudpSocketFactory",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&HttpServer::m_socketFactory),
 					MakeTypeIdChecker());
 	return tid;
 }
 
 HttpServer::HttpServer() :
-		m_port(0) {
+		m_port(0), m_handlerPoolSize(64), m_poolHits(0), m_poolMisses(0),
+		m_serverName("Hello NS3 http server"), m_keepAlive(true), m_idleTimeout(Seconds(30)),
+		m_multiplex(false), m_socketFactory(TcpSocketFactory::GetTypeId()) {
 	NS_LOG_FUNCTION(this);
 }
 
@@ -79,6 +118,10 @@ HttpServer::~HttpServer() {
 
 void HttpServer::DoDispose(void) {
 	NS_LOG_FUNCTION(this);
+	m_muxConnections.clear();
+	m_recycleEvent.Cancel();
+	m_retiredHandlers.clear();
+	m_handlerPool.clear();
 	Application::DoDispose();
 }
 
@@ -95,8 +138,7 @@ void HttpServer::StartApplication(void) {
 	NS_LOG_FUNCTION(this);
 
 	if (m_socket == 0) {
-		TypeId tid = TypeId::LookupByName("ns3::TcpSocketFactory");
-		m_socket = Socket::CreateSocket(GetNode(), tid);
+		m_socket = Socket::CreateSocket(GetNode(), m_socketFactory);
 		InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(),
 				m_port);
 		m_socket->Bind(local);
@@ -104,8 +146,7 @@ void HttpServer::StartApplication(void) {
 	}
 
 	if (m_socket6 == 0) {
-		TypeId tid = TypeId::LookupByName("ns3::TcpSocketFactory");
-		m_socket6 = Socket::CreateSocket(GetNode(), tid);
+		m_socket6 = Socket::CreateSocket(GetNode(), m_socketFactory);
 		Inet6SocketAddress local6 = Inet6SocketAddress(Ipv6Address::GetAny(),
 				m_port);
 		m_socket6->Bind(local6);
@@ -130,18 +171,63 @@ void HttpServer::StopApplication() {
 		m_socket6->Close();
 		m_socket6->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
 	}
+	NS_LOG_INFO("Handler pool hits " << m_poolHits << " misses " << m_poolMisses);
 }
 
 void HttpServer::HandleAccept(Ptr<Socket> s, const Address &from) {
 	NS_LOG_FUNCTION(this << s << from);
+	if(!m_multiplex) {
+		AttachHandler(s);
+		return;
+	}
+	for(auto it = m_muxConnections.begin(); it != m_muxConnections.end();) {
+		if((*it)->IsOpen())
+			++it;
+		else
+			it = m_muxConnections.erase(it);
+	}
+	Ptr<HttpMuxConnection> mux = CreateObject<HttpMuxConnection>();
+	mux->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+	mux->SetAcceptStreamCallback(MakeCallback(&HttpServer::HandleAcceptStream, this));
+	mux->Accept(s);
+	m_muxConnections.push_back(mux);
+}
+
+void HttpServer::HandleAcceptStream(Ptr<Socket> s) {
+	NS_LOG_FUNCTION(this << s);
+	AttachHandler(s);
+}
+
+Ptr<HttpServerBaseRequestHandler> HttpServer::AttachHandler(Ptr<Socket> s) {
+	NS_LOG_FUNCTION(this << s);
 
-	Ptr<HttpServerBaseRequestHandler> htsCli = m_reqHandlerFactory.Create<HttpServerBaseRequestHandler>();
+	Ptr<HttpServerBaseRequestHandler> htsCli;
+	if(!m_handlerPool.empty()) {
+		htsCli = m_handlerPool.back();
+		m_handlerPool.pop_back();
+		m_poolHits++;
+	} else {
+		htsCli = m_reqHandlerFactory.Create<HttpServerBaseRequestHandler>();
+		m_poolMisses++;
+	}
 //	Ptr<BaseHttpRequestHandler> htsCli = m_handlerFactory->CreateHandler(s, this);
 //	htsCli->SetOnClose(MakeCallback(&HttpServer::HandleConnectionClose, this));
-	htsCli->InitFromServer(s, this, MakeCallback(&HttpServer::HandleConnectionClose, this).Bind((void *)PeekPointer(htsCli)));
+	htsCli->InitFromServer(s, this, MakeCallback(&HttpServer::HandleConnectionClose, this).Bind(PeekPointer(htsCli)),
+			m_keepAlive, m_idleTimeout);
 
+	htsCli->m_slot = m_connectedClients.size();
 	m_connectedClients.push_back(htsCli);
+	return htsCli;
+}
 
+/*
+ * A kept alive connection finished a response. The next request (may be
+ * partly received already) gets a fresh handler.
+ */
+void HttpServer::ContinueConnection(Ptr<Socket> s, Ptr<Packet> pending) {
+	NS_LOG_FUNCTION(this << s);
+	Ptr<HttpServerBaseRequestHandler> htsCli = AttachHandler(s);
+	Simulator::ScheduleNow(&HttpServerBaseRequestHandler::ResumeRead, htsCli, pending);
 }
 
 void HttpServer::SetReqHandlerFactoryTypeId(TypeId tid) {
@@ -152,14 +238,61 @@ TypeId HttpServer::GetReqHandlerFactoryTypeId(void) const {
 	return m_reqHandlerFactory.GetTypeId();
 }
 
-void HttpServer::HandleConnectionClose(void *ptr) {
+uint64_t HttpServer::GetHandlerPoolHits() const {
+	return m_poolHits;
+}
+
+uint64_t HttpServer::GetHandlerPoolMisses() const {
+	return m_poolMisses;
+}
+
+uint32_t HttpServer::GetNumConnections() const {
+	return m_connectedClients.size();
+}
+
+const HttpHeaderTemplate* HttpServer::GetHeaderTemplate(const std::string &version,
+		uint16_t statusCode, const std::string &statusText) {
+	auto it = m_headerTemplates.find(statusCode);
+	if(it == m_headerTemplates.end()) {
+		HttpHeaderTemplate tpl(version, statusCode, statusText);
+		if(!m_serverName.empty())
+			tpl.AddHeader("Server", m_serverName);
+		it = m_headerTemplates.insert(std::make_pair(statusCode, tpl)).first;
+	}
+	if(it->second.GetVersion() != version || it->second.GetStatusText() != statusText)
+		return NULL;
+	return &it->second;
+}
+
+/*
+ * Called from the handler while it is still finishing its response,
+ * it is reset later, once nothing else holds it.
+ */
+void HttpServer::HandleConnectionClose(HttpServerBaseRequestHandler *handler) {
 	NS_LOG_FUNCTION(this);
-	for (auto it = m_connectedClients.begin(); it != m_connectedClients.end(); ++it) {
-		if(PeekPointer(*it) == ptr){
-			m_connectedClients.erase(it);
-			return;
-		}
+	uint32_t slot = handler->m_slot;
+	NS_ASSERT(slot < m_connectedClients.size() && PeekPointer(m_connectedClients[slot]) == handler);
+	Ptr<HttpServerBaseRequestHandler> closed = m_connectedClients[slot];
+	m_connectedClients[slot] = m_connectedClients.back();
+	m_connectedClients[slot]->m_slot = slot;
+	m_connectedClients.pop_back();
+	if(m_handlerPoolSize == 0)
+		return;
+	m_retiredHandlers.push_back(closed);
+	if(!m_recycleEvent.IsRunning())
+		m_recycleEvent = Simulator::ScheduleNow(&HttpServer::RecycleHandlers, this);
+}
+
+void HttpServer::RecycleHandlers() {
+	NS_LOG_FUNCTION(this << m_retiredHandlers.size());
+	for(auto &handler : m_retiredHandlers) {
+		//a pending callback (e.g. an abr answer) still refers to it
+		if(handler->GetReferenceCount() > 1 || m_handlerPool.size() >= m_handlerPoolSize)
+			continue;
+		handler->Reset();
+		m_handlerPool.push_back(handler);
 	}
+	m_retiredHandlers.clear();
 }
 
 
@@ -21,12 +21,15 @@
 
 #include "ns3/application.h"
 #include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/address.h"
 #include "ns3/traced-callback.h"
 #include <map>
+#include <list>
 
 #include "http-server-base-request-handler.h"
+#include "http-mux.h"
 #include "ns3/random-variable-stream.h"
 
 namespace ns3 {
@@ -35,32 +38,68 @@ class Socket;
 class Packet;
 
 
+/*
+ * Every request gets its own handler. Finished handlers are reset and
+ * kept in a pool of up to HandlerPoolSize for the next requests, together
+ * with their request and response objects; live handlers sit in a slot
+ * vector, each knows its slot, so closing a connection is O(1).
+ */
 class HttpServer: public Application {
 public:
 	static TypeId GetTypeId(void);
 	HttpServer();
 	virtual ~HttpServer();
 
+	uint64_t GetHandlerPoolHits() const;
+	uint64_t GetHandlerPoolMisses() const;
+	uint32_t GetNumConnections() const; ///< handlers serving a request right now
+	/*
+	 * Status line and constant fields (Server) of a response, built the
+	 * first time a status is used. 0 if the version or status text
+	 * differ from those the template was built with.
+	 */
+	const HttpHeaderTemplate* GetHeaderTemplate(const std::string &version, uint16_t statusCode,
+			const std::string &statusText);
+
 protected:
 	virtual void DoDispose(void);
 	virtual void DoInitialize (void);
-
-private:
 	virtual void StartApplication(void);
 	virtual void StopApplication(void);
 
 	void SetReqHandlerFactoryTypeId(TypeId tid);
 	TypeId GetReqHandlerFactoryTypeId(void) const;
 
+private:
+
 	void HandleAccept(Ptr<Socket> s, const Address &from);
+	void HandleAcceptStream(Ptr<Socket> s);
+	Ptr<HttpServerBaseRequestHandler> AttachHandler(Ptr<Socket> s);
+	void ContinueConnection(Ptr<Socket> s, Ptr<Packet> pending);
 
-	void HandleConnectionClose(void*);
+	void HandleConnectionClose(HttpServerBaseRequestHandler *handler);
+	void RecycleHandlers();
 
 	uint16_t m_port;
 	Ptr<Socket> m_socket;
 	Ptr<Socket> m_socket6;
-	std::vector<Ptr<HttpServerBaseRequestHandler> > m_connectedClients;
+	std::vector<Ptr<HttpServerBaseRequestHandler> > m_connectedClients; //!< slot map
+	std::vector<Ptr<HttpServerBaseRequestHandler> > m_retiredHandlers; //!< closed, not reset yet
+	std::vector<Ptr<HttpServerBaseRequestHandler> > m_handlerPool;
+	EventId m_recycleEvent;
+	uint32_t m_handlerPoolSize;
+	uint64_t m_poolHits;
+	uint64_t m_poolMisses;
+	std::string m_serverName;
+	std::map<uint16_t, HttpHeaderTemplate> m_headerTemplates;
 	ObjectFactory m_reqHandlerFactory;
+	bool m_keepAlive;
+	Time m_idleTimeout;
+	bool m_multiplex;
+	TypeId m_socketFactory;
+	std::list<Ptr<HttpMuxConnection> > m_muxConnections;
+
+	friend class HttpServerBaseRequestHandler;
 
 //	Callback<Ptr<BaseHttpRequestHandler>, Ptr<Socket>, HttpServer *> m_createReqHandler;
 };
@@ -0,0 +1,183 @@
+/*
+ * http-trace.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "http-trace.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("HttpTrace");
+
+HttpTrace::HttpTrace(): m_resLen(0), m_speed(0), m_granularity(0), m_numRecv(0) {
+}
+
+void HttpTrace::SetDecimation(Time resolution, uint64_t granularity) {
+	m_resolution = resolution;
+	m_granularity = granularity;
+}
+
+void HttpTrace::RequestSent() {
+	m_reqSentAt = Simulator::Now();
+}
+
+void HttpTrace::ResponseRecv(uint32_t len) {
+
+	if(m_firstByteAt.IsZero())
+		m_firstByteAt = Simulator::Now();
+
+	auto now = Simulator::Now();
+	if(m_numRecv > 1 && now > m_lastByteAt) {
+		m_speed = (len*8 * 1.0e6) / (now.GetMicroSeconds() - m_lastByteAt.GetMicroSeconds());
+	}
+	m_numRecv++;
+	m_lastByteAt = now;
+	m_resLen += len;
+
+	//the last sample moves along until it is far enough from the one before
+	size_t num = m_times.size();
+	bool keepAll = m_resolution.IsZero() && m_granularity == 0;
+	if(num >= 2 && !keepAll
+			&& (m_resolution.IsZero() || now.GetNanoSeconds() - m_times[num - 2] < m_resolution.GetNanoSeconds())
+			&& (m_granularity == 0 || m_resLen - m_bytes[num - 2] < m_granularity)) {
+		m_times[num - 1] = now.GetNanoSeconds();
+		m_bytes[num - 1] = m_resLen;
+		return;
+	}
+	m_times.push_back(now.GetNanoSeconds());
+	m_bytes.push_back(m_resLen);
+}
+
+uint32_t HttpTrace::GetNumSamples() const {
+	return m_times.size();
+}
+
+void HttpTrace::StoreInFile(std::ostream &outFile) const {
+	outFile << "{" ;
+	outFile << "\"reqSentAt\":" << m_reqSentAt.GetSeconds() << ",";
+	outFile << "\"firstByteAt\":" << m_firstByteAt.GetSeconds() << ",";
+	outFile << "\"lastByteAt\":" << m_lastByteAt.GetSeconds() << ",";
+	outFile << "\"trace\": [";
+	std::string separator = "";
+	for(size_t i = 0; i < m_times.size(); i++) {
+		outFile << separator << "[";
+		outFile << m_times[i] / 1.0e9 << "," << m_bytes[i];
+		outFile << "]";
+		separator = ",";
+	}
+	outFile << "]";
+	outFile << "}";
+}
+
+void HttpTrace::Write(std::ostream &outFile) const {
+	HttpTraceRecord record;
+	record.m_reqSentAt = m_reqSentAt.GetNanoSeconds();
+	record.m_firstByteAt = m_firstByteAt.GetNanoSeconds();
+	record.m_lastByteAt = m_lastByteAt.GetNanoSeconds();
+	record.m_resLen = m_resLen;
+	record.m_numSamples = m_times.size();
+	outFile.write((const char *) &record, sizeof(record));
+	outFile.write((const char *) m_times.data(), sizeof(int64_t) * m_times.size());
+	outFile.write((const char *) m_bytes.data(), sizeof(uint64_t) * m_bytes.size());
+}
+
+bool HttpTrace::Read(std::istream &inFile, uint64_t &left) {
+	HttpTraceRecord record;
+	if(left < sizeof(record) || !inFile.read((char *) &record, sizeof(record)))
+		return false;
+	left -= sizeof(record);
+	//each sample is one time and one byte count, never trust the count further than the file
+	if(record.m_numSamples > left / (sizeof(int64_t) + sizeof(uint64_t))) {
+		NS_LOG_ERROR("Trace claims " << record.m_numSamples << " samples, only " << left
+				<< " bytes left");
+		return false;
+	}
+	left -= record.m_numSamples * (sizeof(int64_t) + sizeof(uint64_t));
+	m_reqSentAt = NanoSeconds(record.m_reqSentAt);
+	m_firstByteAt = NanoSeconds(record.m_firstByteAt);
+	m_lastByteAt = NanoSeconds(record.m_lastByteAt);
+	m_resLen = record.m_resLen;
+	m_times.resize(record.m_numSamples);
+	m_bytes.resize(record.m_numSamples);
+	inFile.read((char *) m_times.data(), sizeof(int64_t) * m_times.size());
+	inFile.read((char *) m_bytes.data(), sizeof(uint64_t) * m_bytes.size());
+	return (bool) inFile;
+}
+
+double HttpTrace::GetDownloadSpeed() const {
+	return m_speed;
+}
+
+bool HttpTrace::StoreAll(const std::string &path, const std::vector<HttpTrace> &traces,
+		bool binary) {
+	NS_LOG_FUNCTION(path << binary);
+	std::ofstream outFile;
+	outFile.open(path.c_str(), binary ? std::ofstream::binary | std::ofstream::trunc
+			: std::ofstream::out | std::ofstream::trunc);
+	if (!outFile.is_open()) {
+		return false;
+	}
+	if(binary) {
+		HttpTraceFileHeader header;
+		header.m_magic = HTTP_TRACE_MAGIC;
+		header.m_version = HTTP_TRACE_VERSION;
+		header.m_reserved = 0;
+		header.m_numTraces = traces.size();
+		outFile.write((const char *) &header, sizeof(header));
+		for(auto &it : traces) {
+			it.Write(outFile);
+		}
+		return (bool) outFile;
+	}
+	std::string separator = "";
+	outFile << "[" << std::endl;
+	for(auto &it : traces) {
+		outFile << separator;
+		it.StoreInFile(outFile);
+		outFile << std::endl;
+		separator = ",";
+	}
+	outFile << "]" << std::endl;
+	return (bool) outFile;
+}
+
+bool HttpTrace::LoadAll(const std::string &path, std::vector<HttpTrace> &traces) {
+	NS_LOG_FUNCTION(path);
+	std::ifstream inFile(path.c_str(), std::ifstream::binary);
+	HttpTraceFileHeader header;
+	if(!inFile.read((char *) &header, sizeof(header)) || header.m_magic != HTTP_TRACE_MAGIC
+			|| header.m_version != HTTP_TRACE_VERSION) {
+		NS_LOG_ERROR("Not a binary http trace: " << path);
+		return false;
+	}
+	std::streampos start = inFile.tellg();
+	inFile.seekg(0, std::ifstream::end);
+	std::streampos end = inFile.tellg();
+	inFile.seekg(start);
+	if(!inFile || end < start) {
+		NS_LOG_ERROR("Cannot size binary http trace: " << path);
+		return false;
+	}
+	uint64_t left = end - start;
+	if(header.m_numTraces > left / sizeof(HttpTraceRecord)) {
+		NS_LOG_ERROR("Truncated binary http trace: " << path << " claims "
+				<< header.m_numTraces << " traces in " << left << " bytes");
+		return false;
+	}
+	traces.clear();
+	traces.reserve(header.m_numTraces);
+	for(uint64_t i = 0; i < header.m_numTraces; i++) {
+		HttpTrace trace;
+		if(!trace.Read(inFile, left))
+			return false;
+		traces.push_back(std::move(trace));
+	}
+	return true;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,90 @@
+/*
+ * http-trace.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_HTTP_HTTP_TRACE_H_
+#define SRC_SPDASH_MODEL_HTTP_HTTP_TRACE_H_
+
+#include "http-common.h"
+#include "ns3/nstime.h"
+#include <iostream>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Binary trace file, host byte order like the video manifest:
+ *
+ *   HttpTraceFileHeader
+ *   per trace:
+ *     HttpTraceRecord
+ *     int64_t  time[m_numSamples]     (ns)
+ *     uint64_t bytes[m_numSamples]    (cumulative response bytes)
+ */
+#define HTTP_TRACE_MAGIC 0x43525448 //"HTRC" on little endian machines
+#define HTTP_TRACE_VERSION 1
+
+struct HttpTraceFileHeader {
+	uint32_t m_magic;
+	uint16_t m_version;
+	uint16_t m_reserved;
+	uint64_t m_numTraces;
+};
+
+struct HttpTraceRecord {
+	int64_t m_reqSentAt; //ns
+	int64_t m_firstByteAt;
+	int64_t m_lastByteAt;
+	uint64_t m_resLen;
+	uint64_t m_numSamples;
+};
+
+/*
+ * \brief Progress of one http response. The (time, bytes so far) samples
+ *        are kept in two columns and decimated: a sample is only added
+ *        once it is Resolution after or Granularity bytes beyond the one
+ *        before, otherwise it replaces the last sample, so the last
+ *        sample always matches the totals. With both at 0 every receive
+ *        is kept. Traces are move only, they are handed from the client
+ *        to its owner and never copied.
+ */
+class HttpTrace {
+public:
+	HttpTrace();
+	HttpTrace(HttpTrace &&) = default;
+	HttpTrace& operator=(HttpTrace &&) = default;
+
+	void SetDecimation(Time resolution, uint64_t granularity);
+	void RequestSent();
+	void ResponseRecv(uint32_t len);
+	void StoreInFile(std::ostream &outFile) const; ///< json
+	void Write(std::ostream &outFile) const; ///< binary, one record
+	bool Read(std::istream &inFile, uint64_t &left); ///< left: bytes still in the file
+	double GetDownloadSpeed() const;
+	uint32_t GetNumSamples() const;
+
+	static bool StoreAll(const std::string &path, const std::vector<HttpTrace> &traces,
+			bool binary);
+	static bool LoadAll(const std::string &path, std::vector<HttpTrace> &traces);
+
+	Time m_reqSentAt, m_firstByteAt, m_lastByteAt;
+	clen_t m_resLen;
+	double m_speed;
+	std::vector<int64_t> m_times; ///< ns
+	std::vector<uint64_t> m_bytes;
+
+private:
+	HttpTrace(const HttpTrace &);
+	HttpTrace& operator=(const HttpTrace &);
+
+	Time m_resolution;
+	uint64_t m_granularity;
+	uint64_t m_numRecv;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_HTTP_HTTP_TRACE_H_ */
@@ -0,0 +1,175 @@
+/*
+ * spdash-abr-coordinator.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "spdash-abr-coordinator.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("SpDashAbrCoordinator");
+NS_OBJECT_ENSURE_REGISTERED(SpDashAbrCoordinator);
+
+TypeId SpDashAbrCoordinator::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::SpDashAbrCoordinator")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddConstructor<SpDashAbrCoordinator>()
+			.AddAttribute("Epoch",
+					"Decisions submitted within this time are allocated together, 0 only batches simultaneous ones",
+					TimeValue(MilliSeconds(50)),
+					MakeTimeAccessor(&SpDashAbrCoordinator::m_epoch),
+					MakeTimeChecker(Time(0)))
+			.AddAttribute("Capacity",
+					"Capacity shared by the clients, 0 estimates it from their throughput",
+					DataRateValue(DataRate(0)),
+					MakeDataRateAccessor(&SpDashAbrCoordinator::m_capacity),
+					MakeDataRateChecker())
+			.AddAttribute("SafetyFactor",
+					"Fraction of the capacity the clients may use together",
+					DoubleValue(1),
+					MakeDoubleAccessor(&SpDashAbrCoordinator::m_safetyFactor),
+					MakeDoubleChecker<double>(0, 1))
+			.AddAttribute("ThroughputAlpha",
+					"Weight of a new chunk throughput sample in the estimate of a client",
+					DoubleValue(0.3),
+					MakeDoubleAccessor(&SpDashAbrCoordinator::m_alpha),
+					MakeDoubleChecker<double>(0, 1))
+			.AddAttribute("ActiveTimeout",
+					"A client without a request for this long no longer shares the capacity",
+					TimeValue(Seconds(10)),
+					MakeTimeAccessor(&SpDashAbrCoordinator::m_activeTimeout),
+					MakeTimeChecker());
+	return tid;
+}
+
+SpDashAbrCoordinator::SpDashAbrCoordinator(): m_epoch(MilliSeconds(50)), m_capacity(0),
+		m_safetyFactor(1), m_alpha(0.3), m_activeTimeout(Seconds(10)), m_epochs(0), m_lowered(0) {
+	NS_LOG_FUNCTION(this);
+}
+
+SpDashAbrCoordinator::~SpDashAbrCoordinator() {
+	NS_LOG_FUNCTION(this);
+}
+
+void SpDashAbrCoordinator::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	m_epochEvent.Cancel();
+	m_pending.clear();
+	m_clients.clear();
+	Object::DoDispose();
+}
+
+void SpDashAbrCoordinator::Submit(const Address &client, const VideoData *videoData,
+		const AbrRequest &request, AbrDecision proposal, Callback<void, AbrDecision> onDecision) {
+	NS_LOG_FUNCTION(this << client);
+	NS_ASSERT(videoData);
+	Client &state = m_clients[GetClientKey(client)];
+	Time spent = request.m_lastChunkFinishTime - request.m_lastChunkStartTime;
+	if(request.m_lastChunkSize > 0 && spent.IsStrictlyPositive()) {
+		double sample = request.m_lastChunkSize * 8.0 / spent.GetSeconds();
+		state.m_throughput = state.m_throughput > 0 ?
+				m_alpha * sample + (1 - m_alpha) * state.m_throughput : sample;
+	}
+	state.m_lastSeen = Simulator::Now();
+	state.m_inEpoch = true;
+
+	Pending pending;
+	pending.m_client = &state;
+	pending.m_videoData = videoData;
+	pending.m_buffer = request.m_bufferLevel;
+	pending.m_decision = proposal;
+	pending.m_proposal = std::min(proposal.m_quality, (uint16_t)(videoData->GetNumQualities() - 1));
+	pending.m_onDecision = onDecision;
+	m_pending.push_back(pending);
+
+	if(!m_epochEvent.IsRunning())
+		m_epochEvent = Simulator::Schedule(m_epoch, &SpDashAbrCoordinator::Allocate, this);
+}
+
+Address SpDashAbrCoordinator::GetClientKey(const Address &peer) {
+	if(InetSocketAddress::IsMatchingType(peer))
+		return InetSocketAddress::ConvertFrom(peer).GetIpv4();
+	if(Inet6SocketAddress::IsMatchingType(peer))
+		return Inet6SocketAddress::ConvertFrom(peer).GetIpv6();
+	return peer;
+}
+
+double SpDashAbrCoordinator::GetCapacity() const {
+	if(m_capacity.GetBitRate() > 0)
+		return m_capacity.GetBitRate();
+	double capacity = 0;
+	for(auto &it : m_clients)
+		capacity += it.second.m_throughput;
+	return capacity;
+}
+
+void SpDashAbrCoordinator::Allocate() {
+	NS_LOG_FUNCTION(this << m_pending.size());
+	m_epochs++;
+	Time now = Simulator::Now();
+	for(auto it = m_clients.begin(); it != m_clients.end();) {
+		if(!it->second.m_inEpoch && now - it->second.m_lastSeen > m_activeTimeout)
+			it = m_clients.erase(it);
+		else
+			++it;
+	}
+
+	double capacity = GetCapacity();
+	double budget = capacity * m_safetyFactor;
+	for(auto &it : m_clients) {
+		if(!it.second.m_inEpoch)
+			budget -= it.second.m_bitrate;
+	}
+
+	//everybody starts at the lowest quality, even if that is already too much
+	std::vector<Pending> batch;
+	std::swap(batch, m_pending);
+	std::vector<uint16_t> quality(batch.size(), 0);
+	for(auto &it : batch)
+		budget -= it.m_videoData->m_averageBitrate.at(0);
+
+	while(true) {
+		int best = -1;
+		double bestRate = 0;
+		for(uint32_t i = 0; i < batch.size(); i++) {
+			if(quality[i] >= batch[i].m_proposal)
+				continue;
+			const std::vector<double> &ladder = batch[i].m_videoData->m_averageBitrate;
+			if(ladder.at(quality[i] + 1) - ladder.at(quality[i]) > budget)
+				continue;
+			double rate = ladder.at(quality[i]);
+			if(best < 0 || rate < bestRate || (rate == bestRate && batch[i].m_buffer > batch[best].m_buffer)) {
+				best = i;
+				bestRate = rate;
+			}
+		}
+		if(best < 0)
+			break;
+		const std::vector<double> &ladder = batch[best].m_videoData->m_averageBitrate;
+		budget -= ladder.at(quality[best] + 1) - ladder.at(quality[best]);
+		quality[best]++;
+	}
+
+	for(uint32_t i = 0; i < batch.size(); i++) {
+		Pending &it = batch[i];
+		if(quality[i] < it.m_proposal)
+			m_lowered++;
+		it.m_client->m_bitrate = it.m_videoData->m_averageBitrate.at(quality[i]);
+		it.m_client->m_inEpoch = false;
+		it.m_decision.m_quality = quality[i];
+	}
+	NS_LOG_INFO("epoch of " << batch.size() << " decisions, " << m_clients.size()
+			<< " clients, capacity " << capacity << " bps, left " << budget << " bps");
+	for(auto &it : batch)
+		it.m_onDecision(it.m_decision);
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,95 @@
+/*
+ * spdash-abr-coordinator.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_COORDINATOR_H_
+#define SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_COORDINATOR_H_
+
+#include "ns3/object.h"
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/data-rate.h"
+#include "ns3/abr-algorithm.h"
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * \brief Joint bitrate allocation for all SpDash clients of one server.
+ *        Aggregated to the HttpServer, every SpDashRequestHandler of it
+ *        submits the decision of its own AbrAlgorithm here instead of
+ *        answering right away. Decisions submitted within one Epoch are
+ *        settled together:
+ *
+ *        The shared capacity is Capacity or, if that is 0, the sum of
+ *        the throughput (EWMA of the chunk samples) of every client seen
+ *        within ActiveTimeout. Clients outside the epoch keep the
+ *        bitrate they were given last. The rest of the budget is filled
+ *        max-min fair: starting from the lowest quality, the client with
+ *        the lowest bitrate (the fuller buffer on a tie) is raised one
+ *        quality at a time, never above what its own algorithm chose.
+ *        A decision only gets lowered, its cookie is passed on as is.
+ */
+class SpDashAbrCoordinator: public Object {
+public:
+	static TypeId GetTypeId(void);
+	SpDashAbrCoordinator();
+	virtual ~SpDashAbrCoordinator();
+
+	/*
+	 * client is the peer address of the player's connection. Only its
+	 * ip address identifies the client, so reconnects and parallel
+	 * connections (pools, rudp, no keep alive) count once. proposal is
+	 * what its AbrAlgorithm chose for request.
+	 */
+	void Submit(const Address &client, const VideoData *videoData, const AbrRequest &request,
+			AbrDecision proposal, Callback<void, AbrDecision> onDecision);
+	uint32_t GetNumClients() const { return m_clients.size(); }
+	uint64_t GetNumEpochs() const { return m_epochs; }
+	uint64_t GetNumLowered() const { return m_lowered; } ///< decisions lowered below the proposal
+
+protected:
+	virtual void DoDispose(void);
+
+private:
+	struct Client {
+		Client(): m_throughput(0), m_bitrate(0), m_inEpoch(false) {}
+		double m_throughput; ///< bps
+		double m_bitrate; ///< allocated last
+		Time m_lastSeen;
+		bool m_inEpoch;
+	};
+	struct Pending {
+		Client *m_client;
+		const VideoData *m_videoData;
+		double m_buffer;
+		AbrDecision m_decision;
+		uint16_t m_proposal;
+		Callback<void, AbrDecision> m_onDecision;
+	};
+
+	void Allocate();
+	double GetCapacity() const;
+	static Address GetClientKey(const Address &peer); ///< the peer without its port
+
+	Time m_epoch;
+	DataRate m_capacity;
+	double m_safetyFactor;
+	double m_alpha;
+	Time m_activeTimeout;
+	std::map<Address, Client> m_clients;
+	std::vector<Pending> m_pending;
+	EventId m_epochEvent;
+	uint64_t m_epochs;
+	uint64_t m_lowered;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_COORDINATOR_H_ */
@@ -0,0 +1,170 @@
+/*
+ * spdash-abr-state.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "spdash-abr-state.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(SpDashAbrStateTag);
+
+static uint32_t VarintSize(uint64_t val) {
+	uint32_t size = 1;
+	while(val >= 0x80) {
+		val >>= 7;
+		size++;
+	}
+	return size;
+}
+
+static void WriteVarint(std::string &out, uint64_t val) {
+	while(val >= 0x80) {
+		out.push_back((char)(0x80 | (val & 0x7f)));
+		val >>= 7;
+	}
+	out.push_back((char)val);
+}
+
+static void WriteString(std::string &out, const std::string &val) {
+	WriteVarint(out, val.size());
+	out.append(val);
+}
+
+static bool ReadVarint(const uint8_t *&buf, const uint8_t *end, uint64_t &val) {
+	val = 0;
+	for(uint32_t shift = 0; buf < end && shift < 64; shift += 7) {
+		uint8_t byte = *buf++;
+		val |= (uint64_t)(byte & 0x7f) << shift;
+		if(!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static bool ReadString(const uint8_t *&buf, const uint8_t *end, std::string &val) {
+	uint64_t len;
+	if(!ReadVarint(buf, end, len) || len > (uint64_t)(end - buf))
+		return false;
+	val.assign((const char*)buf, len);
+	buf += len;
+	return true;
+}
+
+//times before the start of the simulation never occur, clamp anyway
+static uint64_t Unsigned(int64_t val) {
+	return val < 0 ? 0 : val;
+}
+
+uint32_t SpDashAbrState::GetSerializedSize() const {
+	return VarintSize(m_videoPath.size()) + m_videoPath.size()
+			+ VarintSize(m_request.m_segmentNum)
+			+ VarintSize(m_request.m_lastQuality)
+			+ VarintSize(Unsigned(std::llround(m_request.m_bufferLevel * 1e6)))
+			+ VarintSize(Unsigned(std::llround(m_request.m_rebufferTime * 1e6)))
+			+ VarintSize(Unsigned(m_request.m_lastChunkStartTime.GetNanoSeconds()))
+			+ VarintSize(Unsigned(m_request.m_lastChunkFinishTime.GetNanoSeconds()))
+			+ VarintSize(m_request.m_lastChunkSize)
+			+ VarintSize(m_request.m_cookie.size()) + m_request.m_cookie.size();
+}
+
+void SpDashAbrState::Serialize(std::string &out) const {
+	WriteString(out, m_videoPath);
+	WriteVarint(out, m_request.m_segmentNum);
+	WriteVarint(out, m_request.m_lastQuality);
+	WriteVarint(out, Unsigned(std::llround(m_request.m_bufferLevel * 1e6)));
+	WriteVarint(out, Unsigned(std::llround(m_request.m_rebufferTime * 1e6)));
+	WriteVarint(out, Unsigned(m_request.m_lastChunkStartTime.GetNanoSeconds()));
+	WriteVarint(out, Unsigned(m_request.m_lastChunkFinishTime.GetNanoSeconds()));
+	WriteVarint(out, m_request.m_lastChunkSize);
+	WriteString(out, m_request.m_cookie);
+}
+
+bool SpDashAbrState::Deserialize(const uint8_t *buf, uint32_t len) {
+	const uint8_t *end = buf + len;
+	uint64_t segmentNum, lastQuality, buffer, rebuffer, start, finish;
+	if(!ReadString(buf, end, m_videoPath)
+			|| !ReadVarint(buf, end, segmentNum)
+			|| !ReadVarint(buf, end, lastQuality)
+			|| !ReadVarint(buf, end, buffer)
+			|| !ReadVarint(buf, end, rebuffer)
+			|| !ReadVarint(buf, end, start)
+			|| !ReadVarint(buf, end, finish)
+			|| !ReadVarint(buf, end, m_request.m_lastChunkSize)
+			|| !ReadString(buf, end, m_request.m_cookie))
+		return false;
+	m_request.m_segmentNum = segmentNum;
+	m_request.m_lastQuality = lastQuality;
+	m_request.m_bufferLevel = buffer / 1e6;
+	m_request.m_rebufferTime = rebuffer / 1e6;
+	m_request.m_lastChunkStartTime = NanoSeconds(start);
+	m_request.m_lastChunkFinishTime = NanoSeconds(finish);
+	return buf == end;
+}
+
+/*******************************************************
+ *                 SpDashAbrStateTag                   *
+ *******************************************************/
+
+TypeId SpDashAbrStateTag::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::SpDashAbrStateTag")
+			.SetParent<Tag>()
+			.SetGroupName("Applications")
+			.AddConstructor<SpDashAbrStateTag>();
+	return tid;
+}
+
+SpDashAbrStateTag::SpDashAbrStateTag() {
+}
+
+SpDashAbrStateTag::SpDashAbrStateTag(const SpDashAbrState &state): m_state(state) {
+}
+
+TypeId SpDashAbrStateTag::GetInstanceTypeId(void) const {
+	return GetTypeId();
+}
+
+uint32_t SpDashAbrStateTag::GetSerializedSize(void) const {
+	return 4 + m_state.m_videoPath.size() + 2 + 2 + 8 + 8 + 8 + 8 + 8
+			+ 4 + m_state.m_request.m_cookie.size();
+}
+
+void SpDashAbrStateTag::Serialize(TagBuffer buf) const {
+	const AbrRequest &request = m_state.m_request;
+	buf.WriteU32(m_state.m_videoPath.size());
+	buf.Write((const uint8_t*)m_state.m_videoPath.data(), m_state.m_videoPath.size());
+	buf.WriteU16(request.m_segmentNum);
+	buf.WriteU16(request.m_lastQuality);
+	buf.WriteDouble(request.m_bufferLevel);
+	buf.WriteDouble(request.m_rebufferTime);
+	buf.WriteU64(request.m_lastChunkStartTime.GetTimeStep());
+	buf.WriteU64(request.m_lastChunkFinishTime.GetTimeStep());
+	buf.WriteU64(request.m_lastChunkSize);
+	buf.WriteU32(request.m_cookie.size());
+	buf.Write((const uint8_t*)request.m_cookie.data(), request.m_cookie.size());
+}
+
+void SpDashAbrStateTag::Deserialize(TagBuffer buf) {
+	AbrRequest &request = m_state.m_request;
+	m_state.m_videoPath.resize(buf.ReadU32());
+	buf.Read((uint8_t*)&m_state.m_videoPath[0], m_state.m_videoPath.size());
+	request.m_segmentNum = buf.ReadU16();
+	request.m_lastQuality = buf.ReadU16();
+	request.m_bufferLevel = buf.ReadDouble();
+	request.m_rebufferTime = buf.ReadDouble();
+	request.m_lastChunkStartTime = TimeStep(buf.ReadU64());
+	request.m_lastChunkFinishTime = TimeStep(buf.ReadU64());
+	request.m_lastChunkSize = buf.ReadU64();
+	request.m_cookie.resize(buf.ReadU32());
+	buf.Read((uint8_t*)&request.m_cookie[0], request.m_cookie.size());
+}
+
+void SpDashAbrStateTag::Print(std::ostream &os) const {
+	os << "segment=" << m_state.m_request.m_segmentNum << " lastQuality=" << m_state.m_request.m_lastQuality
+			<< " buffer=" << m_state.m_request.m_bufferLevel;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,58 @@
+/*
+ * spdash-abr-state.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_STATE_H_
+#define SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_STATE_H_
+
+#include "ns3/abr-algorithm.h"
+#include "ns3/tag.h"
+#include <string>
+
+namespace ns3 {
+
+#define SPDASH_ABR_STATE_CONTENT_TYPE "application/x-spdash-state" ///< of a request carrying the state
+
+/*
+ * \brief Playback state a SpDash player sends with every segment request,
+ *        as the request body instead of a dozen text headers. Integers
+ *        are LEB128 varints, times are in ns and the buffer and rebuffer
+ *        levels in us (the precision the text headers had). Strings are
+ *        a varint length followed by the bytes.
+ */
+struct SpDashAbrState {
+	std::string m_videoPath;
+	AbrRequest m_request;
+
+	uint32_t GetSerializedSize() const;
+	void Serialize(std::string &out) const; ///< appends to out
+	bool Deserialize(const uint8_t *buf, uint32_t len); ///< false if buf is truncated or malformed
+};
+
+/*
+ * \brief The same state, typed, as a byte tag on the request body. The
+ *        player sends a virtual body of SpDashAbrState::GetSerializedSize()
+ *        bytes carrying the tag, so the wire size stays that of the
+ *        encoding while neither side encodes or decodes anything. The
+ *        handler still decodes a real body of a client without the tag.
+ */
+class SpDashAbrStateTag: public Tag {
+public:
+	static TypeId GetTypeId(void);
+	SpDashAbrStateTag();
+	SpDashAbrStateTag(const SpDashAbrState &state);
+	virtual TypeId GetInstanceTypeId(void) const;
+	virtual uint32_t GetSerializedSize(void) const;
+	virtual void Serialize(TagBuffer buf) const;
+	virtual void Deserialize(TagBuffer buf);
+	virtual void Print(std::ostream &os) const;
+
+	SpDashAbrState m_state;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_SPDASH_SPDASH_ABR_STATE_H_ */
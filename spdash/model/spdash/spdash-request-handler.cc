@@ -7,14 +7,14 @@
 
 #include "spdash-request-handler.h"
 #include <ns3/core-module.h>
-#include <stdio.h>
-#include <sys/socket.h>
-#include <arpa/inet.h>
-#include <unistd.h>
-#include <string.h>
-#include "ns3/nlohmann_json.h"
-
-using json = nlohmann::json;
+#include "ns3/throughput-abr.h"
+#include "ns3/video-catalog.h"
+#include "spdash-abr-state.h"
+#include "spdash-abr-coordinator.h"
+#include "ns3/pointer.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/http-server.h"
+#include "ns3/socket.h"
 
 namespace ns3 {
 
@@ -40,11 +40,21 @@ TypeId SpDashRequestHandler::GetTypeId(void) {
 	static TypeId tid = TypeId("ns3::SpDashRequestHandler")
 			.SetParent<HttpServerBaseRequestHandler>()
 			.SetGroupName("Applications")
-			.AddConstructor<SpDashRequestHandler>();
+			.AddConstructor<SpDashRequestHandler>()
+			.AddAttribute("AbrTypeId",
+					"TypeId of the AbrAlgorithm used to select segment quality",
+					TypeIdValue(ThroughputAbr::GetTypeId()),
+					MakeTypeIdAccessor(&SpDashRequestHandler::GetAbrTypeId, &SpDashRequestHandler::SetAbrTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("RadioMonitor",
+					"SandRadioMonitor whose view of the client's radio state is handed to the abr, none if null",
+					PointerValue(),
+					MakePointerAccessor(&SpDashRequestHandler::m_radioMonitor),
+					MakePointerChecker<SandRadioMonitor>());
 	return tid;
 }
 
-SpDashRequestHandler::SpDashRequestHandler(): m_toSent(0), m_sent(0) {
+SpDashRequestHandler::SpDashRequestHandler(): m_toSent(0), m_sent(0), m_videoData(NULL), m_segmentNum(0) {
 	NS_LOG_FUNCTION(this);
 	// m_videoPathMissing = true;
 }
@@ -62,11 +72,10 @@ void SpDashRequestHandler::ReadyToSend(uint32_t freeBufLen) {
 
 	NS_ASSERT(m_sent <= m_toSent);
 
+	//the body is synthetic, fill the whole tx space with a virtual packet
 	clen_t needToSent = std::min((clen_t)(m_toSent - m_sent), (clen_t)0xffffffff);
-	uint8_t buf[1024];
-	uint32_t tobeSend = std::min(freeBufLen, (uint32_t)sizeof(buf));
-	tobeSend = std::min(tobeSend, (uint32_t)needToSent);
-	uint32_t sent = Send(buf, tobeSend);
+	uint32_t tobeSend = std::min(freeBufLen, (uint32_t)needToSent);
+	uint32_t sent = SendVirtual(tobeSend);
 	NS_ASSERT(sent == tobeSend);
 	m_sent += sent;
 }
@@ -75,224 +84,151 @@ void SpDashRequestHandler::SocketClosed() {
 	NS_LOG_FUNCTION(this);
 }
 
-int SpDashRequestHandler::ReadInVideoInfo() {
+void SpDashRequestHandler::Reset() {
+	HttpServerBaseRequestHandler::Reset();
+	m_toSent = 0;
+	m_sent = 0;
+	m_videoFilePath.clear();
+	m_videoData = NULL;
+	m_abr = 0;
+	m_segmentNum = 0;
+	m_abrRequest = AbrRequest();
+}
+
+//store info in server
+void SpDashRequestHandler::RequestHeaderReceived() {
 	NS_LOG_FUNCTION(this);
-	// m_videoFilePath = "src/spdash/examples/vid.txt";	 //remove it
-	std::ifstream myfile;
-	myfile.open(m_videoFilePath);
-	NS_ASSERT(myfile);
-	if (!myfile) {
-		return -1;
-	}
-	std::string temp;
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
-	}
-	std::istringstream buffer(temp);
-	std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-			std::istream_iterator<uint64_t>());
-	m_videoData.m_segmentDuration = line.front();
-	//read bitrates
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
-	}
-	buffer = std::istringstream(temp);
-	std::vector<double> linef((std::istream_iterator<double>(buffer)),
-			std::istream_iterator<double>());
-	m_videoData.m_averageBitrate = linef;
-	//read bitrates
-	uint16_t numsegs = 0;
-	while (std::getline(myfile, temp)) {
-		if (temp.empty()) {
-			break;
+	if(GetHeader("Content-Type") != SPDASH_ABR_STATE_CONTENT_TYPE) {	//mpd
+		clen_t responseLen;
+		if(!GetRequest()->GetHeaderNumber("X-Require-Length", responseLen)) {
+			NS_LOG_WARN("Malformed X-Require-Length " << GetHeader("X-Require-Length"));
+			SetClen(0);
+			SetStatus(400, "Bad Request");
+			EndHeader();
+			return;
 		}
-		std::istringstream buffer(temp);
-		std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-				std::istream_iterator<uint64_t>());
-		m_videoData.m_segmentSizes.push_back(line);
-		NS_ASSERT(numsegs == 0 || numsegs == line.size());
-		numsegs = line.size();
+		AddHeader("X-LastQuality","0");
+		AddHeader("X-Cookie","");
+		SendResponseHeader(responseLen);
+		return;
 	}
-	m_videoData.m_numSegments = numsegs;
-	NS_ASSERT_MSG(!m_videoData.m_segmentSizes.empty(),
-			"No segment sizes read from file.");
-	return 1;
+	//the abr state is the body, it may arrive with the header or later
+	if(IsRequestComplete())
+		SegmentRequestReceived();
 }
 
-std::string SpDashRequestHandler::CreateRequestString( std::string cookie, std::string nextChunkId, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize) {
-	json jsonBody;
-	jsonBody["bitrateArray"] = m_videoData.m_averageBitrate;
-
-	if(cookie=="")
-		jsonBody["cookie"] = nullptr;
-	else
-		jsonBody["cookie"] = cookie;
-	std::cout<<"cookie="<<cookie<<"; nextChunkId="<<nextChunkId<<"; lastQuality="<<lastQuality<<"; buffer="<<buffer<<"; lastRequest="<<lastRequest<<"; rebufferTime="<<rebufferTime<<"; lastChunkFinishTime="<<lastChunkFinishTime<<"; lastChunkStartTime="<<lastChunkStartTime<<"; lastChunkSize="<<lastChunkSize<<"\n";
-	jsonBody["nextChunkId"] = stoul(nextChunkId);
-	// std::cout<<"okay\n"<<lastQuality<<"\n"<<buffer<<"\n";
-	jsonBody["lastquality"] = stoul(lastQuality);
-	// std::cout<<"okay\n";
-	jsonBody["buffer"] = stod(buffer);  //in seconds
-
-	jsonBody["lastRequest"] = stoul(lastRequest);
-	jsonBody["rebufferTime"] = stod(rebufferTime);
-	// std::cout<<"okay\n";
-	jsonBody["lastChunkFinishTime"] = stoul(lastChunkFinishTime);
-	jsonBody["lastChunkStartTime"] = stoul(lastChunkStartTime);
-	// std::cout<<"okay"<<lastChunkSize<<"\n";
-	jsonBody["lastChunkSize"] = stoul(lastChunkSize);
-	// std::cout<<"okay\n";
-	std::string jsonString = jsonBody.dump(4);
-	int contentLength = jsonString.length();
-	std::string requestString = "POST / HTTP/1.1\r\nUser-Agent: Mozilla/4.0 (compatible; MSIE5.01; Windows NT)\r\nHost: www.tutorialspoint.com\r\nContent-Type: text/xml; charset=utf-8\r\nContent-Length: " + std::to_string(contentLength) + "\r\nAccept-Language: en-us\r\nAccept-Encoding: gzip, deflate\r\nConnection: Keep-Alive\r\n\r\n"+jsonString;
-	// std::cout<<"jstring="<<requestString<<"\n";
-	return requestString;
+void SpDashRequestHandler::RequestDataReceived() {
+	NS_LOG_FUNCTION(this);
+	if(IsRequestComplete() && GetHeader("Content-Type") == SPDASH_ABR_STATE_CONTENT_TYPE)
+		SegmentRequestReceived();
 }
 
-//Adds header in response
-int SpDashRequestHandler::Abr( std::string cookie, std::string segmentNum, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize) {
-	const int PORT=8333;
-	int sock = 0, valread;
-    struct sockaddr_in serv_addr;
-
-    std::string to_send = CreateRequestString( cookie, segmentNum, lastQuality, buffer, lastRequest, rebufferTime, lastChunkFinishTime, lastChunkStartTime, lastChunkSize);
-
-    // std::cout<< "POST / HTTP/1.1\r\nUser-Agent: Mozilla/4.0 (compatible; MSIE5.01; Windows NT)\r\nHost: www.tutorialspoint.com\r\nContent-Type: text/xml; charset=utf-8\r\nContent-Length: 260\r\nAccept-Language: en-us\r\nAccept-Encoding: gzip, deflate\r\nConnection: Keep-Alive\r\n\r\n{\n\"bitrateArray\":[400000,600000,1000000,1500000,2500000,4000000],\n\"cookie\":null,\n\"nextChunkId\":1,\n\"lastquality\":1,\n\"buffer\":8,\n\"lastRequest\":0,\n\"rebufferTime\":0,\n\"lastChunkFinishTime\":1594907984144,\n\"lastChunkStartTime\":1594907984101,\n\"lastChunkSize\":1366834\n}"<<"\n";
-    const char *AbrRequest = to_send.c_str();
-
-    printf("\n####################AbrRequest#######################\n%s\n",AbrRequest);
-
-    char buff[1024] = {0};
-    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0)
-    {
-        printf("\n Socket creation error \n");
-        return -1;
-    }
-
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_port = htons(PORT);
-
-    // Convert IPv4 and IPv6 addresses from text to binary form
-    if(inet_pton(AF_INET, "127.0.0.1", &serv_addr.sin_addr)<=0)
-    {
-        printf("\nInvalid address/ Address not supported \n");
-        return -1;
-    }
-
-    if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0)
-    {
-        printf("\nConnection Failed \n");
-        return -1;
-    }
-    // else
-    // 	printf("connected\n");
-    send(sock , AbrRequest , strlen(AbrRequest) , 0 );
-    // printf("Hello message sent\n");
-    // bool firstTime = true;
-    std::string entireContent;
-    while(1)
-    {
-    	// firstTime=false;
-	    valread = read( sock , buff, 1024);
-	    if(valread<=0)
-	    	break;
-	    buff[valread] = '\0';
-	    entireContent += buff;
-	    // printf("%d %s####\n",valread,buff );
+void SpDashRequestHandler::SegmentRequestReceived() {
+	NS_LOG_FUNCTION(this);
+	SpDashAbrStateTag tag;
+	if(!PeekRequestTag(tag)) {
+		//a client that sent the encoded state itself
+		m_stateBuf.resize(GetRequest()->GetContentLength());
+		uint32_t len = m_stateBuf.empty() ? 0 : Recv(m_stateBuf.data(), m_stateBuf.size());
+		if(!tag.m_state.Deserialize(m_stateBuf.data(), len)) {
+			NS_LOG_WARN("Malformed abr state of " << len << " bytes");
+			SetClen(0);
+			SetStatus(400, "Bad Request");
+			EndHeader();
+			return;
+		}
 	}
-	//std::cout<< "entire response<<<<" << entireContent << "<<<<<<<<<\n\n\n\n" ;
-	// for(unsigned int i=0 ; i < entireContent.length();i++) {
-	// 	std::cout<<int(entireContent[i])<<entireContent[i]<<"\n";
-	// }
-	std::string delimiter = "\r\n\r\n";
-	std::string responseBody = entireContent.substr(entireContent.find(delimiter)+4 , std::string::npos);
-	// std::cout<< "substr = "<<responseBody<<"\n";
-	json jsonResponse = json::parse(responseBody);
-	for (auto it = jsonResponse.begin(); it != jsonResponse.end(); ++it)
-	{
-		// AddHeader(it.key(),it.value());
-	    std::cout<<(it.key())<<" "<<(it.value())<<"\n";
+	const SpDashAbrState &state = tag.m_state;
+	const AbrRequest &abrRequest = state.m_request;
+	NS_LOG_INFO("header received in server nextsegmentNum=" << abrRequest.m_segmentNum
+			<< " finish time=" << abrRequest.m_lastChunkFinishTime << " start time=" << abrRequest.m_lastChunkStartTime
+			<< " buffer=" << abrRequest.m_bufferLevel << " lastQuality=" << abrRequest.m_lastQuality);
+
+	m_videoFilePath = state.m_videoPath;
+	m_videoData = VideoCatalog::Get(m_videoFilePath);
+	if(!m_videoData || abrRequest.m_segmentNum >= m_videoData->m_numSegments) {
+		NS_LOG_WARN("No segment " << abrRequest.m_segmentNum << " of " << m_videoFilePath);
+		m_videoData = NULL;
+		SetClen(0);
+		SetStatus(404, "Not Found");
+		EndHeader();
+		return;
 	}
-	AddHeader("X-LastQuality",std::to_string(int(jsonResponse["quality"])));
-	AddHeader("X-Cookie",jsonResponse["cookie"]);
-	// std::cout<<"\n";
-	// std::cout<<"Exiting ABR-------------------------\n";
-    return int(jsonResponse["quality"]);
+	m_abr = m_abrFactory.Create<AbrAlgorithm>();
+	m_abr->SetVideoData(m_videoData);
+	m_segmentNum = abrRequest.m_segmentNum;
+	m_abrRequest = abrRequest;
+	FillRadioInfo(m_abrRequest.m_radio);
+	//the answer may come later if the abr batches requests
+	m_abr->RequestQuality(m_abrRequest, MakeCallback(&SpDashRequestHandler::AbrDecided, Ptr<SpDashRequestHandler>(this)));
 }
 
-//store info in server
-void SpDashRequestHandler::RequestHeaderReceived() {
-	NS_LOG_FUNCTION(this);
-	// std::string responseLen = GetHeader("X-Require-Length");
-	std::string responseLen = GetHeader("X-Require-Length");	//non zero for mpd
-	std::cout<<"\n";
-	if(stoul(responseLen)==0)	//if not mpd
-	{
-		m_videoFilePath = GetHeader("X-PathToVideo");
-		std::string segmentNum = GetHeader("X-Require-Segment-Num");
-		std::string lastChunkFinishTime = GetHeader("X-LastChunkFinishTime");
-		std::string lastChunkStartTime =GetHeader("X-LastChunkStartTime");
-		std::string buffer = (GetHeader)("X-BufferUpto");
-		std::string lastChunkSize = GetHeader("X-LastChunkSize");
-		std::string cookie = GetHeader("X-Cookie");
-		std::string lastQuality = GetHeader("X-LastQuality");
-		std::string rebufferTime = GetHeader("X-Rebuffer");
-		ReadInVideoInfo();
-		// if(type=="path")
-		// {
-		// 	m_videoPathMissing = false;
-		// 	m_videoFilePath = GetHeader("videoPath");
-		// 	std::cout<<"path::"<<m_videoFilePath<<"\n";
-		// 	ReadInVideoInfo();
-		// 	SetStatus(200, "OK");
-		// 	EndHeader();
-		// 	return;
-		// }
-		// std::string cookie = "";
-		// std::string lastQuality = "0";
-		// for(unsigned int i=0;i<m_videoData.m_averageBitrate.size();i++)
-		// {
-		// 	std::cout<<"    "<<m_videoData.m_averageBitrate[i]<<"\n";
-		// }
-
-		// std::cout<<"m_lastChunkSize = "<<m_lastChunkSize<<"\n";
-		//last_request = segNum-1 //buff
-		std::string lastRequest = std::to_string(stoi(segmentNum)-1);
-		// std::string rebufferTime = "0";
-		// std::string lastChunkSize = "1223";
-		std::cout<<"header received in server"<<" nextsegmentNum="<<segmentNum<<" finish time="<<lastChunkFinishTime<<" start time="<<lastChunkStartTime<<" buffer="<<buffer<<" lastQuality="<<lastQuality<<"\n";
-		int nextQualityNum = Abr( cookie, segmentNum, lastQuality, buffer, lastRequest, rebufferTime, lastChunkFinishTime, lastChunkStartTime, lastChunkSize);
-		std::cout<<"nextQualityNum = "<<nextQualityNum<<"\n";
-		if(nextQualityNum == -1) {
-			std::cerr<<"can't connect to Abr server\n";
-			return;
-		}
-		//nextqua
-		// std::string nextQualityNumCookie = GetQualityFromAbr(m_videoData,cookie,segmentNum,lastQuality,lastRequest,lastChunkFinishTime,lastChunkStartTime,lastChunkSize);
-		auto nextSegmentLength = m_videoData.m_segmentSizes.at(
-				nextQualityNum).at(stoi(segmentNum));
+/*
+ * The player's address: the one an HttpCacheProxy in between put into
+ * X-Forwarded-For, else the peer of the connection.
+ */
+bool SpDashRequestHandler::GetClientAddress(Address &client) {
+	std::string forwarded = GetHeader("X-Forwarded-For");
+	if(!forwarded.empty()) {
+		forwarded = forwarded.substr(0, forwarded.find(','));
+		client = InetSocketAddress(Ipv4Address(forwarded.c_str()), 0);
+		return true;
+	}
+	return IsRunning() && GetSocket()->GetPeerName(client) == 0;
+}
 
-		responseLen = std::to_string(nextSegmentLength);
+/*
+ * Radio state of the client's UE, if the RadioMonitor knows its address.
+ */
+void SpDashRequestHandler::FillRadioInfo(AbrRadioInfo &radio) {
+	Address peer;
+	if(m_radioMonitor == 0 || !GetClientAddress(peer) || !InetSocketAddress::IsMatchingType(peer))
+		return;
+	m_radioMonitor->GetRadioInfo(InetSocketAddress::ConvertFrom(peer).GetIpv4(), radio);
+}
 
-		// m_lastChunkSize = nextSegmentLength;
-	}
-	else {
-		AddHeader("X-LastQuality","0");
-		AddHeader("X-Cookie","");
+/*
+ * With a coordinator on the server the decision of the client's own
+ * algorithm is only an upper bound, the coordinator settles it together
+ * with the other clients.
+ */
+void SpDashRequestHandler::AbrDecided(AbrDecision decision) {
+	NS_LOG_FUNCTION(this);
+	Ptr<SpDashAbrCoordinator> coordinator;
+	if(GetServer())
+		coordinator = GetServer()->GetObject<SpDashAbrCoordinator>();
+	Address peer;
+	if(coordinator == 0 || !IsRunning() || !GetClientAddress(peer)) {
+		QualitySelected(decision);
+		return;
 	}
+	coordinator->Submit(peer, m_videoData, m_abrRequest, decision,
+			MakeCallback(&SpDashRequestHandler::QualitySelected, Ptr<SpDashRequestHandler>(this)));
+}
 
+void SpDashRequestHandler::QualitySelected(AbrDecision decision) {
+	NS_LOG_FUNCTION(this);
+	AddHeader("X-LastQuality", std::to_string(decision.m_quality));
+	AddHeader("X-Cookie", decision.m_cookie);
+	SendResponseHeader(m_videoData->GetSegmentSize(decision.m_quality, m_segmentNum));
+}
 
-	AddHeader("X-LastChunkSize",responseLen);
-	// AddHeader("field", "response test");
-	if(!responseLen.empty())
-		m_toSent = std::stoul(responseLen);
+void SpDashRequestHandler::SendResponseHeader(clen_t len) {
+	NS_LOG_FUNCTION(this);
+	m_toSent = len;
 	SetClen(m_toSent);
 	SetStatus(200, "OK");
 	EndHeader();
 }
 
+void SpDashRequestHandler::SetAbrTypeId(TypeId tid) {
+	m_abrFactory.SetTypeId(tid);
+}
+
+TypeId SpDashRequestHandler::GetAbrTypeId(void) const {
+	return m_abrFactory.GetTypeId();
+}
+
 } /* namespace ns3 */
 // in client side -> chunk id, d_start&finish, buffer length,rebuffer, quality, current rebuffer
 // ns3 simulation - 1 server multiple clients (same video) different start time .... csv -> space separation, #header
@@ -10,6 +10,9 @@
 
 #include "ns3/http-server-base-request-handler.h"
 #include "spdash-common.h"
+#include "ns3/abr-algorithm.h"
+#include "ns3/sand-radio-monitor.h"
+#include "ns3/object-factory.h"
 
 namespace ns3 {
 
@@ -22,17 +25,30 @@ protected:
 	virtual void ReadyToSend(uint32_t);
 	virtual void SocketClosed();
 	virtual void RequestHeaderReceived();
+	virtual void RequestDataReceived();
+	virtual void Reset();
 private:
 	clen_t m_toSent;
 	clen_t m_sent;
 
 	// new
 	std::string m_videoFilePath;
-	VideoData m_videoData;
+	const VideoData *m_videoData;
+	ObjectFactory m_abrFactory;
+	Ptr<AbrAlgorithm> m_abr;
+	Ptr<SandRadioMonitor> m_radioMonitor;
 	// int m_lastChunkSize;
-	int ReadInVideoInfo();
-	int Abr(std::string cookie, std::string nextChunkId, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize);
-	std::string CreateRequestString( std::string cookie, std::string nextChunkId, std::string lastQuality, std::string buffer, std::string lastRequest, std::string rebufferTime, std::string lastChunkFinishTime, std::string lastChunkStartTime, std::string lastChunkSize);
+	uint16_t m_segmentNum;
+	std::vector<uint8_t> m_stateBuf; //!< request body, the serialized abr state
+	AbrRequest m_abrRequest; //!< of the segment being requested
+	void SegmentRequestReceived();
+	bool GetClientAddress(Address &client);
+	void FillRadioInfo(AbrRadioInfo &radio);
+	void AbrDecided(AbrDecision decision);
+	void QualitySelected(AbrDecision decision);
+	void SendResponseHeader(clen_t len);
+	void SetAbrTypeId(TypeId tid);
+	TypeId GetAbrTypeId(void) const;
 
 };
 
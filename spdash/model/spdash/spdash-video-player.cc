@@ -6,6 +6,9 @@
  */
 
 #include "spdash-video-player.h"
+#include "spdash-abr-state.h"
+#include "ns3/video-catalog.h"
+#include "ns3/tcp-socket-factory.h"
 
 namespace ns3 {
 
@@ -57,11 +60,23 @@ TypeId SpDashVideoPlayer::GetTypeId(void) {
 					"file path which stores logs of all clients",
 					StringValue(),
 					MakeStringAccessor(&SpDashVideoPlayer::m_allLogFile),
-					MakeStringChecker());
+					MakeStringChecker())
+			.AddAttribute("Multiplex",
+					"Send the requests as streams of one multiplexed connection",
+					BooleanValue(false),
+					MakeBooleanAccessor(&SpDashVideoPlayer::m_multiplex),
+					MakeBooleanChecker())
+			.AddAttribute("SocketFactory",
+					"TypeId of the socket factory requests are sent over",
+					TypeIdValue(TcpSocketFactory::GetTypeId()),
+					MakeTypeIdAccessor(&SpDashVideoPlayer::m_socketFactory),
+					MakeTypeIdChecker());
 	return tid;
 }
 
-SpDashVideoPlayer::SpDashVideoPlayer(): m_running(0), m_serverPort(0) {
+SpDashVideoPlayer::SpDashVideoPlayer(): m_running(0), m_serverPort(0), m_videoData(NULL),
+		m_lastQuality(0), m_lastChunkSize(0), m_multiplex(false),
+		m_socketFactory(TcpSocketFactory::GetTypeId()) {
 
 }
 
@@ -72,8 +87,8 @@ void SpDashVideoPlayer::StopApplication() {
 	NS_LOG_FUNCTION(this);
 	if(!m_running) return;
 
-	if(m_httpDownloader != 0){
-		m_httpDownloader->StopConnection();
+	if(m_clientPool != 0){
+		m_clientPool->StopAll();
 	}
 }
 
@@ -96,53 +111,11 @@ void SpDashVideoPlayer::StartApplication() {
 		m_onStartClient();
 	}
 
-	ReadInVideoInfo();
-	StartDash();
-}
-
-int SpDashVideoPlayer::ReadInVideoInfo() {
-	NS_LOG_FUNCTION(this);
-	std::ifstream myfile;
-	myfile.open(m_videoFilePath);
-	NS_ASSERT(myfile);
-	if (!myfile) {
-		return -1;
-	}
-	std::string temp;
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
-	}
-	std::istringstream buffer(temp);
-	std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-			std::istream_iterator<uint64_t>());
-	m_videoData.m_segmentDuration = line.front();
-	//read bitrates
-	std::getline(myfile, temp);
-	if (temp.empty()) {
-		return -1;
+	m_videoData = VideoCatalog::Get(m_videoFilePath);
+	if(!m_videoData) {
+		NS_FATAL_ERROR("Can't read video file " << m_videoFilePath);
 	}
-	buffer = std::istringstream(temp);
-	std::vector<double> linef((std::istream_iterator<double>(buffer)),
-			std::istream_iterator<double>());
-	m_videoData.m_averageBitrate = linef;
-	//read bitrates
-	uint16_t numsegs = 0;
-	while (std::getline(myfile, temp)) {
-		if (temp.empty()) {
-			break;
-		}
-		std::istringstream buffer(temp);
-		std::vector<uint64_t> line((std::istream_iterator<uint64_t>(buffer)),
-				std::istream_iterator<uint64_t>());
-		m_videoData.m_segmentSizes.push_back(line);
-		NS_ASSERT(numsegs == 0 || numsegs == line.size());
-		numsegs = line.size();
-	}
-	m_videoData.m_numSegments = numsegs;
-	NS_ASSERT_MSG(!m_videoData.m_segmentSizes.empty(),
-			"No segment sizes read from file.");
-	return 1;
+	StartDash();
 }
 
 /****************************************
@@ -169,7 +142,11 @@ void SpDashVideoPlayer::StartDash() {
 	// m_playback.m_state = DASH_PLAYER_STATE_MPD_DOWNLOADING;
 
 
-	m_httpDownloader = Create<HttpClientBasic>();
+	m_clientPool = CreateObject<HttpClientPool>();
+	m_clientPool->SetAttribute("Multiplex", BooleanValue(m_multiplex));
+	m_clientPool->SetAttribute("SocketFactory", TypeIdValue(m_socketFactory));
+	m_clientPool->SetNode(GetNode());
+	m_httpDownloader = m_clientPool->Acquire(m_serverAddress, m_serverPort);
 	m_httpDownloader->InitConnection(m_serverAddress, m_serverPort, "/mpd");
 	m_httpDownloader->SetCollectionCB(MakeCallback(&SpDashVideoPlayer::DownloadedCB, this).Bind(Ptr<Object>()), GetNode());
 	m_httpDownloader->AddReqHeader("videoPath",m_videoFilePath);
@@ -195,8 +172,8 @@ void SpDashVideoPlayer::StartDash() {
 
 void SpDashVideoPlayer::Downloaded() {
 	NS_LOG_FUNCTION(this);
-	HttpTrace trace = m_httpDownloader->GetTrace();
-	m_httpTrace.push_back(trace);
+	m_httpTrace.push_back(m_httpDownloader->TakeTrace());
+	m_clientPool->Release(m_httpDownloader);
 	if(!m_running) return;
 
 	switch (m_playback.m_state) {
@@ -217,9 +194,11 @@ void SpDashVideoPlayer::DownloadedCB(Ptr<Object> obj) {
 	NS_LOG_FUNCTION(this);
 
 
-	m_cookie = m_httpDownloader->GetResponse()->GetHeader("X-Cookie");
-	m_lastQuality = m_httpDownloader->GetResponse()->GetHeader("X-LastQuality");
-	m_lastChunkSize = m_httpDownloader->GetResponse()->GetHeader("X-LastChunkSize"); //check
+	const Ptr<HttpResponse> &response = m_httpDownloader->GetResponse();
+	m_cookie = response->GetHeader("X-Cookie");
+	std::string lastQuality = response->GetHeader("X-LastQuality");
+	m_lastQuality = lastQuality.empty() ? 0 : std::stoul(lastQuality);
+	m_lastChunkSize = response->GetContentLength();
 	// std::cout<<m_cookie<<" "<<m_lastQuality<<" "<<m_lastChunkSize<<"\n";
 	m_lastChunkFinishTime = Simulator::Now();
 	Simulator::ScheduleNow(&SpDashVideoPlayer::Downloaded, this);
@@ -239,7 +218,7 @@ void SpDashVideoPlayer::DashController() {
 	allClientLog<<Simulator::Now()<<" "<<m_clientId<<" "<<m_playback.m_curSegmentNum<<" "<<m_lastChunkSize<<" "<<m_lastChunkStartTime<<" "<<m_lastChunkFinishTime<<" "<<m_playback.m_bufferUpto<<" "<<m_totalRebuffer<<" "<<m_lastQuality<<" "<<m_currentRebuffer<<"\n";
 	allClientLog.close();
 
-	if(m_playback.m_curSegmentNum < m_videoData.m_numSegments - 1) {
+	if(m_playback.m_curSegmentNum < m_videoData->m_numSegments - 1) {
 		Time delay = std::max(m_playback.m_bufferUpto - Time(std::to_string(MIN_BUFFER_LENGTH) + "s"), Time(0));
 		Simulator::Schedule(delay, &SpDashVideoPlayer::DownloadNextSegment, this);
 	}
@@ -254,7 +233,7 @@ void SpDashVideoPlayer::DownloadNextSegment() {
 	if(!m_running) return;
 
 	m_playback.m_curSegmentNum += 1;
-	if(m_playback.m_curSegmentNum == m_videoData.m_numSegments) {
+	if(m_playback.m_curSegmentNum == m_videoData->m_numSegments) {
 		m_playback.m_state = DASH_PLAYER_STATE_FINISHED;
 		return;
 	}
@@ -265,18 +244,25 @@ void SpDashVideoPlayer::DownloadNextSegment() {
 	// 		m_playback.m_nextQualityNum).at(m_playback.m_curSegmentNum);
 	std::string url = "/seg-" + std::to_string(m_playback.m_curSegmentNum)
 			+ "-" + std::to_string(m_playback.m_nextQualityNum);
+	m_httpDownloader = m_clientPool->Acquire(m_serverAddress, m_serverPort);
+	m_httpDownloader->SetCollectionCB(MakeCallback(&SpDashVideoPlayer::DownloadedCB, this).Bind(Ptr<Object>()), GetNode());
 	m_httpDownloader->InitConnection(m_serverAddress, m_serverPort, url);
 	// m_httpDownloader->AddReqHeader("X-Require-Length", std::to_string(nextSegmentLength));
-	m_httpDownloader->AddReqHeader("X-PathToVideo",m_videoFilePath);
-	m_httpDownloader->AddReqHeader("X-Require-Segment-Num", std::to_string(m_playback.m_curSegmentNum));
-	m_httpDownloader->AddReqHeader("X-LastChunkFinishTime", std::to_string(m_lastChunkFinishTime.GetNanoSeconds()));
-	m_httpDownloader->AddReqHeader("X-LastChunkStartTime", std::to_string(m_lastChunkStartTime.GetNanoSeconds()));
-	m_httpDownloader->AddReqHeader("X-BufferUpto", std::to_string(m_playback.m_bufferUpto.GetSeconds()));
-	m_httpDownloader->AddReqHeader("X-Require-Length", std::to_string(0));
-	m_httpDownloader->AddReqHeader("X-LastChunkSize",m_lastChunkSize);
-	m_httpDownloader->AddReqHeader("X-Cookie",m_cookie);
-	m_httpDownloader->AddReqHeader("X-LastQuality",m_lastQuality);
-	m_httpDownloader->AddReqHeader("X-Rebuffer",std::to_string(m_totalRebuffer.GetSeconds()));
+	//the abr state goes typed as a tag on the body, see SpDashAbrStateTag
+	SpDashAbrState state;
+	state.m_videoPath = m_videoFilePath;
+	state.m_request.m_segmentNum = m_playback.m_curSegmentNum;
+	state.m_request.m_lastQuality = m_lastQuality;
+	state.m_request.m_bufferLevel = m_playback.m_bufferUpto.GetSeconds();
+	state.m_request.m_rebufferTime = m_totalRebuffer.GetSeconds();
+	state.m_request.m_lastChunkStartTime = m_lastChunkStartTime;
+	state.m_request.m_lastChunkFinishTime = m_lastChunkFinishTime;
+	state.m_request.m_lastChunkSize = m_lastChunkSize;
+	state.m_request.m_cookie = m_cookie;
+	Ptr<Packet> body = Create<Packet>(state.GetSerializedSize());
+	body->AddByteTag(SpDashAbrStateTag(state));
+	m_httpDownloader->AddReqHeader("Content-Type", SPDASH_ABR_STATE_CONTENT_TYPE);
+	m_httpDownloader->SetReqBody(body);
 
 	m_lastChunkStartTime = Simulator::Now();	//time when download started
 	m_httpDownloader->Connect();
@@ -313,29 +299,17 @@ void SpDashVideoPlayer::AdjustVideoMetrices() {
 	m_lastIncident = Simulator::Now();
 
 	m_playback.m_playbackTime = curPlaybackTime;
-	m_playback.m_bufferUpto = curBufUpto + Time(std::to_string(m_videoData.m_segmentDuration) + "us");
+	m_playback.m_bufferUpto = curBufUpto + Time(std::to_string(m_videoData->m_segmentDuration) + "us");
 }
 
 void SpDashVideoPlayer::LogTrace() {
 	NS_LOG_FUNCTION(this);
 	if(m_tracePath.empty()) return;
 
-	std::ofstream outFile;
 	std::string fpath = m_tracePath + "-" + std::to_string(GetNode()->GetId()) + ".json";
-	outFile.open(fpath.c_str(), std::ofstream::out | std::ofstream::trunc);
-	if (!outFile.is_open()) {
+	if (!HttpTrace::StoreAll(fpath, m_httpTrace, false)) {
 		std::cerr << "Can't open file " << m_tracePath << std::endl;
-		return;
-	}
-	std::string separator = "";
-	outFile << "[" << std::endl;
-	for(auto it : m_httpTrace) {
-		outFile << separator;
-		it.StoreInFile(outFile);
-		outFile << std::endl;
-		separator = ",";
 	}
-	outFile << "]" << std::endl;
 }
 
 void SpDashVideoPlayer::LogABR() {
@@ -12,6 +12,7 @@
 #include "ns3/application.h"
 
 #include "ns3/http-client-basic.h"
+#include "ns3/http-client-pool.h"
 #include<fstream>
 
 namespace ns3 {
@@ -28,7 +29,6 @@ private:
 	virtual void StartApplication();
 	virtual void EndApplication();
 
-	int ReadInVideoInfo ();
 	void FinishedPlayback ();
 
 
@@ -54,21 +54,24 @@ private:
 	Address m_serverAddress;
 	uint16_t m_serverPort;
 	std::string m_videoFilePath;
-	VideoData m_videoData;
+	const VideoData *m_videoData;
 	SpDashPlaybackStatus m_playback;
 	Ptr<HttpClientBasic> m_httpDownloader;
+	Ptr<HttpClientPool> m_clientPool;
 	std::vector<HttpTrace> m_httpTrace;
 	std::string m_tracePath;
 	Time m_lastIncident;
 	Time m_lastChunkStartTime;
 	Time m_lastChunkFinishTime;
-	std::string m_lastQuality;
-	std::string m_lastChunkSize;
+	uint16_t m_lastQuality;
+	uint64_t m_lastChunkSize;
 	std::string m_cookie;
 	Time m_totalRebuffer;
 	Time m_currentRebuffer;
 	std::ofstream m_file;
 	std::string m_allLogFile;
+	bool m_multiplex;
+	TypeId m_socketFactory;
 
 	Callback<void> m_onStartClient;
 	Callback<void> m_onStopClient;
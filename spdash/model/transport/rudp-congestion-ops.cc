@@ -0,0 +1,191 @@
+/*
+ * rudp-congestion-ops.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "rudp-congestion-ops.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RudpCongestionOps");
+
+NS_OBJECT_ENSURE_REGISTERED(RudpCongestionOps);
+
+TypeId RudpCongestionOps::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpCongestionOps")
+			.SetParent<Object>()
+			.SetGroupName("Applications")
+			.AddAttribute("InitialWindow",
+					"Congestion window at the start, in packets",
+					UintegerValue(10),
+					MakeUintegerAccessor(&RudpCongestionOps::m_initialWindow),
+					MakeUintegerChecker<uint32_t>(2));
+	return tid;
+}
+
+RudpCongestionOps::RudpCongestionOps(): m_mss(1200), m_initialWindow(10),
+		m_cwnd(0), m_ssthresh(UINT32_MAX), m_recoveryStart(Seconds(-1)) {
+}
+
+RudpCongestionOps::~RudpCongestionOps() {
+}
+
+void RudpCongestionOps::Init(uint32_t mss) {
+	m_mss = mss;
+	m_cwnd = m_initialWindow * mss;
+	m_ssthresh = UINT32_MAX;
+}
+
+uint32_t RudpCongestionOps::GetCongestionWindow() const {
+	return m_cwnd;
+}
+
+bool RudpCongestionOps::InRecovery(Time sentTime) const {
+	return sentTime <= m_recoveryStart;
+}
+
+/**************************************************
+ *                   Rudp NewReno                 *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(RudpNewReno);
+
+TypeId RudpNewReno::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpNewReno")
+			.SetParent<RudpCongestionOps>()
+			.SetGroupName("Applications")
+			.AddConstructor<RudpNewReno>();
+	return tid;
+}
+
+RudpNewReno::RudpNewReno(): m_ackedBytes(0) {
+}
+
+void RudpNewReno::OnPacketAcked(uint32_t bytes, Time sentTime, Time rtt) {
+	if(InRecovery(sentTime))
+		return;
+	if(m_cwnd < m_ssthresh) {
+		m_cwnd += bytes;
+		return;
+	}
+	m_ackedBytes += bytes;
+	if(m_ackedBytes >= m_cwnd) {
+		m_ackedBytes -= m_cwnd;
+		m_cwnd += m_mss;
+	}
+}
+
+void RudpNewReno::OnPacketLost(uint32_t bytes, Time sentTime) {
+	if(InRecovery(sentTime))
+		return;
+	m_recoveryStart = Simulator::Now();
+	m_ssthresh = std::max(m_cwnd / 2, 2 * m_mss);
+	m_cwnd = m_ssthresh;
+	m_ackedBytes = 0;
+	NS_LOG_LOGIC("loss, cwnd " << m_cwnd);
+}
+
+void RudpNewReno::OnRetransmissionTimeout() {
+	m_recoveryStart = Simulator::Now();
+	m_ssthresh = std::max(m_cwnd / 2, 2 * m_mss);
+	m_cwnd = 2 * m_mss;
+	m_ackedBytes = 0;
+}
+
+std::string RudpNewReno::GetName() const {
+	return "NewReno";
+}
+
+/**************************************************
+ *                    Rudp Cubic                  *
+ **************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED(RudpCubic);
+
+TypeId RudpCubic::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpCubic")
+			.SetParent<RudpCongestionOps>()
+			.SetGroupName("Applications")
+			.AddConstructor<RudpCubic>()
+			.AddAttribute("C",
+					"Cubic scaling constant",
+					DoubleValue(0.4),
+					MakeDoubleAccessor(&RudpCubic::m_c),
+					MakeDoubleChecker<double>(0))
+			.AddAttribute("Beta",
+					"Window kept on loss",
+					DoubleValue(0.7),
+					MakeDoubleAccessor(&RudpCubic::m_beta),
+					MakeDoubleChecker<double>(0, 1));
+	return tid;
+}
+
+RudpCubic::RudpCubic(): m_c(0.4), m_beta(0.7), m_wMax(0), m_k(0), m_wEst(0),
+		m_epochStart(Seconds(-1)) {
+}
+
+void RudpCubic::OnPacketAcked(uint32_t bytes, Time sentTime, Time rtt) {
+	if(InRecovery(sentTime))
+		return;
+	if(m_cwnd < m_ssthresh) {
+		m_cwnd += bytes;
+		return;
+	}
+	double cwnd = (double) m_cwnd / m_mss;
+	if(m_epochStart.IsNegative()) {
+		m_epochStart = Simulator::Now();
+		if(m_wMax < cwnd) {
+			m_wMax = cwnd;
+			m_k = 0;
+		} else {
+			m_k = std::cbrt(m_wMax * (1 - m_beta) / m_c);
+		}
+		m_wEst = cwnd;
+	}
+	double t = (Simulator::Now() - m_epochStart + rtt).GetSeconds();
+	double target = m_c * std::pow(t - m_k, 3) + m_wMax;
+	double acked = (double) bytes / m_mss;
+	m_wEst += 3 * (1 - m_beta) / (1 + m_beta) * acked / cwnd;
+	target = std::max(target, m_wEst);
+	if(target > cwnd) {
+		//at most half a packet of growth per acked packet
+		double inc = std::min((target - cwnd) / cwnd, 0.5) * acked;
+		m_cwnd += std::max((uint32_t) (inc * m_mss), (uint32_t) 1);
+	}
+}
+
+void RudpCubic::OnPacketLost(uint32_t bytes, Time sentTime) {
+	if(InRecovery(sentTime))
+		return;
+	m_recoveryStart = Simulator::Now();
+	double cwnd = (double) m_cwnd / m_mss;
+	//fast convergence, give way to newer flows
+	m_wMax = cwnd < m_wMax ? cwnd * (1 + m_beta) / 2 : cwnd;
+	m_cwnd = std::max((uint32_t) (m_cwnd * m_beta), 2 * m_mss);
+	m_ssthresh = m_cwnd;
+	m_epochStart = Seconds(-1);
+	NS_LOG_LOGIC("loss, cwnd " << m_cwnd);
+}
+
+void RudpCubic::OnRetransmissionTimeout() {
+	m_recoveryStart = Simulator::Now();
+	m_wMax = (double) m_cwnd / m_mss;
+	m_ssthresh = std::max((uint32_t) (m_cwnd * m_beta), 2 * m_mss);
+	m_cwnd = 2 * m_mss;
+	m_epochStart = Seconds(-1);
+}
+
+std::string RudpCubic::GetName() const {
+	return "Cubic";
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,89 @@
+/*
+ * rudp-congestion-ops.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_TRANSPORT_RUDP_CONGESTION_OPS_H_
+#define SRC_SPDASH_MODEL_TRANSPORT_RUDP_CONGESTION_OPS_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/*
+ * \brief Congestion controller of a RudpSocket, chosen with its
+ *        CongestionControl attribute. The socket reports acked and lost
+ *        packets; losses of packets sent before the current recovery
+ *        period started do not reduce the window again.
+ */
+class RudpCongestionOps: public Object {
+public:
+	static TypeId GetTypeId(void);
+	RudpCongestionOps();
+	virtual ~RudpCongestionOps();
+
+	virtual void Init(uint32_t mss);
+	virtual void OnPacketAcked(uint32_t bytes, Time sentTime, Time rtt) = 0;
+	virtual void OnPacketLost(uint32_t bytes, Time sentTime) = 0;
+	virtual void OnRetransmissionTimeout() = 0;
+	virtual std::string GetName() const = 0;
+	uint32_t GetCongestionWindow() const;
+
+protected:
+	bool InRecovery(Time sentTime) const;
+
+	uint32_t m_mss;
+	uint32_t m_initialWindow; //!< in packets
+	uint32_t m_cwnd; //!< bytes
+	uint32_t m_ssthresh;
+	Time m_recoveryStart;
+};
+
+/*
+ * \brief Slow start, halving on loss and one packet per rtt of additive
+ *        increase, as RFC 9002 describes for QUIC.
+ */
+class RudpNewReno: public RudpCongestionOps {
+public:
+	static TypeId GetTypeId(void);
+	RudpNewReno();
+
+	virtual void OnPacketAcked(uint32_t bytes, Time sentTime, Time rtt);
+	virtual void OnPacketLost(uint32_t bytes, Time sentTime);
+	virtual void OnRetransmissionTimeout();
+	virtual std::string GetName() const;
+
+private:
+	uint32_t m_ackedBytes; //!< acked in congestion avoidance, not yet turned into window
+};
+
+/*
+ * \brief Cubic window growth (RFC 8312) with its tcp friendly region, the
+ *        window recovers to where the last loss happened independent of
+ *        the rtt, which suits long mmWave rtts after a blockage.
+ */
+class RudpCubic: public RudpCongestionOps {
+public:
+	static TypeId GetTypeId(void);
+	RudpCubic();
+
+	virtual void OnPacketAcked(uint32_t bytes, Time sentTime, Time rtt);
+	virtual void OnPacketLost(uint32_t bytes, Time sentTime);
+	virtual void OnRetransmissionTimeout();
+	virtual std::string GetName() const;
+
+private:
+	double m_c;
+	double m_beta;
+	double m_wMax; //!< packets
+	double m_k; //!< s
+	double m_wEst; //!< packets, the reno estimate
+	Time m_epochStart;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_TRANSPORT_RUDP_CONGESTION_OPS_H_ */
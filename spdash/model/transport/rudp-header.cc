@@ -0,0 +1,134 @@
+/*
+ * rudp-header.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "rudp-header.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED(RudpHeader);
+
+TypeId RudpHeader::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpHeader")
+			.SetParent<Header>()
+			.SetGroupName("Applications")
+			.AddConstructor<RudpHeader>();
+	return tid;
+}
+
+RudpHeader::RudpHeader(): m_type(RUDP_DATA), m_flags(0), m_connId(0), m_packetNumber(0),
+		m_offset(0), m_largestAcked(0), m_ackDelay(0), m_maxData(0) {
+}
+
+TypeId RudpHeader::GetInstanceTypeId(void) const {
+	return GetTypeId();
+}
+
+uint32_t RudpHeader::GetSerializedSize(void) const {
+	uint32_t size = RUDP_COMMON_HEADER_SIZE;
+	if(m_type == RUDP_DATA)
+		size += 16;
+	else if(m_type == RUDP_ACK)
+		size += 21 + 16 * std::min(m_ranges.size(), (size_t) RUDP_MAX_ACK_RANGES);
+	return size;
+}
+
+void RudpHeader::Serialize(Buffer::Iterator start) const {
+	start.WriteU8(m_type);
+	start.WriteU8(m_flags);
+	start.WriteHtonU32(m_connId);
+	if(m_type == RUDP_DATA) {
+		start.WriteHtonU64(m_packetNumber);
+		start.WriteHtonU64(m_offset);
+	} else if(m_type == RUDP_ACK) {
+		uint8_t num = std::min(m_ranges.size(), (size_t) RUDP_MAX_ACK_RANGES);
+		start.WriteHtonU64(m_largestAcked);
+		start.WriteHtonU32(m_ackDelay);
+		start.WriteHtonU64(m_maxData);
+		start.WriteU8(num);
+		for(uint8_t i = 0; i < num; i++) {
+			start.WriteHtonU64(m_ranges[i].first);
+			start.WriteHtonU64(m_ranges[i].second);
+		}
+	}
+}
+
+uint32_t RudpHeader::Deserialize(Buffer::Iterator start) {
+	m_type = start.ReadU8();
+	m_flags = start.ReadU8();
+	m_connId = start.ReadNtohU32();
+	m_ranges.clear();
+	if(m_type == RUDP_DATA) {
+		m_packetNumber = start.ReadNtohU64();
+		m_offset = start.ReadNtohU64();
+	} else if(m_type == RUDP_ACK) {
+		m_largestAcked = start.ReadNtohU64();
+		m_ackDelay = start.ReadNtohU32();
+		m_maxData = start.ReadNtohU64();
+		uint8_t num = start.ReadU8();
+		for(uint8_t i = 0; i < num; i++) {
+			uint64_t first = start.ReadNtohU64();
+			uint64_t last = start.ReadNtohU64();
+			m_ranges.push_back(std::make_pair(first, last));
+		}
+	}
+	return GetSerializedSize();
+}
+
+void RudpHeader::Print(std::ostream &os) const {
+	os << "type=" << (uint32_t) m_type << " conn=" << m_connId;
+	if(m_type == RUDP_DATA)
+		os << " pn=" << m_packetNumber << " offset=" << m_offset << " flags=" << (uint32_t) m_flags;
+	else if(m_type == RUDP_ACK)
+		os << " largest=" << m_largestAcked << " ranges=" << m_ranges.size() << " maxData=" << m_maxData;
+}
+
+/**************************************************
+ *                 Rudp Range Set                 *
+ **************************************************/
+
+void RudpRangeSet::Add(uint64_t first, uint64_t last) {
+	if(first >= last)
+		return;
+	auto it = m_ranges.upper_bound(first);
+	if(it != m_ranges.begin()) {
+		auto prev = std::prev(it);
+		if(prev->second >= first) {
+			first = prev->first;
+			last = std::max(last, prev->second);
+			it = m_ranges.erase(prev);
+		}
+	}
+	while(it != m_ranges.end() && it->first <= last) {
+		last = std::max(last, it->second);
+		it = m_ranges.erase(it);
+	}
+	m_ranges[first] = last;
+}
+
+bool RudpRangeSet::Contains(uint64_t first, uint64_t last) const {
+	auto it = m_ranges.upper_bound(first);
+	if(it == m_ranges.begin())
+		return false;
+	--it;
+	return it->second >= last;
+}
+
+uint64_t RudpRangeSet::GetFirstEnd(uint64_t from) const {
+	auto it = m_ranges.upper_bound(from);
+	if(it == m_ranges.begin())
+		return from;
+	--it;
+	return std::max(it->second, from);
+}
+
+void RudpRangeSet::Trim(uint32_t maxRanges) {
+	while(m_ranges.size() > maxRanges)
+		m_ranges.erase(m_ranges.begin());
+}
+
+} /* namespace ns3 */
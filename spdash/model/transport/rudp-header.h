@@ -0,0 +1,87 @@
+/*
+ * rudp-header.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_TRANSPORT_RUDP_HEADER_H_
+#define SRC_SPDASH_MODEL_TRANSPORT_RUDP_HEADER_H_
+
+#include "ns3/header.h"
+#include <map>
+#include <vector>
+
+/*
+ * Packets of the reliable udp transport, one per udp datagram, integers
+ * big endian:
+ *
+ *   common     u8 type, u8 flags, u32 connection id
+ *   DATA       u64 packet number, u64 stream offset, payload
+ *   ACK        u64 largest acked, u32 ack delay (us), u64 max data,
+ *              u8 n, n x { u64 first, u64 last } packet number ranges,
+ *              the newest range first
+ *   HELLO      (1-RTT setup only) answered by HELLO_ACK
+ *   CLOSE      the connection is aborted
+ *
+ * Packet numbers are never reused: a retransmission is a new packet
+ * carrying the old stream range, so every ACK gives an exact rtt sample.
+ * A DATA packet without payload and FIN is a probe that asks for an ACK.
+ */
+#define RUDP_DATA 0
+#define RUDP_ACK 1
+#define RUDP_HELLO 2
+#define RUDP_HELLO_ACK 3
+#define RUDP_CLOSE 4
+
+#define RUDP_FLAG_FIN 0x1
+
+#define RUDP_MAX_ACK_RANGES 32
+
+#define RUDP_COMMON_HEADER_SIZE 6
+
+namespace ns3 {
+
+class RudpHeader: public Header {
+public:
+	static TypeId GetTypeId(void);
+	RudpHeader();
+	virtual TypeId GetInstanceTypeId(void) const;
+	virtual uint32_t GetSerializedSize(void) const;
+	virtual void Serialize(Buffer::Iterator start) const;
+	virtual uint32_t Deserialize(Buffer::Iterator start);
+	virtual void Print(std::ostream &os) const;
+
+	uint8_t m_type;
+	uint8_t m_flags;
+	uint32_t m_connId;
+	//DATA
+	uint64_t m_packetNumber;
+	uint64_t m_offset;
+	//ACK
+	uint64_t m_largestAcked;
+	uint32_t m_ackDelay; ///< us
+	uint64_t m_maxData;
+	std::vector<std::pair<uint64_t, uint64_t> > m_ranges; ///< inclusive
+};
+
+/*
+ * \brief Set of disjoint [first, last) ranges, merged on insert. Used for
+ *        received packet numbers and for acknowledged stream bytes.
+ */
+class RudpRangeSet {
+public:
+	void Add(uint64_t first, uint64_t last);
+	bool Contains(uint64_t first, uint64_t last) const;
+	bool IsEmpty() const { return m_ranges.empty(); }
+	uint64_t GetFirstEnd(uint64_t from) const; ///< end of the range holding from, or from
+	void Trim(uint32_t maxRanges); ///< forgets the oldest ranges
+	const std::map<uint64_t, uint64_t>& GetRanges() const { return m_ranges; }
+
+private:
+	std::map<uint64_t, uint64_t> m_ranges; //!< first -> last (exclusive)
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_TRANSPORT_RUDP_HEADER_H_ */
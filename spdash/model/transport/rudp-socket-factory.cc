@@ -0,0 +1,47 @@
+/*
+ * rudp-socket-factory.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "rudp-socket-factory.h"
+#include "rudp-socket.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RudpSocketFactory");
+
+NS_OBJECT_ENSURE_REGISTERED(RudpSocketFactory);
+
+TypeId RudpSocketFactory::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpSocketFactory")
+			.SetParent<SocketFactory>()
+			.SetGroupName("Applications")
+			.AddConstructor<RudpSocketFactory>();
+	return tid;
+}
+
+RudpSocketFactory::RudpSocketFactory() {
+	NS_LOG_FUNCTION(this);
+	m_socketFactory.SetTypeId(RudpSocket::GetTypeId());
+}
+
+RudpSocketFactory::~RudpSocketFactory() {
+	NS_LOG_FUNCTION(this);
+}
+
+void RudpSocketFactory::SetSocketFactory(ObjectFactory factory) {
+	m_socketFactory = factory;
+}
+
+Ptr<Socket> RudpSocketFactory::CreateSocket(void) {
+	NS_LOG_FUNCTION(this);
+	Ptr<RudpSocket> socket = m_socketFactory.Create<RudpSocket>();
+	socket->SetNode(GetObject<Node>());
+	return socket;
+}
+
+} /* namespace ns3 */
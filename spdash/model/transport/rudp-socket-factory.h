@@ -0,0 +1,37 @@
+/*
+ * rudp-socket-factory.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_FACTORY_H_
+#define SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_FACTORY_H_
+
+#include "ns3/socket-factory.h"
+#include "ns3/object-factory.h"
+
+namespace ns3 {
+
+/*
+ * \brief Creates RudpSockets. RudpHelper aggregates one to each node, after
+ *        which Socket::CreateSocket() with this TypeId works like it does
+ *        for tcp, e.g. through the SocketFactory attribute of HttpServer
+ *        and HttpClientBasic.
+ */
+class RudpSocketFactory: public SocketFactory {
+public:
+	static TypeId GetTypeId(void);
+	RudpSocketFactory();
+	virtual ~RudpSocketFactory();
+
+	void SetSocketFactory(ObjectFactory factory); ///< a RudpSocket factory with attributes set
+	virtual Ptr<Socket> CreateSocket(void);
+
+private:
+	ObjectFactory m_socketFactory;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_FACTORY_H_ */
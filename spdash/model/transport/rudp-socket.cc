@@ -0,0 +1,833 @@
+/*
+ * rudp-socket.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "rudp-socket.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/udp-socket-factory.h"
+#include <algorithm>
+
+#define RUDP_PACKET_THRESHOLD 3
+#define RUDP_DRAIN_PTOS 3
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RudpSocket");
+
+NS_OBJECT_ENSURE_REGISTERED(RudpSocket);
+
+TypeId RudpSocket::GetTypeId(void) {
+	static TypeId tid = TypeId("ns3::RudpSocket")
+			.SetParent<Socket>()
+			.SetGroupName("Applications")
+			.AddConstructor<RudpSocket>()
+			.AddAttribute("SegmentSize",
+					"Largest stream payload of one udp datagram",
+					UintegerValue(1200),
+					MakeUintegerAccessor(&RudpSocket::m_mss),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("SndBufSize",
+					"Bytes queued for sending, including those not acked yet",
+					UintegerValue(131072),
+					MakeUintegerAccessor(&RudpSocket::m_sndBufSize),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("RcvBufSize",
+					"Bytes the receiver buffers, the flow control window",
+					UintegerValue(131072),
+					MakeUintegerAccessor(&RudpSocket::m_rcvBufSize),
+					MakeUintegerChecker<uint32_t>(1))
+			.AddAttribute("ZeroRtt",
+					"Send data with the first packet instead of waiting for a HELLO_ACK",
+					BooleanValue(true),
+					MakeBooleanAccessor(&RudpSocket::m_zeroRtt),
+					MakeBooleanChecker())
+			.AddAttribute("CongestionControl",
+					"TypeId of the RudpCongestionOps used",
+					TypeIdValue(RudpNewReno::GetTypeId()),
+					MakeTypeIdAccessor(&RudpSocket::m_ccTypeId),
+					MakeTypeIdChecker())
+			.AddAttribute("InitialRtt",
+					"Rtt assumed before the first sample",
+					TimeValue(MilliSeconds(333)),
+					MakeTimeAccessor(&RudpSocket::m_initialRtt),
+					MakeTimeChecker())
+			.AddAttribute("MaxAckDelay",
+					"How long the receiver may hold back an ACK",
+					TimeValue(MilliSeconds(25)),
+					MakeTimeAccessor(&RudpSocket::m_maxAckDelay),
+					MakeTimeChecker())
+			.AddAttribute("MaxRetries",
+					"Probe timeouts in a row before the connection fails",
+					UintegerValue(8),
+					MakeUintegerAccessor(&RudpSocket::m_maxRetries),
+					MakeUintegerChecker<uint32_t>(1));
+	return tid;
+}
+
+RudpSocket::RudpSocket(): m_connId(0), m_state(RUDP_IDLE), m_errno(ERROR_NOTERROR),
+		m_txBase(0), m_txEnd(0), m_nextOffset(0), m_peerMaxData(0), m_nextPn(0),
+		m_largestAcked(-1), m_bytesInFlight(0), m_sendClosed(false), m_finSent(false),
+		m_finAcked(false), m_closeCalled(false), m_rxSize(0), m_rxNext(0), m_finOffset(0),
+		m_finReceived(false), m_finDelivered(false), m_largestRecv(0), m_ackPending(0),
+		m_advertised(0), m_rttSampled(false), m_ptoCount(0), m_mss(1200),
+		m_sndBufSize(131072), m_rcvBufSize(131072), m_zeroRtt(true),
+		m_initialRtt(MilliSeconds(333)), m_maxAckDelay(MilliSeconds(25)), m_maxRetries(8) {
+	NS_LOG_FUNCTION(this);
+}
+
+RudpSocket::~RudpSocket() {
+	NS_LOG_FUNCTION(this);
+}
+
+void RudpSocket::DoDispose(void) {
+	NS_LOG_FUNCTION(this);
+	m_ackEvent.Cancel();
+	m_ptoEvent.Cancel();
+	m_drainEvent.Cancel();
+	m_children.clear();
+	m_listener = 0;
+	m_udp = 0;
+	m_cc = 0;
+	m_node = 0;
+	m_txData = 0;
+	m_rxOoo.clear();
+	m_rxQueue.clear();
+	Socket::DoDispose();
+}
+
+void RudpSocket::SetNode(Ptr<Node> node) {
+	m_node = node;
+}
+
+Time RudpSocket::GetSmoothedRtt() const {
+	return m_srtt;
+}
+
+uint32_t RudpSocket::GetCongestionWindow() const {
+	return m_cc != 0 ? m_cc->GetCongestionWindow() : 0;
+}
+
+enum Socket::SocketErrno RudpSocket::GetErrno(void) const {
+	return m_errno;
+}
+
+enum Socket::SocketType RudpSocket::GetSocketType(void) const {
+	return NS3_SOCK_STREAM;
+}
+
+Ptr<Node> RudpSocket::GetNode(void) const {
+	return m_node;
+}
+
+void RudpSocket::OpenUdp() {
+	if(m_udp == 0)
+		m_udp = Socket::CreateSocket(m_node, UdpSocketFactory::GetTypeId());
+}
+
+int RudpSocket::Bind(const Address &address) {
+	NS_LOG_FUNCTION(this << address);
+	OpenUdp();
+	return m_udp->Bind(address);
+}
+
+int RudpSocket::Bind() {
+	OpenUdp();
+	return m_udp->Bind();
+}
+
+int RudpSocket::Bind6() {
+	OpenUdp();
+	return m_udp->Bind6();
+}
+
+int RudpSocket::Close(void) {
+	NS_LOG_FUNCTION(this << m_connId);
+	if(m_state == RUDP_LISTEN) {
+		//children keep the udp socket until they are done
+		m_state = RUDP_CLOSED;
+		if(m_children.empty()) {
+			m_udp->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+			m_udp->Close();
+		}
+		return 0;
+	}
+	if(m_state == RUDP_IDLE) {
+		if(m_udp != 0)
+			m_udp->Close();
+		m_state = RUDP_CLOSED;
+		return 0;
+	}
+	if(m_state != RUDP_OPEN && m_state != RUDP_HELLO_SENT)
+		return 0;
+	m_closeCalled = true;
+	if(m_rxSize > 0 || m_state == RUDP_HELLO_SENT) {
+		//closing with unread data aborts, like tcp
+		Abort();
+		return 0;
+	}
+	return ShutdownSend();
+}
+
+int RudpSocket::ShutdownSend(void) {
+	NS_LOG_FUNCTION(this);
+	if(m_sendClosed)
+		return 0;
+	m_sendClosed = true;
+	Ptr<RudpSocket> self = this;
+	SendPending();
+	CheckDone();
+	return 0;
+}
+
+int RudpSocket::ShutdownRecv(void) {
+	return 0;
+}
+
+int RudpSocket::Connect(const Address &address) {
+	NS_LOG_FUNCTION(this << address);
+	if(m_state != RUDP_IDLE) {
+		m_errno = ERROR_ISCONN;
+		return -1;
+	}
+	if(m_udp == 0) {
+		OpenUdp();
+		if(Inet6SocketAddress::IsMatchingType(address))
+			m_udp->Bind6();
+		else
+			m_udp->Bind();
+	}
+	//connection ids only have to be unique per listener, a global counter will do
+	static uint32_t nextConnId = 1;
+	m_connId = nextConnId++;
+	m_peer = address;
+	InitConnection();
+	m_udp->SetRecvCallback(MakeCallback(&RudpSocket::ClientRecv, this));
+	if(m_zeroRtt) {
+		m_state = RUDP_OPEN;
+		Simulator::ScheduleNow(&RudpSocket::Connected, Ptr<RudpSocket>(this));
+	} else {
+		m_state = RUDP_HELLO_SENT;
+		SendControl(RUDP_HELLO);
+		ArmPto();
+	}
+	return 0;
+}
+
+int RudpSocket::Listen(void) {
+	NS_LOG_FUNCTION(this);
+	if(m_udp == 0 || m_state != RUDP_IDLE) {
+		m_errno = ERROR_INVAL;
+		return -1;
+	}
+	m_state = RUDP_LISTEN;
+	m_udp->SetRecvCallback(MakeCallback(&RudpSocket::ListenerRecv, this));
+	return 0;
+}
+
+uint32_t RudpSocket::GetTxAvailable(void) const {
+	uint64_t queued = m_txEnd - m_txBase;
+	if(m_sendClosed || m_state > RUDP_OPEN || queued >= m_sndBufSize)
+		return 0;
+	return m_sndBufSize - queued;
+}
+
+int RudpSocket::Send(Ptr<Packet> p, uint32_t flags) {
+	NS_LOG_FUNCTION(this << p->GetSize());
+	if(m_sendClosed || (m_state != RUDP_OPEN && m_state != RUDP_HELLO_SENT)) {
+		m_errno = m_state == RUDP_IDLE ? ERROR_NOTCONN : ERROR_SHUTDOWN;
+		return -1;
+	}
+	if(p->GetSize() > GetTxAvailable()) {
+		m_errno = ERROR_MSGSIZE;
+		return -1;
+	}
+	uint32_t len = p->GetSize();
+	if(len == 0)
+		return 0;
+	m_txData->AddAtEnd(p);
+	m_txEnd += len;
+	SendPending();
+	return len;
+}
+
+int RudpSocket::SendTo(Ptr<Packet> p, uint32_t flags, const Address &toAddress) {
+	return Send(p, flags);
+}
+
+uint32_t RudpSocket::GetRxAvailable(void) const {
+	return m_rxSize;
+}
+
+Ptr<Packet> RudpSocket::Recv(uint32_t maxSize, uint32_t flags) {
+	NS_LOG_FUNCTION(this << maxSize);
+	if(m_rxQueue.empty() || maxSize == 0) {
+		m_errno = ERROR_AGAIN;
+		return 0;
+	}
+	Ptr<Packet> packet = m_rxQueue.front();
+	if(packet->GetSize() > maxSize) {
+		Ptr<Packet> part = packet->CreateFragment(0, maxSize);
+		packet->RemoveAtStart(maxSize);
+		packet = part;
+	} else {
+		m_rxQueue.pop_front();
+	}
+	m_rxSize -= packet->GetSize();
+	//window update once half the buffer is read
+	if(m_state == RUDP_OPEN && !m_finReceived && GetMaxData() >= m_advertised + m_rcvBufSize / 2)
+		SendAck();
+	return packet;
+}
+
+Ptr<Packet> RudpSocket::RecvFrom(uint32_t maxSize, uint32_t flags, Address &fromAddress) {
+	fromAddress = m_peer;
+	return Recv(maxSize, flags);
+}
+
+int RudpSocket::GetSockName(Address &address) const {
+	if(m_udp == 0)
+		return -1;
+	return m_udp->GetSockName(address);
+}
+
+int RudpSocket::GetPeerName(Address &address) const {
+	if(m_state == RUDP_IDLE || m_state == RUDP_LISTEN) {
+		return -1;
+	}
+	address = m_peer;
+	return 0;
+}
+
+bool RudpSocket::SetAllowBroadcast(bool allowBroadcast) {
+	return !allowBroadcast;
+}
+
+bool RudpSocket::GetAllowBroadcast() const {
+	return false;
+}
+
+void RudpSocket::InitConnection() {
+	ObjectFactory factory;
+	factory.SetTypeId(m_ccTypeId);
+	m_cc = factory.Create<RudpCongestionOps>();
+	m_cc->Init(m_mss);
+	m_txData = Create<Packet>();
+	//no handshake to learn it, both sides use the same RcvBufSize
+	m_peerMaxData = m_rcvBufSize;
+	m_advertised = m_rcvBufSize;
+	m_srtt = m_initialRtt;
+	m_rttvar = NanoSeconds(m_initialRtt.GetNanoSeconds() / 2);
+}
+
+/**************************************************
+ *                   Demultiplexing               *
+ **************************************************/
+
+void RudpSocket::ListenerRecv(Ptr<Socket> udp) {
+	NS_LOG_FUNCTION(this);
+	Ptr<RudpSocket> self = this;
+	Ptr<Packet> packet;
+	Address from;
+	while((packet = udp->RecvFrom(from)) != 0) {
+		RudpHeader header;
+		if(packet->GetSize() < RUDP_COMMON_HEADER_SIZE)
+			continue;
+		packet->RemoveHeader(header);
+		auto it = m_children.find(header.m_connId);
+		if(it != m_children.end()) {
+			Ptr<RudpSocket> child = it->second;
+			child->m_peer = from; //the client may have moved
+			child->Process(header, packet);
+			continue;
+		}
+		if(header.m_type != RUDP_DATA && header.m_type != RUDP_HELLO)
+			continue;
+		auto closed = m_closedIds.find(header.m_connId);
+		bool wasClosed = closed != m_closedIds.end() && closed->second > Simulator::Now();
+		if(m_state != RUDP_LISTEN || wasClosed || !NotifyConnectionRequest(from)) {
+			SendClose(udp, header.m_connId, from);
+			continue;
+		}
+		Ptr<RudpSocket> child = CreateObject<RudpSocket>();
+		child->m_node = m_node;
+		child->m_udp = m_udp;
+		child->m_listener = this;
+		child->m_peer = from;
+		child->m_connId = header.m_connId;
+		child->m_mss = m_mss;
+		child->m_sndBufSize = m_sndBufSize;
+		child->m_rcvBufSize = m_rcvBufSize;
+		child->m_ccTypeId = m_ccTypeId;
+		child->m_initialRtt = m_initialRtt;
+		child->m_maxAckDelay = m_maxAckDelay;
+		child->m_maxRetries = m_maxRetries;
+		child->InitConnection();
+		child->m_state = RUDP_OPEN;
+		m_children[header.m_connId] = child;
+		NS_LOG_LOGIC("new connection " << header.m_connId);
+		NotifyNewConnectionCreated(child, from);
+		child->Process(header, packet);
+	}
+}
+
+void RudpSocket::ClientRecv(Ptr<Socket> udp) {
+	NS_LOG_FUNCTION(this);
+	Ptr<RudpSocket> self = this;
+	Ptr<Packet> packet;
+	Address from;
+	while(m_udp != 0 && (packet = udp->RecvFrom(from)) != 0) {
+		RudpHeader header;
+		if(packet->GetSize() < RUDP_COMMON_HEADER_SIZE)
+			continue;
+		packet->RemoveHeader(header);
+		if(header.m_connId == m_connId)
+			Process(header, packet);
+	}
+}
+
+/*
+ * Late packets of the connection are answered with CLOSE for drain, a
+ * few PTOs of the child, after that its id is forgotten so that the set
+ * stays as small as the number of recently closed connections.
+ */
+void RudpSocket::ChildDone(uint32_t connId, Time drain) {
+	NS_LOG_FUNCTION(this << connId);
+	m_children.erase(connId);
+	Time now = Simulator::Now();
+	for(auto it = m_closedIds.begin(); it != m_closedIds.end();) {
+		if(it->second <= now)
+			it = m_closedIds.erase(it);
+		else
+			++it;
+	}
+	m_closedIds[connId] = now + drain;
+	if(m_state == RUDP_CLOSED && m_children.empty() && m_udp != 0) {
+		m_udp->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+		m_udp->Close();
+	}
+}
+
+void RudpSocket::SendClose(Ptr<Socket> udp, uint32_t connId, const Address &to) {
+	RudpHeader header;
+	header.m_type = RUDP_CLOSE;
+	header.m_connId = connId;
+	Ptr<Packet> packet = Create<Packet>();
+	packet->AddHeader(header);
+	udp->SendTo(packet, 0, to);
+}
+
+/**************************************************
+ *                     Receiving                  *
+ **************************************************/
+
+void RudpSocket::Process(const RudpHeader &header, Ptr<Packet> payload) {
+	NS_LOG_FUNCTION(this << m_connId << (uint32_t) header.m_type);
+	switch(header.m_type) {
+	case RUDP_DATA:
+		ProcessData(header, payload);
+		break;
+	case RUDP_ACK:
+		ProcessAck(header);
+		break;
+	case RUDP_HELLO:
+		if(m_listener != 0 && m_state == RUDP_OPEN)
+			SendControl(RUDP_HELLO_ACK);
+		break;
+	case RUDP_HELLO_ACK:
+		if(m_state == RUDP_HELLO_SENT) {
+			m_state = RUDP_OPEN;
+			m_ptoCount = 0;
+			m_ptoEvent.Cancel();
+			Connected();
+		}
+		break;
+	case RUDP_CLOSE:
+		if(m_state == RUDP_OPEN || m_state == RUDP_HELLO_SENT)
+			Fail(ERROR_SHUTDOWN);
+		else if(m_state == RUDP_DRAINING)
+			Release();
+		break;
+	}
+}
+
+void RudpSocket::ProcessData(const RudpHeader &header, Ptr<Packet> payload) {
+	if(m_state != RUDP_OPEN && m_state != RUDP_DRAINING)
+		return;
+	uint64_t pn = header.m_packetNumber;
+	bool first = m_recvPns.IsEmpty();
+	bool duplicate = !first && m_recvPns.Contains(pn, pn + 1);
+	bool gap = first ? pn != 0 : pn != m_largestRecv + 1;
+	m_recvPns.Add(pn, pn + 1);
+	m_recvPns.Trim(2 * RUDP_MAX_ACK_RANGES);
+	if(first || pn > m_largestRecv) {
+		m_largestRecv = pn;
+		m_largestRecvAt = Simulator::Now();
+	}
+	if(m_state == RUDP_DRAINING) {
+		SendAck(); //the peer missed our last ACK
+		return;
+	}
+
+	uint64_t offset = header.m_offset;
+	uint32_t len = payload->GetSize();
+	uint64_t end = offset + len;
+	if(m_closeCalled && len > 0 && end > m_rxNext) {
+		//data for a connection we are done with, tell the peer to stop
+		Abort();
+		return;
+	}
+	if(header.m_flags & RUDP_FLAG_FIN) {
+		m_finReceived = true;
+		m_finOffset = end;
+	}
+	if(len > 0 && end > m_rxNext) {
+		if(offset < m_rxNext) {
+			payload = payload->CreateFragment(m_rxNext - offset, end - m_rxNext);
+			offset = m_rxNext;
+		}
+		auto it = m_rxOoo.find(offset);
+		if(it == m_rxOoo.end() || it->second->GetSize() < payload->GetSize())
+			m_rxOoo[offset] = payload;
+	}
+	bool delivered = false;
+	while(!m_rxOoo.empty() && m_rxOoo.begin()->first <= m_rxNext) {
+		uint64_t off = m_rxOoo.begin()->first;
+		Ptr<Packet> p = m_rxOoo.begin()->second;
+		m_rxOoo.erase(m_rxOoo.begin());
+		uint64_t pend = off + p->GetSize();
+		if(pend <= m_rxNext)
+			continue;
+		if(off < m_rxNext)
+			p = p->CreateFragment(m_rxNext - off, pend - m_rxNext);
+		m_rxQueue.push_back(p);
+		m_rxSize += p->GetSize();
+		m_rxNext = pend;
+		delivered = true;
+	}
+
+	//ack every second packet, anything unusual at once
+	m_ackPending++;
+	if(duplicate || gap || !m_rxOoo.empty() || m_ackPending >= 2 || m_finReceived)
+		SendAck();
+	else if(!m_ackEvent.IsRunning())
+		m_ackEvent = Simulator::Schedule(m_maxAckDelay, &RudpSocket::SendAck, this);
+
+	Ptr<RudpSocket> self = this;
+	if(delivered)
+		NotifyDataRecv();
+	if(m_finReceived && !m_finDelivered && m_rxNext >= m_finOffset && m_state == RUDP_OPEN) {
+		m_finDelivered = true;
+		NotifyNormalClose();
+		CheckDone();
+	}
+}
+
+void RudpSocket::ProcessAck(const RudpHeader &header) {
+	if(m_state != RUDP_OPEN && m_state != RUDP_DRAINING)
+		return;
+	NS_LOG_FUNCTION(this << header.m_largestAcked << header.m_ranges.size());
+	if(header.m_maxData > m_peerMaxData)
+		m_peerMaxData = header.m_maxData;
+
+	bool newlyAcked = false;
+	uint64_t oldBase = m_txBase;
+	for(auto &range : header.m_ranges) {
+		auto it = m_sent.lower_bound(range.first);
+		while(it != m_sent.end() && it->first <= range.second) {
+			const RudpSentPacket &pkt = it->second;
+			if(it->first == header.m_largestAcked) {
+				Time ackDelay = std::min(MicroSeconds(header.m_ackDelay), m_maxAckDelay);
+				UpdateRtt(Simulator::Now() - pkt.m_sentTime, ackDelay);
+			}
+			m_bytesInFlight -= pkt.m_len;
+			m_ackedOffsets.Add(pkt.m_offset, pkt.m_offset + pkt.m_len);
+			if(pkt.m_fin)
+				m_finAcked = true;
+			m_cc->OnPacketAcked(pkt.m_len, pkt.m_sentTime, m_srtt);
+			newlyAcked = true;
+			it = m_sent.erase(it);
+		}
+	}
+	if(m_largestAcked < (int64_t) header.m_largestAcked)
+		m_largestAcked = header.m_largestAcked;
+	if(newlyAcked) {
+		m_ptoCount = 0;
+		DetectLosses();
+		uint64_t base = m_ackedOffsets.GetFirstEnd(m_txBase);
+		if(base > m_txBase) {
+			m_txData->RemoveAtStart(base - m_txBase);
+			m_txBase = base;
+		}
+	}
+
+	Ptr<RudpSocket> self = this;
+	SendPending();
+	ArmPto();
+	if(m_txBase > oldBase && m_state == RUDP_OPEN && !m_sendClosed)
+		NotifySend(GetTxAvailable());
+	CheckDone();
+}
+
+void RudpSocket::Connected() {
+	NS_LOG_FUNCTION(this << m_connId);
+	if(m_state != RUDP_OPEN)
+		return;
+	NotifyConnectionSucceeded();
+	SendPending();
+}
+
+/**************************************************
+ *                      Sending                   *
+ **************************************************/
+
+void RudpSocket::SendPending() {
+	if(m_state != RUDP_OPEN)
+		return;
+	while(m_bytesInFlight + m_mss <= m_cc->GetCongestionWindow()) {
+		RudpSentPacket pkt;
+		if(!m_lost.empty()) {
+			pkt = m_lost.front();
+			m_lost.pop_front();
+			uint64_t end = pkt.m_offset + pkt.m_len;
+			if(m_ackedOffsets.Contains(pkt.m_offset, end) && (!pkt.m_fin || m_finAcked))
+				continue;
+			if(pkt.m_offset < m_txBase) {
+				//the front was acked by another copy
+				pkt.m_offset = std::min(m_txBase, end);
+				pkt.m_len = end - pkt.m_offset;
+			}
+		} else {
+			uint64_t limit = std::min(m_txEnd, m_peerMaxData);
+			bool finPending = m_sendClosed && !m_finSent && m_nextOffset == m_txEnd;
+			if(m_nextOffset >= limit && !finPending)
+				break;
+			pkt.m_offset = m_nextOffset;
+			pkt.m_len = std::min(limit - m_nextOffset, (uint64_t) m_mss);
+			m_nextOffset += pkt.m_len;
+			pkt.m_fin = m_sendClosed && m_nextOffset == m_txEnd;
+			if(pkt.m_fin)
+				m_finSent = true;
+		}
+		SendData(pkt);
+	}
+}
+
+void RudpSocket::SendData(RudpSentPacket pkt) {
+	Ptr<Packet> packet = pkt.m_len > 0 ? m_txData->CreateFragment(pkt.m_offset - m_txBase, pkt.m_len)
+			: Create<Packet>();
+	RudpHeader header;
+	header.m_type = RUDP_DATA;
+	header.m_flags = pkt.m_fin ? RUDP_FLAG_FIN : 0;
+	header.m_connId = m_connId;
+	header.m_packetNumber = m_nextPn++;
+	header.m_offset = pkt.m_offset;
+	packet->AddHeader(header);
+	NS_LOG_LOGIC("pn " << header.m_packetNumber << " offset " << pkt.m_offset << " len " << pkt.m_len);
+
+	pkt.m_sentTime = Simulator::Now();
+	m_sent[header.m_packetNumber] = pkt;
+	m_bytesInFlight += pkt.m_len;
+	Output(packet);
+	if(!m_ptoEvent.IsRunning())
+		ArmPto();
+}
+
+void RudpSocket::SendControl(uint8_t type) {
+	RudpHeader header;
+	header.m_type = type;
+	header.m_connId = m_connId;
+	Ptr<Packet> packet = Create<Packet>();
+	packet->AddHeader(header);
+	Output(packet);
+}
+
+void RudpSocket::SendAck() {
+	m_ackEvent.Cancel();
+	m_ackPending = 0;
+	if(m_recvPns.IsEmpty())
+		return;
+	RudpHeader header;
+	header.m_type = RUDP_ACK;
+	header.m_connId = m_connId;
+	header.m_largestAcked = m_largestRecv;
+	header.m_ackDelay = (Simulator::Now() - m_largestRecvAt).GetMicroSeconds();
+	header.m_maxData = GetMaxData();
+	auto &ranges = m_recvPns.GetRanges();
+	for(auto it = ranges.rbegin(); it != ranges.rend()
+			&& header.m_ranges.size() < RUDP_MAX_ACK_RANGES; ++it) {
+		header.m_ranges.push_back(std::make_pair(it->first, it->second - 1));
+	}
+	m_advertised = header.m_maxData;
+	Ptr<Packet> packet = Create<Packet>();
+	packet->AddHeader(header);
+	Output(packet);
+}
+
+void RudpSocket::Output(Ptr<Packet> packet) {
+	if(m_udp == 0)
+		return;
+	//a full udp buffer is a loss like any other
+	m_udp->SendTo(packet, 0, m_peer);
+}
+
+uint64_t RudpSocket::GetMaxData() const {
+	return m_rxNext - m_rxSize + m_rcvBufSize;
+}
+
+/**************************************************
+ *              Loss recovery and timers          *
+ **************************************************/
+
+void RudpSocket::UpdateRtt(Time latest, Time ackDelay) {
+	m_latestRtt = latest;
+	if(!m_rttSampled) {
+		m_rttSampled = true;
+		m_minRtt = latest;
+		m_srtt = latest;
+		m_rttvar = NanoSeconds(latest.GetNanoSeconds() / 2);
+		return;
+	}
+	m_minRtt = std::min(m_minRtt, latest);
+	Time adjusted = latest;
+	if(latest >= m_minRtt + ackDelay)
+		adjusted = latest - ackDelay;
+	Time diff = m_srtt > adjusted ? m_srtt - adjusted : adjusted - m_srtt;
+	m_rttvar = NanoSeconds((3 * m_rttvar.GetNanoSeconds() + diff.GetNanoSeconds()) / 4);
+	m_srtt = NanoSeconds((7 * m_srtt.GetNanoSeconds() + adjusted.GetNanoSeconds()) / 8);
+}
+
+void RudpSocket::DetectLosses() {
+	if(m_largestAcked < 0)
+		return;
+	Time lossDelay = std::max(MilliSeconds(1),
+			NanoSeconds(std::max(m_latestRtt, m_srtt).GetNanoSeconds() * 9 / 8));
+	Time now = Simulator::Now();
+	for(auto it = m_sent.begin(); it != m_sent.end() && (int64_t) it->first < m_largestAcked;) {
+		if(it->first + RUDP_PACKET_THRESHOLD > (uint64_t) m_largestAcked
+				&& it->second.m_sentTime + lossDelay > now) {
+			++it;
+			continue;
+		}
+		MarkLost(it->second);
+		it = m_sent.erase(it);
+	}
+}
+
+void RudpSocket::MarkLost(const RudpSentPacket &pkt) {
+	NS_LOG_LOGIC("lost offset " << pkt.m_offset << " len " << pkt.m_len);
+	m_bytesInFlight -= pkt.m_len;
+	if(pkt.m_len > 0 || pkt.m_fin)
+		m_lost.push_back(pkt);
+	m_cc->OnPacketLost(pkt.m_len, pkt.m_sentTime);
+}
+
+Time RudpSocket::GetPto() const {
+	int64_t pto = m_srtt.GetNanoSeconds() + std::max(4 * m_rttvar.GetNanoSeconds(), (int64_t) 1000000)
+			+ m_maxAckDelay.GetNanoSeconds();
+	return NanoSeconds(pto << std::min(m_ptoCount, (uint32_t) 16));
+}
+
+void RudpSocket::ArmPto() {
+	m_ptoEvent.Cancel();
+	bool blocked = m_state == RUDP_OPEN && m_nextOffset < m_txEnd && m_nextOffset >= m_peerMaxData;
+	if(m_state == RUDP_HELLO_SENT || (m_state == RUDP_OPEN && (!m_sent.empty() || blocked)))
+		m_ptoEvent = Simulator::Schedule(GetPto(), &RudpSocket::PtoExpired, this);
+}
+
+void RudpSocket::PtoExpired() {
+	NS_LOG_FUNCTION(this << m_connId << m_ptoCount);
+	Ptr<RudpSocket> self = this;
+	if(++m_ptoCount > m_maxRetries) {
+		NS_LOG_LOGIC("peer does not answer");
+		SendControl(RUDP_CLOSE);
+		Fail(ERROR_NOROUTETOHOST);
+		return;
+	}
+	if(m_state == RUDP_HELLO_SENT) {
+		SendControl(RUDP_HELLO);
+		ArmPto();
+		return;
+	}
+	if(!m_sent.empty()) {
+		m_cc->OnRetransmissionTimeout();
+		for(auto &it : m_sent)
+			MarkLost(it.second);
+		m_sent.clear();
+	}
+	SendPending();
+	if(m_sent.empty()) {
+		//blocked by flow control, the window update may be lost
+		RudpSentPacket probe;
+		probe.m_offset = m_nextOffset;
+		probe.m_len = 0;
+		probe.m_fin = false;
+		SendData(probe);
+	}
+	ArmPto();
+}
+
+/**************************************************
+ *                   Closing down                 *
+ **************************************************/
+
+void RudpSocket::CheckDone() {
+	if(m_state != RUDP_OPEN || !m_finAcked || !m_finDelivered)
+		return;
+	NS_LOG_LOGIC("connection " << m_connId << " done, draining");
+	m_state = RUDP_DRAINING;
+	m_ptoEvent.Cancel();
+	m_drainEvent = Simulator::Schedule(NanoSeconds(GetPto().GetNanoSeconds() * RUDP_DRAIN_PTOS),
+			&RudpSocket::Release, this);
+}
+
+void RudpSocket::Abort() {
+	NS_LOG_FUNCTION(this << m_connId);
+	SendControl(RUDP_CLOSE);
+	m_errno = ERROR_SHUTDOWN;
+	Release();
+}
+
+void RudpSocket::Fail(enum SocketErrno err) {
+	NS_LOG_FUNCTION(this << m_connId);
+	Ptr<RudpSocket> self = this;
+	bool connecting = m_state == RUDP_HELLO_SENT;
+	m_errno = err;
+	Release();
+	if(connecting)
+		NotifyConnectionFailed();
+	else
+		NotifyErrorClose();
+}
+
+void RudpSocket::Release() {
+	NS_LOG_FUNCTION(this << m_connId);
+	Ptr<RudpSocket> self = this;
+	m_state = RUDP_CLOSED;
+	m_ackEvent.Cancel();
+	m_ptoEvent.Cancel();
+	m_drainEvent.Cancel();
+	m_sent.clear();
+	m_lost.clear();
+	m_rxOoo.clear();
+	m_bytesInFlight = 0;
+	if(m_listener != 0) {
+		m_listener->ChildDone(m_connId, NanoSeconds(GetPto().GetNanoSeconds() * RUDP_DRAIN_PTOS));
+		m_listener = 0;
+	} else if(m_udp != 0) {
+		m_udp->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+		m_udp->Close();
+	}
+	m_udp = 0;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,194 @@
+/*
+ * rudp-socket.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_H_
+#define SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_H_
+
+#include "rudp-header.h"
+#include "rudp-congestion-ops.h"
+#include "ns3/socket.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/address.h"
+#include "ns3/event-id.h"
+#include <deque>
+#include <map>
+
+namespace ns3 {
+
+struct RudpSentPacket {
+	uint64_t m_offset;
+	uint32_t m_len;
+	bool m_fin;
+	Time m_sentTime;
+};
+
+/*
+ * \brief Reliable byte stream over udp, modelled on QUIC with a single
+ *        stream per connection. It is a stream socket like a tcp one, so
+ *        HttpClientBasic and HttpServer use it through their SocketFactory
+ *        attribute.
+ *
+ *        - Connection setup: with ZeroRtt the client counts as connected
+ *          at once and its first DATA packets open the connection at the
+ *          server, otherwise a HELLO / HELLO_ACK exchange comes first.
+ *          Connections are told apart by their id, not the address.
+ *        - Loss recovery: every packet gets a fresh packet number, ACKs
+ *          list received numbers as ranges (selective acks). A packet is
+ *          lost once three later ones are acked or it is 9/8 rtt older
+ *          than the newest acked one; its bytes are sent again in a new
+ *          packet. Without acks the probe timeout (srtt + 4 rttvar + ack
+ *          delay, doubled each time) declares everything in flight lost.
+ *        - Congestion control is a RudpCongestionOps object,
+ *          CongestionControl selects its type.
+ *        - Flow control: each ACK carries the highest stream offset the
+ *          receiver can buffer.
+ *
+ *        A listening socket owns the udp socket and demultiplexes it to
+ *        one child socket per connection, which it hands out through the
+ *        accept callback. Close() sends FIN after the queued bytes; a
+ *        connection whose FINs are both acked lingers for three probe
+ *        timeouts to answer retransmissions. Closing with unread data, or
+ *        receiving data after Close(), aborts the connection.
+ */
+class RudpSocket: public Socket {
+public:
+	static TypeId GetTypeId(void);
+	RudpSocket();
+	virtual ~RudpSocket();
+
+	void SetNode(Ptr<Node> node);
+	Time GetSmoothedRtt() const;
+	uint32_t GetCongestionWindow() const;
+
+	virtual enum SocketErrno GetErrno(void) const;
+	virtual enum SocketType GetSocketType(void) const;
+	virtual Ptr<Node> GetNode(void) const;
+	virtual int Bind(const Address &address);
+	virtual int Bind();
+	virtual int Bind6();
+	virtual int Close(void);
+	virtual int ShutdownSend(void);
+	virtual int ShutdownRecv(void);
+	virtual int Connect(const Address &address);
+	virtual int Listen(void);
+	virtual uint32_t GetTxAvailable(void) const;
+	virtual int Send(Ptr<Packet> p, uint32_t flags);
+	virtual int SendTo(Ptr<Packet> p, uint32_t flags, const Address &toAddress);
+	virtual uint32_t GetRxAvailable(void) const;
+	virtual Ptr<Packet> Recv(uint32_t maxSize, uint32_t flags);
+	virtual Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address &fromAddress);
+	virtual int GetSockName(Address &address) const;
+	virtual int GetPeerName(Address &address) const;
+	virtual bool SetAllowBroadcast(bool allowBroadcast);
+	virtual bool GetAllowBroadcast() const;
+
+protected:
+	virtual void DoDispose(void);
+
+private:
+	enum RudpState {
+		RUDP_IDLE, RUDP_LISTEN, RUDP_HELLO_SENT, RUDP_OPEN, RUDP_DRAINING, RUDP_CLOSED
+	};
+
+	void OpenUdp();
+	void InitConnection();
+	void ListenerRecv(Ptr<Socket> udp);
+	void ClientRecv(Ptr<Socket> udp);
+	void ChildDone(uint32_t connId, Time drain);
+	static void SendClose(Ptr<Socket> udp, uint32_t connId, const Address &to);
+
+	void Process(const RudpHeader &header, Ptr<Packet> payload);
+	void ProcessData(const RudpHeader &header, Ptr<Packet> payload);
+	void ProcessAck(const RudpHeader &header);
+	void Connected();
+
+	void SendPending();
+	void SendData(RudpSentPacket pkt);
+	void SendControl(uint8_t type);
+	void SendAck();
+	void Output(Ptr<Packet> packet);
+	uint64_t GetMaxData() const;
+
+	void UpdateRtt(Time latest, Time ackDelay);
+	void DetectLosses();
+	void MarkLost(const RudpSentPacket &pkt);
+	void ArmPto();
+	Time GetPto() const;
+	void PtoExpired();
+
+	void CheckDone();
+	void Abort();
+	void Fail(enum SocketErrno err);
+	void Release();
+
+	Ptr<Node> m_node;
+	Ptr<Socket> m_udp; //!< the listener's for a child socket
+	Ptr<RudpSocket> m_listener; //!< set for a child socket
+	std::map<uint32_t, Ptr<RudpSocket> > m_children;
+	std::map<uint32_t, Time> m_closedIds; //!< connections the listener answers with CLOSE, till when
+	Address m_peer;
+	uint32_t m_connId;
+	enum RudpState m_state;
+	enum SocketErrno m_errno;
+	Ptr<RudpCongestionOps> m_cc;
+
+	//sending
+	Ptr<Packet> m_txData; //!< bytes from m_txBase, not acked yet
+	uint64_t m_txBase;
+	uint64_t m_txEnd; //!< after the last byte queued by Send()
+	uint64_t m_nextOffset; //!< first byte never sent
+	uint64_t m_peerMaxData;
+	uint64_t m_nextPn;
+	int64_t m_largestAcked;
+	std::map<uint64_t, RudpSentPacket> m_sent; //!< packet number -> in flight
+	std::deque<RudpSentPacket> m_lost; //!< ranges to send again
+	RudpRangeSet m_ackedOffsets;
+	uint32_t m_bytesInFlight;
+	bool m_sendClosed;
+	bool m_finSent;
+	bool m_finAcked;
+	bool m_closeCalled;
+
+	//receiving
+	std::map<uint64_t, Ptr<Packet> > m_rxOoo; //!< out of order, by stream offset
+	std::deque<Ptr<Packet> > m_rxQueue;
+	uint32_t m_rxSize;
+	uint64_t m_rxNext; //!< first stream byte not received in order
+	uint64_t m_finOffset;
+	bool m_finReceived;
+	bool m_finDelivered;
+	RudpRangeSet m_recvPns;
+	uint64_t m_largestRecv;
+	Time m_largestRecvAt;
+	uint32_t m_ackPending;
+	uint64_t m_advertised; //!< max data of the last ACK
+	EventId m_ackEvent;
+
+	//rtt and timers
+	bool m_rttSampled;
+	Time m_latestRtt;
+	Time m_srtt;
+	Time m_rttvar;
+	Time m_minRtt;
+	uint32_t m_ptoCount;
+	EventId m_ptoEvent;
+	EventId m_drainEvent;
+
+	uint32_t m_mss;
+	uint32_t m_sndBufSize;
+	uint32_t m_rcvBufSize;
+	bool m_zeroRtt;
+	TypeId m_ccTypeId;
+	Time m_initialRtt;
+	Time m_maxAckDelay;
+	uint32_t m_maxRetries;
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_TRANSPORT_RUDP_SOCKET_H_ */
@@ -0,0 +1,181 @@
+/*
+ * video-catalog.cc
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#include "video-catalog.h"
+#include "video-manifest.h"
+#include "ns3/log.h"
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("VideoCatalog");
+
+const VideoData *VideoCatalog::Get(const std::string &path) {
+	static std::unordered_map<std::string, std::unique_ptr<VideoData> > videos;
+	auto it = videos.find(path);
+	if (it != videos.end())
+		return it->second.get();
+
+	VideoData *videoData = Load(path);
+	if (!videoData) {
+		//not remembered, the path may come from a client
+		NS_LOG_WARN("Can't read video file " << path);
+		return NULL;
+	}
+	videos[path].reset(videoData);
+	return videoData;
+}
+
+VideoData *VideoCatalog::Load(const std::string &path) {
+	NS_LOG_FUNCTION(path);
+	uint32_t magic = 0;
+	std::ifstream probe(path, std::ios::binary);
+	if (!probe) {
+		return NULL;
+	}
+	probe.read((char *) &magic, sizeof(magic));
+	if (probe && magic == VIDEO_MANIFEST_MAGIC) {
+		return LoadManifest(path);
+	}
+	return LoadText(path);
+}
+
+/*
+ * vid.txt: segment duration in us, the average bitrates of all qualities
+ * and then one line of segment sizes (bytes) per quality.
+ */
+VideoData *VideoCatalog::LoadText(const std::string &path) {
+	NS_LOG_FUNCTION(path);
+	std::ifstream myfile(path);
+	if (!myfile) {
+		return NULL;
+	}
+	std::unique_ptr<VideoData> videoData(new VideoData());
+	std::string temp;
+	if (!std::getline(myfile, temp) || !(std::istringstream(temp) >> videoData->m_segmentDuration)) {
+		return NULL;
+	}
+	//read bitrates
+	if (!std::getline(myfile, temp)) {
+		return NULL;
+	}
+	std::istringstream buffer(temp);
+	double bitrate;
+	while (buffer >> bitrate) {
+		videoData->m_averageBitrate.push_back(bitrate);
+	}
+	//read segment sizes
+	uint16_t numQualities = 0;
+	size_t numsegs = 0;
+	while (std::getline(myfile, temp)) {
+		if (temp.empty()) {
+			break;
+		}
+		std::istringstream buffer(temp);
+		size_t before = videoData->m_sizeStorage.size();
+		uint64_t size;
+		while (buffer >> size) {
+			if (size > 0xffffffff) {
+				NS_LOG_ERROR("Segment too large in " << path);
+				return NULL;
+			}
+			videoData->m_sizeStorage.push_back(size);
+		}
+		size_t count = videoData->m_sizeStorage.size() - before;
+		if (numsegs != 0 && numsegs != count) {
+			NS_LOG_ERROR("Different number of segments for different qualities in " << path);
+			return NULL;
+		}
+		numsegs = count;
+		numQualities++;
+	}
+	if (numQualities != videoData->GetNumQualities()) {
+		NS_LOG_ERROR("Number of bitrates and segment size lines differ in " << path);
+		return NULL;
+	}
+	if (numsegs > 0xffff) {
+		NS_LOG_ERROR("More than 65535 segments in " << path);
+		return NULL;
+	}
+	if (videoData->m_sizeStorage.empty()) {
+		return NULL;
+	}
+	videoData->m_numSegments = numsegs;
+	videoData->m_segmentSizes = videoData->m_sizeStorage.data();
+	NS_LOG_INFO("loaded " << path << " qualities=" << numQualities << " segments=" << numsegs);
+	return videoData.release();
+}
+
+VideoData *VideoCatalog::LoadManifest(const std::string &path) {
+	NS_LOG_FUNCTION(path);
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return NULL;
+	}
+	struct stat st;
+	if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(VideoManifestHeader)) {
+		close(fd);
+		return NULL;
+	}
+	//the mapping is never unmapped, VideoData points into it till exit
+	void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		return NULL;
+	}
+
+	const VideoManifestHeader *header = (const VideoManifestHeader *) addr;
+	const double *bitrates = (const double *) (header + 1);
+	const uint32_t *sizes = (const uint32_t *) (bitrates + header->m_numQualities);
+	size_t expected = (const uint8_t *) (sizes + (size_t) header->m_numQualities * header->m_numSegments)
+			- (const uint8_t *) addr;
+	if (header->m_version != VIDEO_MANIFEST_VERSION || header->m_numSegments > 0xffff
+			|| header->m_numQualities == 0 || header->m_numSegments == 0
+			|| expected != (size_t) st.st_size) {
+		NS_LOG_ERROR("Corrupt video manifest " << path);
+		munmap(addr, st.st_size);
+		return NULL;
+	}
+
+	VideoData *videoData = new VideoData();
+	videoData->m_numSegments = header->m_numSegments;
+	videoData->m_segmentDuration = header->m_segmentDuration;
+	videoData->m_averageBitrate.assign(bitrates, bitrates + header->m_numQualities);
+	videoData->m_segmentSizes = sizes;
+	NS_LOG_INFO("mapped " << path << " qualities=" << header->m_numQualities << " segments=" << header->m_numSegments);
+	return videoData;
+}
+
+bool VideoCatalog::WriteManifest(const VideoData *videoData, const std::string &path) {
+	NS_LOG_FUNCTION(path);
+	std::ofstream outFile(path, std::ofstream::binary | std::ofstream::trunc);
+	if (!outFile) {
+		return false;
+	}
+	VideoManifestHeader header;
+	header.m_magic = VIDEO_MANIFEST_MAGIC;
+	header.m_version = VIDEO_MANIFEST_VERSION;
+	header.m_numQualities = videoData->GetNumQualities();
+	header.m_numSegments = videoData->m_numSegments;
+	header.m_reserved = 0;
+	header.m_segmentDuration = videoData->m_segmentDuration;
+	outFile.write((const char *) &header, sizeof(header));
+	outFile.write((const char *) videoData->m_averageBitrate.data(),
+			sizeof(double) * header.m_numQualities);
+	outFile.write((const char *) videoData->m_segmentSizes,
+			sizeof(uint32_t) * header.m_numQualities * header.m_numSegments);
+	return (bool) outFile;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,40 @@
+/*
+ * video-catalog.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_VIDEO_VIDEO_CATALOG_H_
+#define SRC_SPDASH_MODEL_VIDEO_VIDEO_CATALOG_H_
+
+#include "video-data.h"
+#include <string>
+
+namespace ns3 {
+
+/*
+ * \brief Process wide registry of videos keyed by file path. A video file
+ *        is loaded the first time anyone asks for it, afterwards every
+ *        player and request handler gets the same read only VideoData.
+ *        The returned pointer stays valid till the process exits, it is
+ *        NULL if the file can't be read or is malformed.
+ *
+ *        Both the vid.txt text format and the binary manifest described in
+ *        video-manifest.h are understood. A manifest is mmaped, so its
+ *        segment size table is neither parsed nor copied and its pages are
+ *        shared by every simulation process using the same file.
+ */
+class VideoCatalog {
+public:
+	static const VideoData *Get(const std::string &path);
+	static bool WriteManifest(const VideoData *videoData, const std::string &path);
+private:
+	static VideoData *Load(const std::string &path);
+	static VideoData *LoadText(const std::string &path);
+	static VideoData *LoadManifest(const std::string &path);
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_VIDEO_VIDEO_CATALOG_H_ */
@@ -0,0 +1,42 @@
+/*
+ * video-data.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_VIDEO_VIDEO_DATA_H_
+#define SRC_SPDASH_MODEL_VIDEO_VIDEO_DATA_H_
+
+#include <ns3/core-module.h>
+#include <vector>
+
+namespace ns3 {
+
+/*
+ * Segment information of a video as read from vid.txt or a binary
+ * manifest. Shared between the dash and spdash players, request handlers
+ * and abr algorithms. Instances are owned by the VideoCatalog and are
+ * never modified after loading.
+ */
+struct VideoData{
+	VideoData(): m_numSegments(0), m_segmentDuration(0), m_segmentSizes(NULL) {}
+	//m_segmentSizes may point into m_sizeStorage, a copy would share it
+	VideoData(const VideoData &) = delete;
+	VideoData &operator=(const VideoData &) = delete;
+	std::uint16_t m_numSegments;
+	uint64_t m_segmentDuration; //in us
+	std::vector<double> m_averageBitrate;
+	const uint32_t *m_segmentSizes; //quality major, [quality * m_numSegments + segment]
+	std::vector<uint32_t> m_sizeStorage; //backs m_segmentSizes unless it is mmaped
+
+	uint16_t GetNumQualities() const { return m_averageBitrate.size(); }
+	uint64_t GetSegmentSize(uint16_t quality, uint16_t segment) const {
+		NS_ASSERT(quality < GetNumQualities() && segment < m_numSegments);
+		return m_segmentSizes[(size_t) quality * m_numSegments + segment];
+	}
+};
+
+}
+
+#endif /* SRC_SPDASH_MODEL_VIDEO_VIDEO_DATA_H_ */
@@ -0,0 +1,41 @@
+/*
+ * video-manifest.h
+ *
+ *  Created on: 17-Oct-2026
+ *      Author: abhijit
+ */
+
+#ifndef SRC_SPDASH_MODEL_VIDEO_VIDEO_MANIFEST_H_
+#define SRC_SPDASH_MODEL_VIDEO_VIDEO_MANIFEST_H_
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/*
+ * Binary video manifest, meant to be mmaped as is. All fields are in host
+ * byte order (the magic tells if the file came from a machine with a
+ * different one).
+ *
+ *   VideoManifestHeader
+ *   double   bitrate[m_numQualities]                   (bps)
+ *   uint32_t size[m_numQualities * m_numSegments]      (bytes, quality major)
+ *
+ * The header is 24 bytes, so the bitrates and the size table stay aligned.
+ * Use the video-manifest-converter example to create one from vid.txt.
+ */
+#define VIDEO_MANIFEST_MAGIC 0x56445053 //"SPDV" on little endian machines
+#define VIDEO_MANIFEST_VERSION 1
+
+struct VideoManifestHeader {
+	uint32_t m_magic;
+	uint16_t m_version;
+	uint16_t m_numQualities;
+	uint32_t m_numSegments;
+	uint32_t m_reserved;
+	uint64_t m_segmentDuration; //in us
+};
+
+} /* namespace ns3 */
+
+#endif /* SRC_SPDASH_MODEL_VIDEO_VIDEO_MANIFEST_H_ */